@@ -0,0 +1,45 @@
+#version 430 core
+// lighting pass of the deferred path, shades every covered pixel of the G-buffer once
+// variant keywords: NUM_LIGHTS <n>, CLUSTERED_LIGHTS, SHADOWS
+out vec4 FragColor;
+
+// G-buffer attachments (see GBuffer::Resolve)
+layout (binding = 0) uniform sampler2D gAlbedo;
+layout (binding = 1) uniform sampler2D gSpecular;
+layout (binding = 2) uniform sampler2D gNormal;
+layout (binding = 3) uniform sampler2D gDepth;
+uniform mat4 inverseViewProjection;
+
+#include "include/light_block.glsl"
+#include "include/octahedral.glsl"
+#ifdef CLUSTERED_LIGHTS
+#include "include/clustered_lights.glsl"
+#endif
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    // nothing was drawn here, keep the clear color
+    if (depth >= 1.0)
+        discard;
+
+    // world position from the depth buffer
+    vec4 ndc = vec4(gl_FragCoord.xy / vec2(textureSize(gDepth, 0)) * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 world = inverseViewProjection * ndc;
+    vec3 fragPos = world.xyz / world.w;
+
+    vec4 albedo = texelFetch(gAlbedo, pixel, 0);
+    vec4 specular = texelFetch(gSpecular, pixel, 0);
+    vec3 norm = octahedralDecode(texelFetch(gNormal, pixel, 0).xy);
+    float shininess = specular.a * 255.0;
+    vec3 viewDir = normalize(viewPos.xyz - fragPos);
+
+    vec3 result = blockLighting(fragPos, norm, viewDir, albedo.rgb * albedo.a, albedo.rgb, specular.rgb, shininess);
+#ifdef CLUSTERED_LIGHTS
+    result += clusteredLighting(fragPos, depth, norm, viewDir, albedo.rgb, specular.rgb, shininess);
+#endif
+    FragColor = vec4(result, 1.0);
+    // forward passes drawn afterwards (the lamp) depth test against the scene
+    gl_FragDepth = depth;
+}
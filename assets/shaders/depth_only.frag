@@ -0,0 +1,13 @@
+#version 430 core
+// depth prepass: the fixed-function depth write is all that's needed, color writes are masked off
+// variant keyword: LOD_FADE
+#ifdef LOD_FADE
+#include "include/lod_fade.glsl"
+#endif
+
+void main()
+{
+#ifdef LOD_FADE
+    lodDither();
+#endif
+}
@@ -1,15 +1,15 @@
-# version 330 core
-
-out vec4 FragColor;
-
-in vec2 texCoord;
-
-uniform sampler2D texture1;
-uniform sampler2D texture2;
-
-
-void main()
-{
-	FragColor = mix(texture(texture1, texCoord), texture(texture2, texCoord), 0.5);
-	//  * vec4(vertColor, 1.0)
+# version 330 core
+
+out vec4 FragColor;
+
+in vec2 texCoord;
+
+uniform sampler2D texture1;
+uniform sampler2D texture2;
+
+
+void main()
+{
+	FragColor = mix(texture(texture1, texCoord), texture(texture2, texCoord), 0.5);
+	//  * vec4(vertColor, 1.0)
 }
\ No newline at end of file
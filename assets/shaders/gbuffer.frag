@@ -0,0 +1,33 @@
+#version 430 core
+// geometry pass of the deferred path, fills the G-buffer (see GBuffer) instead of shading
+// variant keywords: SPECULAR_MAP, BINDLESS, LOD_FADE
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+layout (location = 0) out vec4 gAlbedo;   // rgb = diffuse color, a = ambient tint relative to the diffuse one
+layout (location = 1) out vec4 gSpecular; // rgb = specular color, a = shininess / 255
+layout (location = 2) out vec2 gNormal;   // octahedral world-space normal
+
+in vec3 fragPos;  
+in vec3 normal;  
+in vec2 texCoords;
+
+#include "include/material_inputs.glsl"
+#include "include/octahedral.glsl"
+#ifdef LOD_FADE
+#include "include/lod_fade.glsl"
+#endif
+
+void main()
+{
+#ifdef LOD_FADE
+    lodDither();
+#endif
+    vec3 albedo, specularColor;
+    sampleMaterial(albedo, specularColor);
+
+    float ambientScale = dot(material.ambient.rgb, vec3(1.0)) / max(dot(material.diffuse.rgb, vec3(1.0)), 1e-4);
+    gAlbedo = vec4(material.diffuse.rgb * albedo, clamp(ambientScale, 0.0, 1.0));
+    gSpecular = vec4(specularColor, clamp(material.specular.w / 255.0, 0.0, 1.0));
+    gNormal = octahedralEncode(normalize(normal));
+}
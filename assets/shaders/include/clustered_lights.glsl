@@ -0,0 +1,50 @@
+#pragma once
+
+// Point lights binned into view frustum clusters (see LightGrid and
+// ClusteredLights), only the lights of the pixel's own cluster are visited.
+#include "phong.glsl"
+
+struct PointLight {
+    vec4 positionRadius; // w = range
+    vec4 color;
+};
+layout (std430, binding = 5) readonly buffer ClusterLights {
+    PointLight pointLights[];
+};
+layout (std430, binding = 6) readonly buffer ClusterGrid {
+    uvec2 clusters[]; // offset and count in lightIndices
+};
+layout (std430, binding = 7) readonly buffer ClusterIndices {
+    uint lightIndices[];
+};
+layout (std140, binding = 2) uniform ClusterBlock {
+    vec4  clusterScale; // xy = clusters per pixel
+    vec4  clusterDepth; // x = near, y = far, z = slice scale, w = slice bias
+    uvec4 clusterCount;
+};
+
+// diffuse and specular light of the point lights reaching the pixel, windowDepth is its depth buffer value
+vec3 clusteredLighting(vec3 fragPos, float windowDepth, vec3 norm, vec3 viewDir, vec3 diffuseColor, vec3 specularColor, float shininess)
+{
+    // linear view depth from the window depth, slices grow exponentially with it
+    float nearPlane = clusterDepth.x;
+    float farPlane = clusterDepth.y;
+    float viewDepth = 2.0 * nearPlane * farPlane / (farPlane + nearPlane - (windowDepth * 2.0 - 1.0) * (farPlane - nearPlane));
+    uvec3 cluster = uvec3(uvec2(gl_FragCoord.xy * clusterScale.xy), uint(max(log(viewDepth) * clusterDepth.z + clusterDepth.w, 0.0)));
+    cluster = min(cluster, clusterCount.xyz - 1u);
+    uvec2 list = clusters[(cluster.z * clusterCount.y + cluster.y) * clusterCount.x + cluster.x];
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < list.y; i++)
+    {
+        PointLight light = pointLights[lightIndices[list.x + i]];
+        vec3 toLight = light.positionRadius.xyz - fragPos;
+        float lightDistance = max(length(toLight), 1e-4);
+        // smooth falloff that reaches zero at the light's range
+        float falloff = clamp(1.0 - (lightDistance * lightDistance) / (light.positionRadius.w * light.positionRadius.w), 0.0, 1.0);
+        falloff *= falloff;
+        vec2 terms = phong(norm, toLight / lightDistance, viewDir, shininess);
+        result += light.color.rgb * falloff * (terms.x * diffuseColor + terms.y * specularColor);
+    }
+    return result;
+}
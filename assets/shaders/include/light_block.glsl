@@ -0,0 +1,59 @@
+#pragma once
+
+// The LightBlock uniform block (see LightBlock in laky_lightblock.h) and the
+// Phong sum over its first NUM_LIGHTS lights. A light whose position has
+// w = 0 is directional, xyz then points towards it.
+// variant keyword SHADOWS: the lights with shadow maps are shadowed (see shadows.glsl)
+#include "phong.glsl"
+
+#ifndef NUM_LIGHTS
+#define NUM_LIGHTS 1
+#endif
+// size of the light array in the LightBlock, must match MAX_LIGHTS in laky_lightblock.h
+#define MAX_LIGHTS 4
+#if NUM_LIGHTS > MAX_LIGHTS
+#error NUM_LIGHTS exceeds MAX_LIGHTS
+#endif
+
+struct Light {
+    vec4 position;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+};
+
+layout (std140, binding = 1) uniform LightBlock {
+    vec4 viewPos;
+    Light lights[MAX_LIGHTS];
+};
+
+#ifdef SHADOWS
+#include "shadows.glsl"
+#endif
+
+// ambient, diffuse and specular light of the block's lights, the colors are the surface's (material tint times maps)
+vec3 blockLighting(vec3 fragPos, vec3 norm, vec3 viewDir, vec3 ambientColor, vec3 diffuseColor, vec3 specularColor, float shininess)
+{
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < NUM_LIGHTS; i++)
+    {
+        vec3 lightDir = normalize(lights[i].position.w == 0.0 ? lights[i].position.xyz : lights[i].position.xyz - fragPos);
+        vec2 terms = phong(norm, lightDir, viewDir, shininess);
+
+        // ambient
+        vec3 ambient = lights[i].ambient.rgb * ambientColor;
+        // diffuse 
+        vec3 diffuse = lights[i].diffuse.rgb * terms.x * diffuseColor;
+        // specular
+        vec3 specular = lights[i].specular.rgb * terms.y * specularColor;
+
+#ifdef SHADOWS
+        float shadow = lightShadow(i, fragPos, norm);
+#else
+        float shadow = 1.0;
+#endif
+
+        result += ambient + shadow * (diffuse + specular);
+    }
+    return result;
+}
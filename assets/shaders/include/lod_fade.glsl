@@ -0,0 +1,19 @@
+#pragma once
+
+// Dithered cross-fade between two levels of detail (see LodSelector). For a
+// few frames after a switch both levels are drawn: the incoming one with a
+// fade of +t, the outgoing one with -t. They keep complementary halves of a
+// 4x4 ordered dither pattern, so every pixel is covered by exactly one of
+// them and no blending or sorting is needed. 0 means fully visible.
+flat in float lodFade;
+
+void lodDither()
+{
+    if (lodFade == 0.0)
+        return;
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    float threshold = (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+    if (lodFade > 0.0 ? threshold >= lodFade : threshold < -lodFade)
+        discard;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Material parameters and maps of the lit shaders, read from the material
+// table the way the BINDLESS variant keyword asks for. The including
+// shader declares the texCoords input (and enables bindless textures).
+
+struct MaterialData {
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular; // w = shininess
+    ivec4 maps;    // texture array layers: x = diffuse, y = specular (-1 = none)
+    uvec2 diffuseHandle;  // bindless texture handles (0 = none), only used by BINDLESS
+    uvec2 specularHandle;
+};
+
+// every material in one storage buffer, picked per instance (see MaterialTable)
+layout (std430, binding = 0) readonly buffer MaterialTable {
+    MaterialData materials[];
+};
+flat in uint materialIndex;
+#define material materials[materialIndex]
+
+#ifdef BINDLESS
+// the table holds resident texture handles, nothing has to be bound
+#else
+// all material maps of one size live in a texture array, the table says which layer to use
+layout (binding = 0) uniform sampler2DArray materialMaps;
+#endif
+
+// samples the diffuse map, and the specular map into the material's specular tint
+void sampleMaterial(out vec3 albedo, out vec3 specularColor)
+{
+#ifdef BINDLESS
+    uvec2 diffuseHandle = material.diffuseHandle;
+    albedo = diffuseHandle != uvec2(0) ? vec3(texture(sampler2D(diffuseHandle), texCoords)) : vec3(1.0);
+#ifdef SPECULAR_MAP
+    uvec2 specularHandle = material.specularHandle;
+    specularColor = material.specular.rgb * (specularHandle != uvec2(0) ? vec3(texture(sampler2D(specularHandle), texCoords)) : vec3(1.0));
+#else
+    specularColor = material.specular.rgb;
+#endif
+#else
+    ivec4 maps = material.maps;
+    albedo = maps.x >= 0 ? vec3(texture(materialMaps, vec3(texCoords, maps.x))) : vec3(1.0);
+#ifdef SPECULAR_MAP
+    specularColor = material.specular.rgb * (maps.y >= 0 ? vec3(texture(materialMaps, vec3(texCoords, maps.y))) : vec3(1.0));
+#else
+    specularColor = material.specular.rgb;
+#endif
+#endif
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Phong lighting terms shared by the lit shaders.
+// Returns the diffuse factor in x and the specular factor in y,
+// callers scale them with their own light and material colors.
+vec2 phong(vec3 norm, vec3 lightDir, vec3 viewDir, float shininess)
+{
+    // diffuse
+    float diff = max(dot(norm, lightDir), 0.0);
+
+    // specular
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+
+    return vec2(diff, spec);
+}
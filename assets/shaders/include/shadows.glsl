@@ -0,0 +1,67 @@
+#pragma once
+
+// The ShadowBlock uniform block (see ShadowParams in laky_shadowmaps.h) and
+// the shadow lookups of the two lights that have shadow maps: cascades for
+// the directional one, a cube map for the point one. Needs the LightBlock
+// (viewPos) declared first.
+#define MAX_CASCADES 4
+
+layout (std140, binding = 3) uniform ShadowBlock {
+    mat4  cascadeMatrices[MAX_CASCADES];
+    vec4  cascadeSplits;
+    vec4  cascadeTexels;
+    vec4  cameraForward;
+    vec4  cubeShadowPosition;
+    vec4  cubeShadowParams;
+    ivec4 shadowLights;
+};
+
+// texture units SHADOW_CASCADE_UNIT and SHADOW_CUBE_UNIT
+layout (binding = 8) uniform sampler2DArrayShadow cascadeShadowMap;
+layout (binding = 9) uniform samplerCubeShadow cubeShadowMap;
+
+// 1 = lit, 0 = in shadow, filtered 2x2 by the hardware comparison
+float cascadeShadow(vec3 fragPos, vec3 norm)
+{
+    // the nearest cascade whose slice reaches this far, nothing beyond the last one is shadowed
+    float depth = dot(fragPos - viewPos.xyz, cameraForward.xyz);
+    int cascade = 0;
+    while (cascade < shadowLights.z && depth > cascadeSplits[cascade])
+        cascade++;
+    if (cascade == shadowLights.z)
+        return 1.0;
+
+    // move the lookup a texel and a half out of the surface so it doesn't shadow itself
+    vec3 offsetPos = fragPos + norm * cascadeTexels[cascade] * 1.5;
+    vec4 lightClip = cascadeMatrices[cascade] * vec4(offsetPos, 1.0);
+    vec3 coords = lightClip.xyz / lightClip.w * 0.5 + 0.5;
+    if (coords.z > 1.0)
+        return 1.0;
+    return texture(cascadeShadowMap, vec4(coords.xy, float(cascade), coords.z));
+}
+
+float cubeShadow(vec3 fragPos, vec3 norm)
+{
+    // the texel size grows with the distance from the light
+    float nearPlane = cubeShadowParams.x, farPlane = cubeShadowPosition.w;
+    float lightDistance = length(fragPos - cubeShadowPosition.xyz);
+    vec3 toFragment = fragPos + norm * cubeShadowParams.y * lightDistance * 1.5 - cubeShadowPosition.xyz;
+
+    // the face is picked by the major axis, its depth is what that face's perspective projection wrote
+    vec3 axisDistance = abs(toFragment);
+    float major = max(axisDistance.x, max(axisDistance.y, axisDistance.z));
+    if (major >= farPlane)
+        return 1.0;
+    float ndcDepth = (farPlane + nearPlane) / (farPlane - nearPlane) - 2.0 * farPlane * nearPlane / ((farPlane - nearPlane) * major);
+    return texture(cubeShadowMap, vec4(toFragment, ndcDepth * 0.5 + 0.5));
+}
+
+// shadow factor of LightBlock light i
+float lightShadow(int i, vec3 fragPos, vec3 norm)
+{
+    if (i == shadowLights.x)
+        return cascadeShadow(fragPos, norm);
+    if (i == shadowLights.y)
+        return cubeShadow(fragPos, norm);
+    return 1.0;
+}
@@ -1,47 +1,37 @@
-
-
-#version 330 core
-out vec4 FragColor;
-
-struct Material {
-    sampler2D diffuse;
-    sampler2D specular;
-    float shininess;
-}; 
-
-struct Light {
-    vec3 position;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-in vec3 fragPos;  
-in vec3 normal;  
-in vec2 texCoords;
-  
-uniform vec3 viewPos;
-uniform Material material;
-uniform Light light;
-
-void main()
-{
-    // ambient
-    vec3 ambient = light.ambient  * vec3(texture(material.diffuse, texCoords));
-  	
-    // diffuse 
-    vec3 norm = normalize(normal);
-    vec3 lightDir = normalize(light.position - fragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = light.diffuse  * diff * vec3(texture(material.diffuse, texCoords));
-    
-    // specular
-    vec3 viewDir = normalize(viewPos - fragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);  
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, texCoords));
-        
-    vec3 result = ambient + diffuse + specular;
-    FragColor = vec4(result, 1.0);
-} 
-
+#version 430 core
+// variant keywords: SPECULAR_MAP, NUM_LIGHTS <n>, BINDLESS, CLUSTERED_LIGHTS, SHADOWS, LOD_FADE
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+out vec4 FragColor;
+
+in vec3 fragPos;  
+in vec3 normal;  
+in vec2 texCoords;
+
+#include "include/material_inputs.glsl"
+#include "include/light_block.glsl"
+#ifdef CLUSTERED_LIGHTS
+#include "include/clustered_lights.glsl"
+#endif
+#ifdef LOD_FADE
+#include "include/lod_fade.glsl"
+#endif
+
+void main()
+{
+#ifdef LOD_FADE
+    lodDither();
+#endif
+    vec3 albedo, specularColor;
+    sampleMaterial(albedo, specularColor);
+
+    vec3 norm = normalize(normal);
+    vec3 viewDir = normalize(viewPos.xyz - fragPos);
+
+    vec3 result = blockLighting(fragPos, norm, viewDir, material.ambient.rgb * albedo, material.diffuse.rgb * albedo, specularColor, material.specular.w);
+#ifdef CLUSTERED_LIGHTS
+    result += clusteredLighting(fragPos, gl_FragCoord.z, norm, viewDir, material.diffuse.rgb * albedo, specularColor, material.specular.w);
+#endif
+    FragColor = vec4(result, 1.0);
+} 
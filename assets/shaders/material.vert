@@ -1,21 +1,82 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoords;
-
-out vec3 fragPos;
-out vec3 normal;
-out vec2 texCoords;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    fragPos = vec3(model * vec4(aPos, 1.0));
-    normal = mat3(transpose(inverse(model))) * aNormal;  
-    texCoords = aTexCoords;
-    
-    gl_Position = projection * view * vec4(fragPos, 1.0);
-}
\ No newline at end of file
+#version 430 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+// variant keyword INSTANCING: the model matrix comes from a per-instance attribute (locations 3-6)
+// variant keyword GPU_CULLING (with INSTANCING): the instance is looked up through the visible list written by cull.comp (location 8)
+#ifdef GPU_CULLING
+struct InstanceData {
+    mat4 model;
+    uint materialIndex;
+    uint drawIndex;
+    float lodFade;
+    uint padding;
+};
+// left bound by GpuCuller::Run (CULL_INSTANCES_BINDING)
+layout (std430, binding = 1) readonly buffer Instances {
+    InstanceData instances[];
+};
+layout (location = 8) in uint aInstanceIndex;
+#elif defined(INSTANCING)
+layout (location = 3) in mat4 aInstanceModel;
+#else
+uniform mat4 model;
+#endif
+
+// the material table index comes from a per-instance attribute (location 7), or a uniform without instancing
+// variant keyword DEPTH_ONLY: only gl_Position is written, for the depth prepass and the overdraw view
+#ifndef DEPTH_ONLY
+#ifdef GPU_CULLING
+// read from the instance buffer in main()
+#elif defined(INSTANCING)
+layout (location = 7) in uint aMaterialIndex;
+#else
+uniform uint aMaterialIndex;
+#endif
+flat out uint materialIndex;
+#endif
+
+// variant keyword LOD_FADE (with GPU_CULLING): hands the instance's level of detail cross-fade to the fragment shader (see include/lod_fade.glsl)
+#ifdef LOD_FADE
+flat out float lodFade;
+#endif
+
+#ifndef DEPTH_ONLY
+out vec3 fragPos;
+out vec3 normal;
+out vec2 texCoords;
+#endif
+// the depth prepass and the GL_EQUAL color pass are different programs, they must come up with bit-identical depths
+invariant gl_Position;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+#ifdef GPU_CULLING
+    mat4 model = instances[aInstanceIndex].model;
+#elif defined(INSTANCING)
+    mat4 model = aInstanceModel;
+#endif
+#ifdef DEPTH_ONLY
+    vec3 fragPos = vec3(model * vec4(aPos, 1.0));
+#else
+    fragPos = vec3(model * vec4(aPos, 1.0));
+    normal = mat3(transpose(inverse(model))) * aNormal;  
+    texCoords = aTexCoords;
+#endif
+#ifndef DEPTH_ONLY
+#ifdef GPU_CULLING
+    materialIndex = instances[aInstanceIndex].materialIndex;
+#else
+    materialIndex = aMaterialIndex;
+#endif
+#endif
+#ifdef LOD_FADE
+    lodFade = instances[aInstanceIndex].lodFade;
+#endif
+    
+    gl_Position = projection * view * vec4(fragPos, 1.0);
+}
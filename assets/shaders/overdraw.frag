@@ -0,0 +1,16 @@
+#version 430 core
+// overdraw view: drawn with additive blending, so a pixel gets brighter with every fragment shaded there
+// variant keyword: LOD_FADE
+out vec4 FragColor;
+
+#ifdef LOD_FADE
+#include "include/lod_fade.glsl"
+#endif
+
+void main()
+{
+#ifdef LOD_FADE
+    lodDither();
+#endif
+    FragColor = vec4(0.1, 0.05, 0.02, 1.0);
+}
@@ -0,0 +1,1122 @@
+// LAKY'S BENCHMARKS v1.0.0
+// 2026.10.19.
+//==============================================================================
+// CPU-only benchmarks of the engine libraries, no window or GL context needed.
+// Build from the repository root, e.g.:
+//   g++ -O2 -std=c++17 -Isrc/libs bench/laky_bench.cpp src/libs/laky_jobs/laky_jobs.cpp
+//       src/libs/laky_occlusion/laky_occlusion.cpp src/libs/laky_bvh/laky_bvh.cpp
+//       src/libs/laky_octree/laky_octree.cpp src/libs/laky_lights/laky_lightgrid.cpp
+//       src/libs/laky_shadows/laky_shadowcache.cpp src/libs/laky_lod/laky_lod.cpp
+//       src/libs/laky_mesh/laky_meshloader.cpp src/libs/laky_mesh/laky_mappedfile.cpp
+//       src/libs/laky_mesh/laky_cookedmesh.cpp src/libs/laky_mesh/laky_meshlets.cpp
+//       src/libs/laky_memory/laky_framearena.cpp src/libs/laky_memory/laky_heapstats.cpp -lpthread -o laky_bench
+// Usage: laky_bench <benchmark> [options], run without arguments for the list.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "laky_bvh/laky_bvh.h"
+#include "laky_jobs/laky_jobs.h"
+#include "laky_lights/laky_lightgrid.h"
+#include "laky_lod/laky_lod.h"
+#include "laky_memory/laky_framearena.h"
+#include "laky_memory/laky_heapstats.h"
+#include "laky_mesh/laky_cookedmesh.h"
+#include "laky_mesh/laky_meshloader.h"
+#include "laky_mesh/laky_meshlets.h"
+#include "laky_octree/laky_octree.h"
+#include "laky_occlusion/laky_occlusion.h"
+#include "laky_shadows/laky_shadowcache.h"
+
+// milliseconds since `start`
+static double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// unit box centered on the origin, 8 corners and 12 triangles
+static void unitBox(std::vector<glm::vec3> &positions, std::vector<unsigned int> &indices)
+{
+    positions.clear();
+    for (int corner = 0; corner < 8; corner++)
+        positions.push_back(glm::vec3((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f));
+    const unsigned int faces[36] = {
+        0, 2, 1, 1, 2, 3,   4, 5, 6, 5, 7, 6,   // -z, +z
+        0, 1, 4, 1, 5, 4,   2, 6, 3, 3, 6, 7,   // -y, +y
+        0, 4, 2, 2, 4, 6,   1, 3, 5, 3, 7, 5    // -x, +x
+    };
+    indices.assign(faces, faces + 36);
+}
+
+
+// occlusion [objects] [occluders]: software rasterizer + Hi-Z test
+// A row of wall occluders hides part of a field of small boxes behind it.
+static int benchOcclusion(int argc, char **argv)
+{
+    unsigned int objectCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 100000;
+    unsigned int occluderCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 64;
+    const int frames = 50;
+
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    std::vector<glm::vec3> box;
+    std::vector<unsigned int> boxIndices;
+    unitBox(box, boxIndices);
+
+    // occluders: thin walls at z = -10 spread across the left two thirds of the view
+    std::vector<glm::mat4> occluders;
+    for (unsigned int i = 0; i < occluderCount; i++)
+    {
+        float x = -6.0f + 8.0f * ((i % 8) + 0.5f) / 8.0f;
+        float y = -4.0f + 8.0f * ((i / 8 % 8) + 0.5f) / 8.0f;
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, -10.0f));
+        occluders.push_back(glm::scale(model, glm::vec3(1.01f, 1.01f, 0.2f)));
+    }
+
+    // objects: small boxes scattered between z = -5 and z = -60
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec3> centers(objectCount);
+    for (glm::vec3 &center : centers)
+    {
+        float z = -5.0f - 55.0f * unit(random);
+        float spread = -z * 0.4f;
+        center = glm::vec3((unit(random) * 2.0f - 1.0f) * spread * 1.33f, (unit(random) * 2.0f - 1.0f) * spread, z);
+    }
+    const glm::vec3 halfExtent(0.1f);
+
+    OcclusionCuller culler(256, 128);
+    double rasterMs = 0.0, hizMs = 0.0, setupMs = 0.0, testMs = 0.0;
+    unsigned int culled = 0, wrong = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        FrameArena::BeginFrame();
+        culler.BeginFrame(projection * view);
+        for (const glm::mat4 &model : occluders)
+            culler.AddOccluder(box.data(), box.size(), boxIndices.data(), boxIndices.size(), model);
+        culler.Rasterize();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<unsigned char> visible(objectCount);
+        JobSystem::ParallelFor(objectCount, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                visible[i] = culler.IsVisible(centers[i] - halfExtent, centers[i] + halfExtent);
+        });
+        testMs += millisecondsSince(start);
+
+        setupMs += culler.Stats().transformMs;
+        rasterMs += culler.Stats().rasterMs;
+        hizMs += culler.Stats().hizMs;
+        if (frame == 0)
+        {
+            for (unsigned int i = 0; i < objectCount; i++)
+            {
+                culled += !visible[i];
+                // nothing in front of the walls may ever be culled
+                wrong += !visible[i] && centers[i].z + halfExtent.z > -9.9f;
+            }
+        }
+    }
+
+    std::cout << "occlusion: " << objectCount << " objects, " << occluderCount << " occluders (" << culler.Stats().rasterTriangles << " triangles rasterized), "
+              << culler.Width() << "x" << culler.Height() << " depth, " << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::cout << "  setup  " << setupMs / frames << " ms" << std::endl;
+    std::cout << "  raster " << rasterMs / frames << " ms" << std::endl;
+    std::cout << "  hi-z   " << hizMs / frames << " ms" << std::endl;
+    std::cout << "  test   " << testMs / frames << " ms (" << objectCount / (testMs / frames) / 1000.0 << " M boxes/s)" << std::endl;
+    std::cout << "  culled " << culled << " of " << objectCount << ", " << wrong << " wrongly culled in front of the occluders" << std::endl;
+    return wrong == 0 ? 0 : 1;
+}
+
+// bvh [objects]: parallel SAH build, refit and frustum / ray / sphere query throughput
+// Objects are boxes of mixed sizes scattered over a wide, flat level, the way a scene's objects spread out.
+static int benchBvh(int argc, char **argv)
+{
+    unsigned int objectCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 1000000;
+    const int builds = 3, refits = 10;
+    const unsigned int frustumQueries = 200, rayQueries = 200000, sphereQueries = 20000, checks = 20;
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const float levelSize = 2000.0f;
+    std::vector<glm::vec3> centers(objectCount), halfExtents(objectCount), boundsMin(objectCount), boundsMax(objectCount);
+    for (unsigned int i = 0; i < objectCount; i++)
+    {
+        centers[i] = glm::vec3((unit(random) - 0.5f) * levelSize, unit(random) * 50.0f, (unit(random) - 0.5f) * levelSize);
+        halfExtents[i] = glm::vec3(0.1f + unit(random) * unit(random) * 4.0f);
+        boundsMin[i] = centers[i] - halfExtents[i];
+        boundsMax[i] = centers[i] + halfExtents[i];
+    }
+
+    Bvh bvh;
+    double buildMs = 0.0;
+    for (int build = 0; build < builds; build++)
+    {
+        FrameArena::BeginFrame();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bvh.Build(boundsMin.data(), boundsMax.data(), objectCount);
+        buildMs += millisecondsSince(start);
+    }
+    float builtCost = bvh.Cost();
+
+    // every object bobs a little, the topology from the build stays good enough for that
+    double refitMs = 0.0;
+    for (int refit = 0; refit < refits; refit++)
+    {
+        for (unsigned int i = 0; i < objectCount; i++)
+        {
+            glm::vec3 center = centers[i] + glm::vec3(0.0f, std::sin(refit * 0.5f + i) * 0.5f, 0.0f);
+            boundsMin[i] = center - halfExtents[i];
+            boundsMax[i] = center + halfExtents[i];
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bvh.Refit(boundsMin.data(), boundsMax.data());
+        refitMs += millisecondsSince(start);
+    }
+
+    // frustum queries from random cameras standing on the level
+    unsigned int mismatches = 0;
+    std::vector<uint32_t> result, expected;
+    std::vector<Frustum> frustums;
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 200.0f);
+    for (unsigned int i = 0; i < frustumQueries; i++)
+    {
+        glm::vec3 eye((unit(random) - 0.5f) * levelSize, 10.0f, (unit(random) - 0.5f) * levelSize);
+        float yaw = unit(random) * 6.2831f;
+        frustums.push_back(Frustum(projection * glm::lookAt(eye, eye + glm::vec3(std::cos(yaw), -0.1f, std::sin(yaw)), glm::vec3(0.0f, 1.0f, 0.0f))));
+    }
+    size_t frustumHits = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (const Frustum &frustum : frustums)
+    {
+        result.clear();
+        bvh.QueryFrustum(frustum, result);
+        frustumHits += result.size();
+    }
+    double frustumMs = millisecondsSince(start);
+    for (unsigned int i = 0; i < checks; i++)
+    {
+        result.clear();
+        expected.clear();
+        bvh.QueryFrustum(frustums[i], result);
+        for (unsigned int object = 0; object < objectCount; object++)
+        {
+            if (frustums[i].IntersectsAABB(boundsMin[object], boundsMax[object]))
+                expected.push_back(object);
+        }
+        std::sort(result.begin(), result.end());
+        mismatches += result != expected;
+    }
+
+    // picking rays, mostly horizontal so they travel through the level
+    std::vector<glm::vec3> origins(rayQueries), directions(rayQueries);
+    for (unsigned int i = 0; i < rayQueries; i++)
+    {
+        origins[i] = glm::vec3((unit(random) - 0.5f) * levelSize, unit(random) * 50.0f, (unit(random) - 0.5f) * levelSize);
+        directions[i] = glm::normalize(glm::vec3(unit(random) - 0.5f, (unit(random) - 0.5f) * 0.2f, unit(random) - 0.5f));
+    }
+    size_t rayHits = 0;
+    BvhHit hit;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < rayQueries; i++)
+        rayHits += bvh.Raycast(origins[i], directions[i], 1000.0f, hit);
+    double rayMs = millisecondsSince(start);
+    for (unsigned int i = 0; i < checks; i++)
+    {
+        // brute force closest hit, compared by distance since touching boxes may tie
+        float closest = 1000.0f;
+        bool expectedHit = false;
+        for (unsigned int object = 0; object < objectCount; object++)
+        {
+            glm::vec3 t0 = (boundsMin[object] - origins[i]) / directions[i];
+            glm::vec3 t1 = (boundsMax[object] - origins[i]) / directions[i];
+            glm::vec3 tNear = glm::min(t0, t1), tFar = glm::max(t0, t1);
+            float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+            float exit = std::min(std::min(tFar.x, tFar.y), tFar.z);
+            if (entry <= exit && entry <= closest)
+            {
+                closest = entry;
+                expectedHit = true;
+            }
+        }
+        bool found = bvh.Raycast(origins[i], directions[i], 1000.0f, hit);
+        mismatches += found != expectedHit || (found && std::abs(hit.distance - closest) > 1e-3f);
+    }
+
+    // light influence queries
+    size_t sphereHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < sphereQueries; i++)
+    {
+        result.clear();
+        bvh.QuerySphere(centers[i % objectCount], 15.0f, result);
+        sphereHits += result.size();
+    }
+    double sphereMs = millisecondsSince(start);
+
+    std::cout << "bvh: " << objectCount << " objects, " << bvh.NodeCount() << " nodes (" << bvh.NodeCount() * sizeof(BvhNode) / 1024 << " KiB), "
+              << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::cout << "  build   " << buildMs / builds << " ms, SAH cost " << builtCost << std::endl;
+    std::cout << "  refit   " << refitMs / refits << " ms, SAH cost afterwards " << bvh.Cost() << std::endl;
+    std::cout << "  frustum " << frustumQueries / (frustumMs / 1000.0) << " queries/s, " << frustumHits / frustumQueries << " objects each" << std::endl;
+    std::cout << "  ray     " << rayQueries / (rayMs / 1000.0) / 1e6 << " M rays/s, " << rayHits * 100 / rayQueries << "% hit" << std::endl;
+    std::cout << "  sphere  " << sphereQueries / (sphereMs / 1000.0) / 1e6 << " M queries/s, " << sphereHits / sphereQueries << " objects each" << std::endl;
+    std::cout << "  " << mismatches << " of " << 2 * checks << " checked queries differ from brute force" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// octree [objects] [frames]: loose octree with every object moving every frame
+// Objects fly around a 512 unit cube and bounce off its walls, then the frame's frustum and point light queries run.
+static int benchOctree(int argc, char **argv)
+{
+    unsigned int objectCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 100000;
+    int frames = argc > 1 ? atoi(argv[1]) : 100;
+    const unsigned int lightCount = 64;
+    const float worldHalfSize = 256.0f, lightRadius = 16.0f, frameTime = 1.0f / 60.0f;
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec3> positions(objectCount), velocities(objectCount);
+    std::vector<float> radii(objectCount);
+    for (unsigned int i = 0; i < objectCount; i++)
+    {
+        positions[i] = (glm::vec3(unit(random), unit(random), unit(random)) * 2.0f - 1.0f) * worldHalfSize;
+        velocities[i] = (glm::vec3(unit(random), unit(random), unit(random)) * 2.0f - 1.0f) * 10.0f;
+        radii[i] = 0.25f + unit(random) * unit(random) * 4.0f;
+    }
+
+    LooseOctree octree(glm::vec3(0.0f), worldHalfSize, 6);
+    std::vector<OctreeHandle> handles(objectCount);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < objectCount; i++)
+        handles[i] = octree.Insert(positions[i], radii[i], i);
+    double insertMs = millisecondsSince(start);
+    size_t poolAfterInsert = octree.PoolSize();
+    octree.ResetStats();
+
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 300.0f);
+    double updateMs = 0.0, rebuildMs = 0.0, frustumMs = 0.0, lightMs = 0.0;
+    size_t visible = 0, lit = 0;
+    std::vector<uint32_t> result;
+    Frustum frustum;
+    std::vector<glm::vec3> lights(lightCount);
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (unsigned int i = 0; i < objectCount; i++)
+        {
+            positions[i] += velocities[i] * frameTime;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (std::abs(positions[i][axis]) > worldHalfSize)
+                    velocities[i][axis] = -velocities[i][axis];
+            }
+        }
+
+        start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < objectCount; i++)
+            octree.Update(handles[i], positions[i], radii[i]);
+        updateMs += millisecondsSince(start);
+
+        // the camera circles the world looking inwards
+        float angle = frame * 0.05f;
+        glm::vec3 eye(std::cos(angle) * 200.0f, 50.0f, std::sin(angle) * 200.0f);
+        frustum = Frustum(projection * glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+        result.clear();
+        start = std::chrono::steady_clock::now();
+        octree.QueryFrustum(frustum, result);
+        frustumMs += millisecondsSince(start);
+        visible += result.size();
+
+        for (unsigned int light = 0; light < lightCount; light++)
+            lights[light] = positions[(light * 7919 + frame) % objectCount];
+        start = std::chrono::steady_clock::now();
+        for (unsigned int light = 0; light < lightCount; light++)
+        {
+            result.clear();
+            octree.QuerySphere(lights[light], lightRadius, result);
+            lit += result.size();
+        }
+        lightMs += millisecondsSince(start);
+    }
+    OctreeStats stats = octree.Stats();
+
+    // what the same frame costs when the structure is rebuilt from scratch instead
+    LooseOctree rebuilt(glm::vec3(0.0f), worldHalfSize, 6);
+    for (int frame = 0; frame < 10; frame++)
+    {
+        start = std::chrono::steady_clock::now();
+        rebuilt.Clear();
+        for (unsigned int i = 0; i < objectCount; i++)
+            rebuilt.Insert(positions[i], radii[i], i);
+        rebuildMs += millisecondsSince(start);
+    }
+
+    // the last frame's queries against brute force
+    unsigned int mismatches = 0;
+    std::vector<uint32_t> expected;
+    result.clear();
+    octree.QueryFrustum(frustum, result);
+    for (unsigned int i = 0; i < objectCount; i++)
+    {
+        if (frustum.IntersectsSphere(positions[i], radii[i]))
+            expected.push_back(i);
+    }
+    std::sort(result.begin(), result.end());
+    mismatches += result != expected;
+    for (unsigned int light = 0; light < 4; light++)
+    {
+        result.clear();
+        expected.clear();
+        octree.QuerySphere(lights[light], lightRadius, result);
+        for (unsigned int i = 0; i < objectCount; i++)
+        {
+            float reach = radii[i] + lightRadius;
+            if (glm::dot(positions[i] - lights[light], positions[i] - lights[light]) <= reach * reach)
+                expected.push_back(i);
+        }
+        std::sort(result.begin(), result.end());
+        mismatches += result != expected;
+    }
+
+    std::cout << "octree: " << objectCount << " moving objects, " << frames << " frames, " << octree.NodeCount() << " nodes in use, pool of "
+              << octree.PoolSize() << " (" << poolAfterInsert << " after the initial inserts)" << std::endl;
+    std::cout << "  insert  " << insertMs << " ms for all objects" << std::endl;
+    std::cout << "  update  " << updateMs / frames << " ms per frame (" << updateMs * 1e6 / frames / objectCount << " ns per object), "
+              << stats.relocations / frames << " relocations per frame" << std::endl;
+    std::cout << "  rebuild " << rebuildMs / 10 << " ms per frame when cleared and refilled instead" << std::endl;
+    std::cout << "  nodes   " << stats.nodesCreated / frames << " taken from and " << stats.nodesFreed / frames << " returned to the pool per frame" << std::endl;
+    std::cout << "  frustum " << frustumMs / frames << " ms, " << visible / frames << " objects visible" << std::endl;
+    std::cout << "  lights  " << lightMs / frames / lightCount * 1000.0 << " us per point light, " << lit / frames / lightCount << " objects in range" << std::endl;
+    std::cout << "  " << mismatches << " of 5 checked queries differ from brute force" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+
+// clusters [lights] [frames]: binning point lights into view frustum clusters
+// The lights wander through a large box while the camera turns on the spot.
+static int benchClusters(int argc, char **argv)
+{
+    unsigned int lightCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 4096;
+    int frames = argc > 1 ? atoi(argv[1]) : 100;
+    const float worldHalfSize = 50.0f;
+    const float lightRadius = 2.0f;
+    const float fovY = glm::radians(45.0f), aspect = 800.0f / 600.0f, near = 0.1f, far = 100.0f;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<PointLight> lights(lightCount);
+    std::vector<glm::vec3> velocities(lightCount);
+    for (unsigned int i = 0; i < lightCount; i++)
+    {
+        lights[i].positionRadius = glm::vec4(unit(rng) * worldHalfSize, unit(rng) * 10.0f, unit(rng) * worldHalfSize, lightRadius);
+        lights[i].color = glm::vec4(1.0f);
+        velocities[i] = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.5f;
+    }
+
+    LightGrid grid;
+    glm::mat4 view(1.0f);
+    double buildMs = 0.0;
+    size_t visible = 0, references = 0, maxCluster = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        for (unsigned int i = 0; i < lightCount; i++)
+            lights[i].positionRadius += glm::vec4(velocities[i], 0.0f);
+        float angle = frame * 0.05f;
+        view = glm::lookAt(glm::vec3(0.0f), glm::vec3(std::cos(angle), 0.0f, std::sin(angle)), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        FrameArena::BeginFrame();
+        auto start = std::chrono::steady_clock::now();
+        grid.Build(lights.data(), lightCount, view, fovY, aspect, near, far);
+        buildMs += millisecondsSince(start);
+        visible += grid.Stats().visibleLights;
+        references += grid.Stats().indexCount;
+        maxCluster = std::max(maxCluster, grid.Stats().maxClusterLights);
+    }
+
+    // every point inside a light's range has to find the light in the list of the cluster it falls into
+    unsigned int samples = 0, misses = 0;
+    const std::vector<LightCluster> &clusters = grid.Clusters();
+    const std::vector<uint32_t> &indices = grid.Indices();
+    for (unsigned int i = 0; i < lightCount; i++)
+    {
+        for (int sample = 0; sample < 16; sample++)
+        {
+            glm::vec3 offset(unit(rng), unit(rng), unit(rng));
+            if (glm::dot(offset, offset) > 0.98f)
+                continue;
+            glm::vec3 point = glm::vec3(view * glm::vec4(glm::vec3(lights[i].positionRadius) + offset * lightRadius, 1.0f));
+            int cluster = grid.ClusterOf(point);
+            if (cluster < 0)
+                continue;
+            samples++;
+            const uint32_t *first = indices.data() + clusters[cluster].offset;
+            const uint32_t *last = first + clusters[cluster].count;
+            if (!std::binary_search(first, last, i))
+                misses++;
+        }
+    }
+
+    std::cout << "clusters: " << lightCount << " moving lights, " << LightGrid::CLUSTERS_X << "x" << LightGrid::CLUSTERS_Y << "x" << LightGrid::CLUSTERS_Z
+              << " clusters, " << frames << " frames on " << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::cout << "  build   " << buildMs / frames << " ms per frame (" << buildMs * 1e6 / frames / lightCount << " ns per light)" << std::endl;
+    std::cout << "  lights  " << visible / frames << " in view, " << references / frames << " cluster entries per frame ("
+              << (double)references / frames / LightGrid::CLUSTER_COUNT << " per cluster on average, at most " << maxCluster << ")" << std::endl;
+    std::cout << "  " << misses << " of " << samples << " points inside a light's range miss it in their cluster" << std::endl;
+    return misses == 0 ? 0 : 1;
+}
+
+static int benchShadows(int argc, char **argv)
+{
+    unsigned int objectCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 1000;
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+    const float worldHalfSize = 50.0f;
+    const unsigned int cascadeCount = 4, resolution = 2048;
+    const float fovY = glm::radians(45.0f), aspect = 800.0f / 600.0f, near = 0.1f, shadowDistance = 40.0f;
+    const glm::vec3 sunDirection = glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f));
+    const glm::vec3 lampPosition(0.0f, 3.0f, 0.0f);
+
+    // boxes on the ground, every tenth one wandering around
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3> centers(objectCount), velocities(objectCount);
+    for (unsigned int i = 0; i < objectCount; i++)
+    {
+        centers[i] = glm::vec3(unit(rng) * worldHalfSize, 0.5f + (unit(rng) + 1.0f) * 2.0f, unit(rng) * worldHalfSize);
+        velocities[i] = i % 10 == 0 ? glm::vec3(unit(rng), 0.0f, unit(rng)) * 0.05f : glm::vec3(0.0f);
+    }
+
+    ShadowCascades cascades(cascadeCount, resolution, 20.0f);
+    ShadowCache cache(cascadeCount + 6);
+    glm::mat4 faceViews[6], faceProjection;
+    CubeShadowViews(lampPosition, 0.05f, 25.0f, faceViews, faceProjection);
+
+    double updateMs = 0.0;
+    unsigned long long drawn = 0, skipped = 0, refits = 0;
+    unsigned int uncovered = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        // a slow walk with some looking around: most frames move less than the cascades' slack
+        float angle = std::sin(frame * 0.01f) * 0.6f;
+        glm::vec3 position(frame * 0.03f - 9.0f, 1.7f, 0.0f);
+        glm::vec3 forward(std::cos(angle), -0.1f, std::sin(angle));
+        glm::mat4 view = glm::lookAt(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        auto start = std::chrono::steady_clock::now();
+        cache.BeginFrame();
+        unsigned int changed = cascades.Update(view, fovY, aspect, near, shadowDistance, sunDirection);
+        for (unsigned int i = 0; i < cascadeCount; i++)
+            cache.SetView(i, cascades.Cascade(i).view, cascades.Cascade(i).projection);
+        for (unsigned int face = 0; face < 6; face++)
+            cache.SetView(cascadeCount + face, faceViews[face], faceProjection);
+        for (unsigned int i = 0; i < objectCount; i++)
+        {
+            if (velocities[i] == glm::vec3(0.0f))
+                continue;
+            cache.Invalidate(centers[i] - 0.5f, centers[i] + 0.5f, false);
+            centers[i] += velocities[i];
+            cache.Invalidate(centers[i] - 0.5f, centers[i] + 0.5f, false);
+        }
+        for (unsigned int i = 0; i < cache.ViewCount(); i++)
+        {
+            if (cache.NeedsUpdate(i))
+                cache.MarkRendered(i);
+        }
+        updateMs += millisecondsSince(start);
+        drawn += cache.Stats().staticPasses + cache.Stats().dynamicPasses;
+        skipped += cache.Stats().skippedPasses;
+        for (unsigned int i = 0; i < cascadeCount; i++)
+            refits += (changed >> i) & 1;
+
+        // a kept cascade must still hold its whole slice of the view frustum
+        glm::mat4 cameraToWorld = glm::inverse(view);
+        float tanHalfY = std::tan(fovY * 0.5f), tanHalfX = tanHalfY * aspect;
+        float splitNear = near;
+        for (unsigned int i = 0; i < cascadeCount; i++)
+        {
+            const ShadowCascade &cascade = cascades.Cascade(i);
+            glm::mat4 lightClip = cascade.projection * cascade.view;
+            for (int corner = 0; corner < 8; corner++)
+            {
+                float depth = corner & 4 ? cascade.splitFar : splitNear;
+                glm::vec4 viewPoint((corner & 1 ? 1.0f : -1.0f) * tanHalfX * depth, (corner & 2 ? 1.0f : -1.0f) * tanHalfY * depth, -depth, 1.0f);
+                glm::vec4 clip = lightClip * (cameraToWorld * viewPoint);
+                if (std::fabs(clip.x) > 1.001f || std::fabs(clip.y) > 1.001f || std::fabs(clip.z) > 1.001f)
+                    uncovered++;
+            }
+            splitNear = cascade.splitFar;
+        }
+    }
+
+    unsigned int views = cache.ViewCount();
+    std::cout << "shadows: " << objectCount << " casters (" << (objectCount + 9) / 10 << " moving), " << cascadeCount << " cascades and a cube map, "
+              << frames << " frames" << std::endl;
+    std::cout << "  cache   " << updateMs * 1000.0 / frames << " us per frame for the bookkeeping" << std::endl;
+    std::cout << "  passes  " << (double)drawn / frames << " drawn, " << (double)skipped / frames << " of " << 2 * views << " skipped per frame (without the cache "
+              << 2 * views << " drawn)" << std::endl;
+    std::cout << "  refits  " << refits << " of " << (unsigned long long)frames * cascadeCount << " cascade updates" << std::endl;
+    std::cout << "  " << uncovered << " slice corners outside their cascade" << std::endl;
+    return uncovered == 0 ? 0 : 1;
+}
+
+
+// distance from p to triangle abc
+static float pointTriangleDistance(const glm::vec3 &p, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    glm::vec3 ab = b - a, ac = c - a, normal = glm::cross(ab, ac);
+    float area = glm::dot(normal, normal);
+    if (area > 0.0f)
+    {
+        // inside the prism over the triangle the plane distance is the answer
+        glm::vec3 ap = p - a;
+        float u = glm::dot(glm::cross(ap, ac), normal) / area, v = glm::dot(glm::cross(ab, ap), normal) / area;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f)
+            return std::fabs(glm::dot(ap, normal)) / std::sqrt(area);
+    }
+    // otherwise the nearest point is on an edge
+    const glm::vec3 *corners[3] = { &a, &b, &c };
+    float best = 1e30f;
+    for (int k = 0; k < 3; k++)
+    {
+        const glm::vec3 &from = *corners[k], &to = *corners[(k + 1) % 3];
+        glm::vec3 edge = to - from;
+        float length2 = glm::dot(edge, edge);
+        float t = length2 > 0.0f ? glm::clamp(glm::dot(p - from, edge) / length2, 0.0f, 1.0f) : 0.0f;
+        best = std::min(best, glm::length(p - (from + edge * t)));
+    }
+    return best;
+}
+
+// lod [meshes] [columns]: quadric simplification of bumpy spheres and level selection
+// Every mesh is a UV sphere with its own bumps and a duplicated seam column, like an artist-made rock.
+static int benchLod(int argc, char **argv)
+{
+    unsigned int meshCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 16;
+    unsigned int columns = argc > 1 ? (unsigned int)atoi(argv[1]) : 256;
+    unsigned int rows = columns / 2;
+    const unsigned int maxLevels = 5, samples = 400;
+    const float ratio = 0.25f;
+
+    std::vector<std::vector<glm::vec3>> positions(meshCount);
+    std::vector<std::vector<unsigned int>> indices(meshCount);
+    std::vector<LodSource> sources(meshCount);
+    for (unsigned int m = 0; m < meshCount; m++)
+    {
+        float frequency = 3.0f + m % 5;
+        for (unsigned int row = 0; row <= rows; row++)
+            for (unsigned int column = 0; column <= columns; column++)
+            {
+                float theta = (column == columns ? 0.0f : (float)column / columns) * 6.2831853f, phi = (float)row / rows * 3.1415927f;
+                glm::vec3 direction(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                if (row == 0 || row == rows)
+                    direction = glm::vec3(0.0f, row == 0 ? 1.0f : -1.0f, 0.0f);
+                float bumps = 0.05f * std::sin(frequency * direction.x + m) * std::sin(frequency * direction.y) * std::sin(frequency * direction.z + 1.0f);
+                positions[m].push_back(direction * (0.5f + bumps));
+            }
+        for (unsigned int row = 0; row < rows; row++)
+            for (unsigned int column = 0; column < columns; column++)
+            {
+                unsigned int a = row * (columns + 1) + column, b = a + 1, c = a + columns + 1, d = c + 1;
+                if (row > 0)
+                    indices[m].insert(indices[m].end(), { a, b, d });
+                if (row < rows - 1)
+                    indices[m].insert(indices[m].end(), { a, d, c });
+            }
+        sources[m].positions = &positions[m];
+        sources[m].indices = &indices[m];
+    }
+
+    std::vector<std::vector<MeshLod>> chains(meshCount);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int m = 0; m < meshCount; m++)
+        GenerateLods(&sources[m], 1, maxLevels, ratio, &chains[m]);
+    double serialMs = millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+    GenerateLods(sources.data(), meshCount, maxLevels, ratio, chains.data());
+    double parallelMs = millisecondsSince(start);
+
+    // how far the original vertices really are from each level's surface, sampled on the first mesh
+    std::cout << "lod: " << meshCount << " meshes of " << indices[0].size() / 3 << " triangles, " << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::cout << "  generate " << serialMs << " ms one mesh at a time, " << parallelMs << " ms in parallel" << std::endl;
+    bool valid = true;
+    const std::vector<glm::vec3> &mesh = positions[0];
+    for (size_t level = 0; level < chains[0].size(); level++)
+    {
+        const std::vector<unsigned int> &lod = chains[0][level].indices;
+        float measured = 0.0f;
+        for (unsigned int sample = 0; sample < samples; sample++)
+        {
+            const glm::vec3 &p = mesh[(size_t)sample * mesh.size() / samples];
+            float nearest = 1e30f;
+            for (size_t i = 0; i < lod.size(); i += 3)
+                nearest = std::min(nearest, pointTriangleDistance(p, mesh[lod[i]], mesh[lod[i + 1]], mesh[lod[i + 2]]));
+            measured = std::max(measured, nearest);
+        }
+        for (size_t i = 0; i < lod.size(); i += 3)
+        {
+            const glm::vec3 &a = mesh[lod[i]], &b = mesh[lod[i + 1]], &c = mesh[lod[i + 2]];
+            if (a == b || b == c || a == c)
+                valid = false;
+        }
+        // the error is what selection relies on, it must cover every vertex
+        if (measured > chains[0][level].error * 1.0001f + 1e-6f)
+            valid = false;
+        std::cout << "  level " << level << "  " << lod.size() / 3 << " triangles, error " << chains[0][level].error << ", farthest sampled vertex "
+                  << measured << " away" << std::endl;
+    }
+
+    // a camera walking away from a mesh and back, wobbling by 1% around every distance, must not flicker between levels
+    std::vector<float> errors;
+    for (const MeshLod &lod : chains[0])
+        errors.push_back(lod.error);
+    LodSelector selector(1.0f, 0.3f, 0);
+    unsigned int switches = 0, previous = 0, frames = 0;
+    for (int step = 0; step < 2000; step++)
+    {
+        float distance = 1.0f + 0.1f * (step < 1000 ? step : 2000 - step);
+        for (int wobble = 0; wobble < 4; wobble++, frames++)
+        {
+            selector.SetView(glm::vec3(0.0f, 0.0f, distance * (wobble % 2 ? 1.01f : 0.99f)), 45.0f, 600.0f);
+            unsigned int level = selector.Select(0, errors.data(), (unsigned int)errors.size(), glm::vec3(0.0f), 0.55f, 1.0f).level;
+            switches += level != previous;
+            previous = level;
+        }
+    }
+    std::cout << "  select  " << switches << " level switches in " << frames << " frames out to 100 units and back (at most " << 2 * (errors.size() - 1)
+              << " without flicker)" << std::endl;
+    return valid && switches <= 2 * (errors.size() - 1) ? 0 : 1;
+}
+
+
+// a wavy grid of columns x columns vertices as an OBJ text file and as a .glb with the same data (interleaved, so the
+// accessors have a stride); the .glb stores v flipped, so both load into the same vertices
+static bool writeGridMesh(const char *objPath, const char *glbPath, unsigned int columns)
+{
+    std::vector<float> vertices; // position, normal, texture coordinate
+    std::vector<unsigned int> indices;
+    for (unsigned int row = 0; row < columns; row++)
+        for (unsigned int column = 0; column < columns; column++)
+        {
+            float x = (float)column / (columns - 1), z = (float)row / (columns - 1);
+            float y = 0.05f * std::sin(x * 40.0f) * std::cos(z * 30.0f);
+            glm::vec3 normal = glm::normalize(glm::vec3(-2.0f * std::cos(x * 40.0f) * std::cos(z * 30.0f), 1.0f, 1.5f * std::sin(x * 40.0f) * std::sin(z * 30.0f)));
+            vertices.insert(vertices.end(), { x, y, z, normal.x, normal.y, normal.z, x, z });
+        }
+    for (unsigned int row = 0; row + 1 < columns; row++)
+        for (unsigned int column = 0; column + 1 < columns; column++)
+        {
+            unsigned int a = row * columns + column, b = a + 1, c = a + columns + 1, d = a + columns;
+            indices.insert(indices.end(), { a, d, c, a, c, b });
+        }
+
+    FILE *obj = fopen(objPath, "wb");
+    if (!obj)
+        return false;
+    size_t vertexCount = vertices.size() / 8;
+    for (size_t i = 0; i < vertexCount; i++)
+        fprintf(obj, "v %.6f %.6f %.6f\n", vertices[i * 8], vertices[i * 8 + 1], vertices[i * 8 + 2]);
+    for (size_t i = 0; i < vertexCount; i++)
+        fprintf(obj, "vt %.6f %.6f\n", vertices[i * 8 + 6], vertices[i * 8 + 7]);
+    for (size_t i = 0; i < vertexCount; i++)
+        fprintf(obj, "vn %.6f %.6f %.6f\n", vertices[i * 8 + 3], vertices[i * 8 + 4], vertices[i * 8 + 5]);
+    for (size_t i = 0; i < indices.size(); i += 6)
+    {
+        unsigned int a = indices[i] + 1, d = indices[i + 1] + 1, c = indices[i + 2] + 1, b = indices[i + 5] + 1;
+        fprintf(obj, "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, d, d, d, c, c, c, b, b, b);
+    }
+    fclose(obj);
+
+    // the .glb rounds through the same text precision, so the two loads can be compared closely
+    for (float &value : vertices)
+        value = (float)atof(std::to_string(value).c_str());
+    for (size_t i = 0; i < vertexCount; i++)
+        vertices[i * 8 + 7] = 1.0f - vertices[i * 8 + 7];
+    size_t vertexBytes = vertices.size() * sizeof(float), indexBytes = indices.size() * sizeof(unsigned int);
+    char json[1024];
+    int jsonLength = snprintf(json, sizeof(json),
+        "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%zu}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":%zu,\"byteStride\":32},{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+        "\"accessors\":[{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\"},"
+        "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\"},"
+        "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC2\"},"
+        "{\"bufferView\":1,\"componentType\":5125,\"count\":%zu,\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,\"mode\":4}]}]}",
+        vertexBytes + indexBytes, vertexBytes, vertexBytes, indexBytes, vertexCount, vertexCount, vertexCount, indices.size());
+    while (jsonLength % 4 != 0)
+        json[jsonLength++] = ' ';
+    unsigned int binLength = (unsigned int)(vertexBytes + indexBytes);
+    unsigned int header[5] = { 0x46546C67, 2, 12 + 8 + (unsigned int)jsonLength + 8 + binLength, (unsigned int)jsonLength, 0x4E4F534A };
+    unsigned int binHeader[2] = { binLength, 0x004E4942 };
+    FILE *glb = fopen(glbPath, "wb");
+    if (!glb)
+        return false;
+    fwrite(header, sizeof(header), 1, glb);
+    fwrite(json, 1, jsonLength, glb);
+    fwrite(binHeader, sizeof(binHeader), 1, glb);
+    fwrite(vertices.data(), 1, vertexBytes, glb);
+    fwrite(indices.data(), 1, indexBytes, glb);
+    fclose(glb);
+    return true;
+}
+
+// opens and writes a mesh out, reporting the throughput; the vertices and indices are left in `vertices` and `indices`
+static bool timeMeshLoad(const char *path, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices)
+{
+    MeshLoader loader;
+    if (!loader.Open(path))
+        return false;
+    vertices.resize(loader.VertexCount());
+    indices.resize(loader.IndexCount());
+    loader.Write(vertices.data(), indices.data());
+    const MeshLoadStats &stats = loader.Stats();
+    double megabytes = stats.fileBytes / (1024.0 * 1024.0);
+    std::cout << "  " << path << ": " << megabytes << " MB, " << vertices.size() << " vertices, " << indices.size() / 3 << " triangles in "
+              << stats.chunks << " pieces" << std::endl;
+    std::cout << "    parse " << stats.parseMs << " ms, write " << stats.writeMs << " ms, " << megabytes / ((stats.parseMs + stats.writeMs) / 1000.0)
+              << " MB/s" << std::endl;
+    return true;
+}
+
+static int benchMeshLoad(int argc, char **argv)
+{
+    std::vector<Vertex> objVertices, glbVertices;
+    std::vector<unsigned int> objIndices, glbIndices;
+    std::cout << "meshload: " << JobSystem::ThreadCount() << " threads" << std::endl;
+    // a model of your own instead of the generated ones
+    if (argc > 0 && !isdigit((unsigned char)argv[0][0]))
+        return timeMeshLoad(argv[0], objVertices, objIndices) ? 0 : 1;
+
+    // an OBJ line per attribute and face takes about 160 bytes per vertex
+    double megabytes = argc > 0 ? atof(argv[0]) : 64.0;
+    unsigned int columns = std::max(2u, (unsigned int)std::sqrt(megabytes * 1024.0 * 1024.0 / 160.0));
+    const char *objPath = "laky_bench_mesh.obj", *glbPath = "laky_bench_mesh.glb";
+    auto start = std::chrono::steady_clock::now();
+    if (!writeGridMesh(objPath, glbPath, columns))
+    {
+        std::cout << "meshload: can't write the test meshes into the current directory" << std::endl;
+        return 1;
+    }
+    std::cout << "  wrote a " << columns << "x" << columns << " grid in " << millisecondsSince(start) << " ms" << std::endl;
+
+    bool loaded = timeMeshLoad(objPath, objVertices, objIndices) && timeMeshLoad(glbPath, glbVertices, glbIndices);
+    remove(objPath);
+    remove(glbPath);
+    if (!loaded)
+        return 1;
+
+    // both formats must give the same triangles; the OBJ's corners merge back into one vertex per grid point (numbered in
+    // the order the faces first use them, so the corners are compared rather than the index lists)
+    bool same = objVertices.size() == (size_t)columns * columns && objVertices.size() == glbVertices.size() && objIndices.size() == glbIndices.size();
+    float difference = 0.0f;
+    for (size_t i = 0; same && i < objIndices.size(); i++)
+    {
+        const Vertex &a = objVertices[objIndices[i]], &b = glbVertices[glbIndices[i]];
+        difference = std::max(difference, glm::length(a.position - b.position));
+        difference = std::max(difference, glm::length(a.normal - b.normal));
+        difference = std::max(difference, glm::length(a.texCoords - b.texCoords));
+    }
+    std::cout << "  formats " << (same && difference < 1e-5f ? "agree" : "DIFFER") << ", largest attribute difference " << difference << std::endl;
+    return same && difference < 1e-5f ? 0 : 1;
+}
+
+
+static int benchCooked(int argc, char **argv)
+{
+    double megabytes = argc > 0 ? atof(argv[0]) : 64.0;
+    unsigned int columns = std::max(2u, (unsigned int)std::sqrt(megabytes * 1024.0 * 1024.0 / 160.0));
+    const char *objPath = "laky_bench_mesh.obj", *glbPath = "laky_bench_mesh.glb", *cookedPath = "laky_bench_mesh.lkm";
+    if (!writeGridMesh(objPath, glbPath, columns))
+    {
+        std::cout << "cooked: can't write the test meshes into the current directory" << std::endl;
+        return 1;
+    }
+    std::cout << "cooked: " << columns << "x" << columns << " grid, " << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::vector<Vertex> vertices, uploaded;
+    std::vector<unsigned int> indices, uploadedIndices;
+    bool cooked = timeMeshLoad(objPath, vertices, indices) && WriteCookedMesh(cookedPath, vertices.data(), vertices.size(), indices.data(), indices.size(), NULL, 0);
+    remove(objPath);
+    remove(glbPath);
+    if (!cooked)
+        return 1;
+
+    // mapping plus one copy of every section stands in for the glBufferSubData calls; the file was just written, so both
+    // runs read it from the page cache, like a model loaded on every start of the engine would be
+    uploaded.resize(vertices.size());
+    uploadedIndices.resize(indices.size());
+    bool same = true;
+    for (int run = 0; run < 2; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        CookedMesh mesh;
+        if (!mesh.Open(cookedPath))
+        {
+            remove(cookedPath);
+            return 1;
+        }
+        double openMs = millisecondsSince(start);
+        memcpy(uploaded.data(), mesh.Vertices(), mesh.VertexCount() * sizeof(Vertex));
+        memcpy(uploadedIndices.data(), mesh.Indices(), mesh.IndexCount() * sizeof(unsigned int));
+        double totalMs = millisecondsSince(start);
+        double fileMegabytes = mesh.FileSize() / (1024.0 * 1024.0);
+        std::cout << "  " << cookedPath << " run " << run + 1 << ": " << fileMegabytes << " MB, open " << openMs << " ms, open and copy " << totalMs << " ms, "
+                  << fileMegabytes / (totalMs / 1000.0) << " MB/s" << std::endl;
+        same = same && mesh.VertexCount() == vertices.size() && mesh.IndexCount() == indices.size() && uploadedIndices == indices
+               && memcmp(uploaded.data(), vertices.data(), vertices.size() * sizeof(Vertex)) == 0;
+    }
+    remove(cookedPath);
+    std::cout << "  cooked mesh " << (same ? "matches" : "DIFFERS FROM") << " the parsed one" << std::endl;
+    return same ? 0 : 1;
+}
+
+
+static int benchMeshlets(int argc, char **argv)
+{
+    unsigned int columns = argc > 0 ? (unsigned int)atoi(argv[0]) : 512;
+    unsigned int views = argc > 1 ? (unsigned int)atoi(argv[1]) : 200;
+    unsigned int rows = columns / 2;
+
+    // a bumpy torus: curved everywhere, so the cones have to be honest, and with holes to look through
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> indices;
+    for (unsigned int row = 0; row <= rows; row++)
+        for (unsigned int column = 0; column <= columns; column++)
+        {
+            float theta = (column == columns ? 0.0f : (float)column / columns) * 6.2831853f, phi = (row == rows ? 0.0f : (float)row / rows) * 6.2831853f;
+            float tube = 0.16f + 0.01f * std::sin(7.0f * theta) * std::sin(5.0f * phi);
+            float ring = 0.34f + tube * std::cos(phi);
+            positions.push_back(glm::vec3(ring * std::cos(theta), -tube * std::sin(phi), ring * std::sin(theta)));
+        }
+    for (unsigned int row = 0; row < rows; row++)
+        for (unsigned int column = 0; column < columns; column++)
+        {
+            unsigned int a = row * (columns + 1) + column, b = a + 1, c = a + columns + 1, d = c + 1;
+            indices.insert(indices.end(), { a, b, d, a, d, c });
+        }
+    size_t triangleCount = indices.size() / 3;
+
+    std::vector<unsigned int> reordered;
+    std::vector<Meshlet> meshlets;
+    auto start = std::chrono::steady_clock::now();
+    BuildMeshlets(positions, indices.data(), indices.size(), reordered, meshlets);
+    double buildMs = millisecondsSince(start);
+    size_t vertexSum = 0, conelessMeshlets = 0;
+    for (const Meshlet &meshlet : meshlets)
+    {
+        vertexSum += meshlet.vertexCount;
+        conelessMeshlets += meshlet.cone.w >= 1.0f;
+    }
+    std::cout << "meshlets: " << triangleCount << " triangles into " << meshlets.size() << " meshlets in " << buildMs << " ms, "
+              << (double)triangleCount / meshlets.size() << " triangles and " << (double)vertexSum / meshlets.size() << " vertices per meshlet on average, "
+              << conelessMeshlets << " without a usable cone" << std::endl;
+
+    // cameras around the torus looking past its center, so part of it is off screen; a meshlet rejected as back-facing
+    // must not have a single triangle facing the camera
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+    size_t frustumCulled = 0, backCulled = 0, wrongCulls = 0;
+    double cullMs = 0.0;
+    for (unsigned int view = 0; view < views; view++)
+    {
+        glm::vec3 direction = glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + glm::vec3(0.0f, 0.0f, 0.01f));
+        glm::vec3 camera = direction * (1.0f + 1.5f * (unit(random) + 1.0f));
+        glm::vec3 target = 0.3f * glm::vec3(unit(random), unit(random), unit(random));
+        Frustum frustum(projection * glm::lookAt(camera, target, glm::vec3(0.0f, 1.0f, 0.0f)));
+        start = std::chrono::steady_clock::now();
+        for (const Meshlet &meshlet : meshlets)
+        {
+            if (!frustum.IntersectsSphere(glm::vec3(meshlet.sphere), meshlet.sphere.w))
+                frustumCulled += meshlet.triangleCount;
+            else if (MeshletBackFacing(meshlet.sphere, meshlet.cone, camera))
+                backCulled += meshlet.triangleCount;
+        }
+        cullMs += millisecondsSince(start);
+        for (const Meshlet &meshlet : meshlets)
+        {
+            if (!MeshletBackFacing(meshlet.sphere, meshlet.cone, camera))
+                continue;
+            for (unsigned int t = 0; t < meshlet.triangleCount; t++)
+            {
+                const unsigned int *corner = &reordered[meshlet.firstIndex + t * 3];
+                const glm::vec3 &a = positions[corner[0]], &b = positions[corner[1]], &c = positions[corner[2]];
+                if (glm::dot(glm::cross(b - a, c - a), a - camera) < 0.0f)
+                    wrongCulls++;
+            }
+        }
+    }
+    double total = (double)triangleCount * views;
+    std::cout << "  " << views << " views: " << 100.0 * frustumCulled / total << "% of the triangles in meshlets off screen, "
+              << 100.0 * backCulled / total << "% in back-facing ones, culling " << cullMs / views << " ms per view" << std::endl;
+    std::cout << "  " << wrongCulls << " front-facing triangles in meshlets culled as back-facing" << std::endl;
+    return wrongCulls == 0 && reordered.size() == indices.size() ? 0 : 1;
+}
+
+// frame [objects] [frames]: the CPU side of a frame in steady state, counting heap allocations
+static int benchFrame(int argc, char **argv)
+{
+    unsigned int objectCount = argc > 0 ? (unsigned int)atoi(argv[0]) : 20000;
+    int frames = argc > 1 ? atoi(argv[1]) : 200;
+    const int warmupFrames = 10;
+    const unsigned int lightCount = 1024, occluderCount = 64;
+    const float fieldSize = 200.0f, fovY = 45.0f, aspect = 800.0f / 600.0f, near = 0.1f, far = 150.0f;
+    const float lodErrors[4] = { 0.0f, 0.01f, 0.04f, 0.16f };
+
+    std::mt19937 random(77);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3> centers(objectCount), boundsMin(objectCount), boundsMax(objectCount);
+    for (glm::vec3 &center : centers)
+        center = glm::vec3(unit(random), 0.0f, unit(random)) * fieldSize * 0.5f;
+    std::vector<PointLight> lights(lightCount);
+    for (PointLight &light : lights)
+    {
+        light.positionRadius = glm::vec4(unit(random) * fieldSize * 0.5f, 1.0f + unit(random), unit(random) * fieldSize * 0.5f, 3.0f);
+        light.color = glm::vec4(1.0f);
+    }
+    std::vector<glm::vec3> box;
+    std::vector<unsigned int> boxIndices;
+    unitBox(box, boxIndices);
+
+    // the same systems main.cpp runs every frame, with their long-lived outputs kept across frames like it does
+    Bvh bvh;
+    LightGrid grid;
+    OcclusionCuller culler(256, 128);
+    LodSelector selector(1.0f, 0.3f, 16);
+    std::vector<uint32_t> visibleObjects;
+    struct DrawItem
+    {
+        uint32_t     object;
+        unsigned int level;
+    };
+
+    double frameMs = 0.0;
+    size_t warmupAllocations = 0, steadyAllocations = 0, drawn = 0;
+    for (int frame = 0; frame < warmupFrames + frames; frame++)
+    {
+        FrameArena::BeginFrame();
+        HeapStats heapBefore = GetHeapStats();
+        auto start = std::chrono::steady_clock::now();
+
+        // objects bob in place, the camera turns around the middle of the field
+        float time = frame * 0.05f;
+        for (unsigned int i = 0; i < objectCount; i++)
+        {
+            glm::vec3 center = centers[i] + glm::vec3(0.0f, std::sin(time + i) * 0.5f, 0.0f);
+            boundsMin[i] = center - glm::vec3(0.5f);
+            boundsMax[i] = center + glm::vec3(0.5f);
+        }
+        glm::vec3 eye(0.0f, 3.0f, 0.0f);
+        glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(std::cos(time * 0.2f), -0.1f, std::sin(time * 0.2f)), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 viewProjection = glm::perspective(glm::radians(fovY), aspect, near, far) * view;
+
+        if (frame == 0)
+            bvh.Build(boundsMin.data(), boundsMax.data(), objectCount);
+        else
+            bvh.Refit(boundsMin.data(), boundsMax.data());
+        visibleObjects.clear();
+        bvh.QueryFrustum(Frustum(viewProjection), visibleObjects);
+
+        for (PointLight &light : lights)
+            light.positionRadius.y = 1.0f + std::sin(time + light.positionRadius.x);
+        grid.Build(lights.data(), lightCount, view, glm::radians(fovY), aspect, near, far);
+
+        // the nearest objects in view occlude the rest, the survivors get a level of detail and go into the draw list
+        culler.BeginFrame(viewProjection);
+        for (size_t i = 0; i < visibleObjects.size() && i < occluderCount; i++)
+        {
+            glm::vec3 center = (boundsMin[visibleObjects[i]] + boundsMax[visibleObjects[i]]) * 0.5f;
+            culler.AddOccluder(box.data(), box.size(), boxIndices.data(), boxIndices.size(), glm::translate(glm::mat4(1.0f), center));
+        }
+        culler.Rasterize();
+        selector.SetView(eye, fovY, 600.0f);
+        FrameVector<DrawItem> drawList;
+        drawList.reserve(visibleObjects.size());
+        for (uint32_t object : visibleObjects)
+        {
+            if (!culler.IsVisible(boundsMin[object], boundsMax[object]))
+                continue;
+            glm::vec3 center = (boundsMin[object] + boundsMax[object]) * 0.5f;
+            unsigned int level = selector.Select(object, lodErrors, 4, center, 0.87f, 1.0f).level;
+            drawList.push_back(DrawItem{ object, level });
+        }
+        // grouped by level like BatchRenderer groups by mesh
+        std::sort(drawList.begin(), drawList.end(), [](const DrawItem &a, const DrawItem &b) { return a.level < b.level; });
+
+        size_t allocations = GetHeapStats().allocations - heapBefore.allocations;
+        if (frame < warmupFrames)
+        {
+            warmupAllocations += allocations;
+            continue;
+        }
+        frameMs += millisecondsSince(start);
+        steadyAllocations += allocations;
+        drawn += drawList.size();
+    }
+    FrameArena::BeginFrame();
+
+    const FrameArenaStats &arena = FrameArena::Stats();
+    std::cout << "frame: " << objectCount << " objects, " << lightCount << " lights, " << frames << " frames after " << warmupFrames << " warm-up frames on "
+              << JobSystem::ThreadCount() << " threads" << std::endl;
+    std::cout << "  cpu    " << frameMs / frames << " ms per frame (BVH refit and query, light binning, occlusion, LOD, draw list), "
+              << drawn / frames << " objects drawn" << std::endl;
+    std::cout << "  heap   " << steadyAllocations << " allocations in the measured frames, " << warmupAllocations << " while warming up" << std::endl;
+    std::cout << "  arena  " << arena.peakBytes / 1024 << " KB per frame at most, " << arena.blockAllocations << " blocks taken from the heap" << std::endl;
+    return steadyAllocations == 0 ? 0 : 1;
+}
+
+
+struct Benchmark
+{
+    const char *name;
+    const char *usage;
+    int (*run)(int argc, char **argv);
+};
+
+static const Benchmark benchmarks[] = {
+    { "occlusion", "[objects] [occluders]  software depth rasterizer and Hi-Z test", benchOcclusion },
+    { "bvh",       "[objects]              BVH build, refit and scene queries", benchBvh },
+    { "octree",    "[objects] [frames]     loose octree updates and queries with moving objects", benchOctree },
+    { "clusters",  "[lights] [frames]      binning point lights into view frustum clusters", benchClusters },
+    { "shadows",   "[objects] [frames]     cascade fitting and shadow cache invalidation for a walking camera", benchShadows },
+    { "lod",       "[meshes] [columns]     quadric simplification into LOD chains and level selection", benchLod },
+    { "meshload",  "[megabytes | file]     OBJ and .glb loading throughput on generated meshes or a model file", benchMeshLoad },
+    { "cooked",    "[megabytes]            loading a cooked mesh against parsing the OBJ it was cooked from", benchCooked },
+    { "meshlets",  "[columns] [views]      meshlet building and frustum / normal cone culling of a dense torus", benchMeshlets },
+    { "frame",     "[objects] [frames]     the CPU side of a steady-state frame, counting heap allocations", benchFrame },
+};
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: laky_bench <benchmark> [options]" << std::endl;
+        for (const Benchmark &benchmark : benchmarks)
+            std::cout << "  " << benchmark.name << " " << benchmark.usage << std::endl;
+        return 1;
+    }
+
+    for (const Benchmark &benchmark : benchmarks)
+    {
+        if (strcmp(argv[1], benchmark.name) == 0)
+        {
+            JobSystem::Start();
+            FrameArena::Start(1024 * 1024);
+            int result = benchmark.run(argc - 2, argv + 2);
+            FrameArena::Stop();
+            JobSystem::Stop();
+            return result;
+        }
+    }
+    std::cout << "Unknown benchmark: " << argv[1] << std::endl;
+    return 1;
+}
@@ -0,0 +1,570 @@
+// LAKY'S BVH v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_bvh.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "../laky_jobs/laky_jobs.h"
+
+// SAH bins per axis
+static const unsigned int BIN_COUNT = 12;
+// items per chunk when a pass over a big node is spread across the JobSystem
+static const size_t BUILD_GRAIN = 16384;
+// nodes with fewer items are split on one thread, as part of a subtree
+static const uint32_t PARALLEL_SPLIT_MIN = 65536;
+// nodes with fewer items only try splits along their longest axis, the other two rarely win that far down
+static const uint32_t ALL_AXES_MIN = 1024;
+
+// half the surface area of a box, all the SAH needs is the ratio between areas
+static float halfArea(const glm::vec3 &min, const glm::vec3 &max)
+{
+    glm::vec3 extent = glm::max(max - min, glm::vec3(0.0f));
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+// one SAH bin: the bounds and number of the items whose centroid falls into it
+struct Bin
+{
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+    uint32_t  count = 0;
+};
+
+// twice the center of an item's bounds, the factor doesn't matter for binning
+static glm::vec3 centroid(const glm::vec3 &min, const glm::vec3 &max)
+{
+    return min + max;
+}
+
+// bin of a centroid coordinate along an axis
+static unsigned int binIndex(float value, float axisMin, float binScale)
+{
+    int bin = (int)((value - axisMin) * binScale);
+    return (unsigned int)std::min(std::max(bin, 0), (int)BIN_COUNT - 1);
+}
+
+
+void Bvh::Build(const glm::vec3 *boundsMin, const glm::vec3 *boundsMax, size_t count)
+{
+    nodes.clear();
+    items.resize(count);
+    if (count == 0)
+        return;
+
+    itemMin = boundsMin;
+    itemMax = boundsMax;
+    buildItems.resize(count);
+    JobSystem::ParallelFor(count, BUILD_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            buildItems[i].min = boundsMin[i];
+            buildItems[i].index = (uint32_t)i;
+            buildItems[i].max = boundsMax[i];
+        }
+    });
+
+    nodes.push_back(BvhNode());
+    makeLeaf(nodes[0], 0, (uint32_t)count, true);
+
+    // split the top of the tree breadth first, each split bins its items on all threads,
+    // until there are enough independent subtrees to keep every thread busy on its own
+    const size_t wantedSubtrees = JobSystem::ThreadCount() * 8;
+    FrameVector<BuildTask> queue(1, BuildTask{ 0, 0 });
+    FrameVector<BuildTask> subtrees;
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        BuildTask task = queue[head];
+        if (nodes[task.node].count < PARALLEL_SPLIT_MIN || queue.size() - head - 1 + subtrees.size() >= wantedSubtrees)
+        {
+            subtrees.push_back(task);
+            continue;
+        }
+
+        BvhNode leftChild, rightChild;
+        if (!split(nodes[task.node], task.depth, true, leftChild, rightChild))
+            continue;
+        uint32_t left = (uint32_t)nodes.size();
+        nodes.push_back(leftChild);
+        nodes.push_back(rightChild);
+        nodes[task.node].leftFirst = left;
+        nodes[task.node].count = 0;
+        queue.push_back(BuildTask{ left, task.depth + 1 });
+        queue.push_back(BuildTask{ left + 1, task.depth + 1 });
+    }
+
+    // the subtrees own disjoint item ranges, so they can be built side by side into local arrays (each in its thread's arena)
+    FrameVector<FrameVector<BvhNode>> built(subtrees.size());
+    JobSystem::ParallelFor(subtrees.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            buildSubtree(subtrees[i], built[i]);
+    });
+
+    // then appended one after another, each subtree's root replaces the node it grew from
+    size_t total = nodes.size();
+    for (const FrameVector<BvhNode> &subtree : built)
+        total += subtree.size() - 1;
+    nodes.reserve(total);
+    for (size_t i = 0; i < subtrees.size(); i++)
+    {
+        uint32_t base = (uint32_t)nodes.size() - 1; // local node 1 lands at nodes.size()
+        for (size_t local = 0; local < built[i].size(); local++)
+        {
+            BvhNode node = built[i][local];
+            if (!node.IsLeaf())
+                node.leftFirst += base;
+            if (local == 0)
+                nodes[subtrees[i].node] = node;
+            else
+                nodes.push_back(node);
+        }
+    }
+
+    // the splits left the build items in leaf order
+    JobSystem::ParallelFor(count, BUILD_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            items[i] = buildItems[i].index;
+    });
+    buildItems.clear();
+    buildItems.shrink_to_fit();
+}
+
+void Bvh::Refit(const glm::vec3 *boundsMin, const glm::vec3 *boundsMax)
+{
+    if (nodes.empty())
+        return;
+    itemMin = boundsMin;
+    itemMax = boundsMax;
+
+    // leaves are independent of each other
+    JobSystem::ParallelFor(nodes.size(), BUILD_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            BvhNode &node = nodes[i];
+            if (!node.IsLeaf())
+                continue;
+            node.boundsMin = glm::vec3(FLT_MAX);
+            node.boundsMax = glm::vec3(-FLT_MAX);
+            for (uint32_t item = node.leftFirst; item < node.leftFirst + node.count; item++)
+            {
+                node.boundsMin = glm::min(node.boundsMin, boundsMin[items[item]]);
+                node.boundsMax = glm::max(node.boundsMax, boundsMax[items[item]]);
+            }
+        }
+    });
+
+    // children are always stored after their parent, so one backwards sweep updates the interior bottom up
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        BvhNode &node = nodes[i];
+        if (node.IsLeaf())
+            continue;
+        const BvhNode &left = nodes[node.leftFirst];
+        const BvhNode &right = nodes[node.leftFirst + 1];
+        node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+        node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+    }
+}
+
+void Bvh::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &result) const
+{
+    if (nodes.empty())
+        return;
+
+    // every stack entry carries the planes its box still straddles, planes a parent is fully inside of are never tested again
+    struct Entry
+    {
+        uint32_t     node;
+        unsigned int planeMask;
+    };
+    Entry stack[STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = Entry{ 0, Frustum::ALL_PLANES };
+
+    while (stackSize > 0)
+    {
+        Entry entry = stack[--stackSize];
+        const BvhNode &node = nodes[entry.node];
+
+        unsigned int mask = entry.planeMask;
+        if (!frustum.IntersectsAABB(node.boundsMin, node.boundsMax, mask))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            // a leaf's items get the same test, with only the planes that are left
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                uint32_t item = items[i];
+                unsigned int itemMask = mask;
+                if (frustum.IntersectsAABB(itemMin[item], itemMax[item], itemMask))
+                    result.push_back(item);
+            }
+            continue;
+        }
+        stack[stackSize++] = Entry{ node.leftFirst + 1, mask };
+        stack[stackSize++] = Entry{ node.leftFirst, mask };
+    }
+}
+
+void Bvh::QuerySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &result) const
+{
+    if (nodes.empty())
+        return;
+
+    const float radiusSquared = radius * radius;
+    uint32_t stack[STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const BvhNode &node = nodes[stack[--stackSize]];
+        // distance from the sphere's center to the closest point of the box
+        glm::vec3 offset = center - glm::clamp(center, node.boundsMin, node.boundsMax);
+        if (glm::dot(offset, offset) > radiusSquared)
+            continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                uint32_t item = items[i];
+                glm::vec3 itemOffset = center - glm::clamp(center, itemMin[item], itemMax[item]);
+                if (glm::dot(itemOffset, itemOffset) <= radiusSquared)
+                    result.push_back(item);
+            }
+            continue;
+        }
+        stack[stackSize++] = node.leftFirst + 1;
+        stack[stackSize++] = node.leftFirst;
+    }
+}
+
+// slab test, returns the entry distance along the ray or FLT_MAX if the box is missed
+static float rayBox(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance, const glm::vec3 &min, const glm::vec3 &max)
+{
+    glm::vec3 t0 = (min - origin) * inverseDirection;
+    glm::vec3 t1 = (max - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return entry <= exit ? entry : FLT_MAX;
+}
+
+bool Bvh::Raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, BvhHit &hit) const
+{
+    if (nodes.empty())
+        return false;
+
+    // a zero component would turn 0 * inf into NaN on the slab boundary, a huge finite value behaves the same otherwise
+    glm::vec3 inverseDirection;
+    for (int axis = 0; axis < 3; axis++)
+        inverseDirection[axis] = 1.0f / (direction[axis] != 0.0f ? direction[axis] : 1e-30f);
+
+    float closest = maxDistance;
+    bool found = false;
+    struct Entry
+    {
+        uint32_t node;
+        float    distance;
+    };
+    Entry stack[STACK_SIZE];
+    unsigned int stackSize = 0;
+    float rootDistance = rayBox(origin, inverseDirection, closest, nodes[0].boundsMin, nodes[0].boundsMax);
+    if (rootDistance != FLT_MAX)
+        stack[stackSize++] = Entry{ 0, rootDistance };
+
+    while (stackSize > 0)
+    {
+        Entry entry = stack[--stackSize];
+        if (entry.distance > closest)
+            continue;
+        const BvhNode &node = nodes[entry.node];
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                uint32_t item = items[i];
+                float distance = rayBox(origin, inverseDirection, closest, itemMin[item], itemMax[item]);
+                if (distance != FLT_MAX && (!found || distance < closest))
+                {
+                    closest = distance;
+                    hit.item = item;
+                    hit.distance = distance;
+                    found = true;
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first, the farther one is often skipped once something closer was hit
+        const BvhNode &left = nodes[node.leftFirst];
+        const BvhNode &right = nodes[node.leftFirst + 1];
+        float leftDistance = rayBox(origin, inverseDirection, closest, left.boundsMin, left.boundsMax);
+        float rightDistance = rayBox(origin, inverseDirection, closest, right.boundsMin, right.boundsMax);
+        Entry nearEntry = Entry{ node.leftFirst, leftDistance };
+        Entry farEntry = Entry{ node.leftFirst + 1, rightDistance };
+        if (rightDistance < leftDistance)
+            std::swap(nearEntry, farEntry);
+        if (farEntry.distance != FLT_MAX)
+            stack[stackSize++] = farEntry;
+        if (nearEntry.distance != FLT_MAX)
+            stack[stackSize++] = nearEntry;
+    }
+    return found;
+}
+
+float Bvh::Cost() const
+{
+    if (nodes.empty())
+        return 0.0f;
+
+    float cost = 0.0f;
+    for (const BvhNode &node : nodes)
+        cost += halfArea(node.boundsMin, node.boundsMax) * (node.IsLeaf() ? (float)node.count : 1.0f);
+    float rootArea = halfArea(nodes[0].boundsMin, nodes[0].boundsMax);
+    return rootArea > 0.0f ? cost / rootArea : cost;
+}
+
+
+void Bvh::itemBounds(uint32_t first, uint32_t count, glm::vec3 &min, glm::vec3 &max, bool parallel) const
+{
+    min = glm::vec3(FLT_MAX);
+    max = glm::vec3(-FLT_MAX);
+    if (!parallel || count < 2 * BUILD_GRAIN)
+    {
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            min = glm::min(min, buildItems[i].min);
+            max = glm::max(max, buildItems[i].max);
+        }
+        return;
+    }
+
+    // one partial result per chunk, merged afterwards
+    size_t chunks = (count + BUILD_GRAIN - 1) / BUILD_GRAIN;
+    FrameVector<glm::vec3> partialMin(chunks, glm::vec3(FLT_MAX)), partialMax(chunks, glm::vec3(-FLT_MAX));
+    JobSystem::ParallelFor(count, BUILD_GRAIN, [&](size_t begin, size_t end) {
+        size_t chunk = begin / BUILD_GRAIN;
+        for (size_t i = first + begin; i < first + end; i++)
+        {
+            partialMin[chunk] = glm::min(partialMin[chunk], buildItems[i].min);
+            partialMax[chunk] = glm::max(partialMax[chunk], buildItems[i].max);
+        }
+    });
+    for (size_t chunk = 0; chunk < chunks; chunk++)
+    {
+        min = glm::min(min, partialMin[chunk]);
+        max = glm::max(max, partialMax[chunk]);
+    }
+}
+
+void Bvh::makeLeaf(BvhNode &node, uint32_t first, uint32_t count, bool parallel) const
+{
+    itemBounds(first, count, node.boundsMin, node.boundsMax, parallel);
+    node.leftFirst = first;
+    node.count = count;
+}
+
+bool Bvh::split(const BvhNode &node, uint32_t depth, bool parallel, BvhNode &left, BvhNode &right)
+{
+    const uint32_t first = node.leftFirst;
+    const uint32_t count = node.count;
+    if (count <= 1)
+        return false;
+    parallel = parallel && count >= 2 * BUILD_GRAIN;
+    const size_t chunks = parallel ? (count + BUILD_GRAIN - 1) / BUILD_GRAIN : 0;
+
+    // bounds of the centroids, the bins span these rather than the node's bounds
+    glm::vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+    if (parallel)
+    {
+        FrameVector<glm::vec3> partialMin(chunks, glm::vec3(FLT_MAX)), partialMax(chunks, glm::vec3(-FLT_MAX));
+        JobSystem::ParallelFor(count, BUILD_GRAIN, [&](size_t begin, size_t end) {
+            size_t chunk = begin / BUILD_GRAIN;
+            for (size_t i = first + begin; i < first + end; i++)
+            {
+                glm::vec3 center = centroid(buildItems[i].min, buildItems[i].max);
+                partialMin[chunk] = glm::min(partialMin[chunk], center);
+                partialMax[chunk] = glm::max(partialMax[chunk], center);
+            }
+        });
+        for (size_t chunk = 0; chunk < chunks; chunk++)
+        {
+            centroidMin = glm::min(centroidMin, partialMin[chunk]);
+            centroidMax = glm::max(centroidMax, partialMax[chunk]);
+        }
+    }
+    else
+    {
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            glm::vec3 center = centroid(buildItems[i].min, buildItems[i].max);
+            centroidMin = glm::min(centroidMin, center);
+            centroidMax = glm::max(centroidMax, center);
+        }
+    }
+    glm::vec3 extent = centroidMax - centroidMin;
+    int largestAxis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+    // all centroids in one spot: nothing to split along, halve big leaves anyway to keep them small
+    if (extent[largestAxis] <= 0.0f)
+    {
+        if (count <= MAX_LEAF_SIZE)
+            return false;
+        makeLeaf(left, first, count / 2, parallel);
+        makeLeaf(right, first + count / 2, count - count / 2, parallel);
+        return true;
+    }
+
+    // deep down the tree the object median bounds the remaining depth, whatever the item distribution is
+    if (depth >= SAH_MAX_DEPTH)
+    {
+        if (count <= MAX_LEAF_SIZE)
+            return false;
+        BuildItem *range = buildItems.data() + first;
+        std::nth_element(range, range + count / 2, range + count, [&](const BuildItem &a, const BuildItem &b) {
+            return centroid(a.min, a.max)[largestAxis] < centroid(b.min, b.max)[largestAxis];
+        });
+        makeLeaf(left, first, count / 2, parallel);
+        makeLeaf(right, first + count / 2, count - count / 2, parallel);
+        return true;
+    }
+
+    // bin the items, big nodes into one set of bins per chunk that get merged afterwards
+    const int axisBegin = count >= ALL_AXES_MIN ? 0 : largestAxis;
+    const int axisEnd = count >= ALL_AXES_MIN ? 3 : largestAxis + 1;
+    glm::vec3 binScale;
+    for (int axis = 0; axis < 3; axis++)
+        binScale[axis] = extent[axis] > 0.0f ? BIN_COUNT / extent[axis] : 0.0f;
+    auto fillBins = [&](Bin *bins, size_t begin, size_t end) {
+        for (size_t i = first + begin; i < first + end; i++)
+        {
+            const BuildItem &item = buildItems[i];
+            glm::vec3 center = centroid(item.min, item.max);
+            for (int axis = axisBegin; axis < axisEnd; axis++)
+            {
+                Bin &bin = bins[axis * BIN_COUNT + binIndex(center[axis], centroidMin[axis], binScale[axis])];
+                bin.min = glm::min(bin.min, item.min);
+                bin.max = glm::max(bin.max, item.max);
+                bin.count++;
+            }
+        }
+    };
+    Bin bins[3][BIN_COUNT];
+    if (parallel)
+    {
+        FrameVector<Bin> partialBins(chunks * 3 * BIN_COUNT);
+        JobSystem::ParallelFor(count, BUILD_GRAIN, [&](size_t begin, size_t end) {
+            fillBins(&partialBins[begin / BUILD_GRAIN * 3 * BIN_COUNT], begin, end);
+        });
+        for (size_t chunk = 0; chunk < chunks; chunk++)
+        {
+            for (int axis = axisBegin; axis < axisEnd; axis++)
+            {
+                for (unsigned int b = 0; b < BIN_COUNT; b++)
+                {
+                    const Bin &partial = partialBins[(chunk * 3 + axis) * BIN_COUNT + b];
+                    bins[axis][b].min = glm::min(bins[axis][b].min, partial.min);
+                    bins[axis][b].max = glm::max(bins[axis][b].max, partial.max);
+                    bins[axis][b].count += partial.count;
+                }
+            }
+        }
+    }
+    else
+        fillBins(&bins[0][0], 0, count);
+
+    // sweep the split planes between the bins from both sides, cost = area * items on each side
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    unsigned int bestSplit = 0;
+    for (int axis = axisBegin; axis < axisEnd; axis++)
+    {
+        if (extent[axis] <= 0.0f)
+            continue;
+        float rightCost[BIN_COUNT];
+        Bin right;
+        for (unsigned int b = BIN_COUNT - 1; b > 0; b--)
+        {
+            right.min = glm::min(right.min, bins[axis][b].min);
+            right.max = glm::max(right.max, bins[axis][b].max);
+            right.count += bins[axis][b].count;
+            rightCost[b] = right.count ? halfArea(right.min, right.max) * right.count : 0.0f;
+        }
+        Bin left;
+        for (unsigned int b = 0; b < BIN_COUNT - 1; b++)
+        {
+            left.min = glm::min(left.min, bins[axis][b].min);
+            left.max = glm::max(left.max, bins[axis][b].max);
+            left.count += bins[axis][b].count;
+            if (left.count == 0 || left.count == count)
+                continue;
+            float cost = halfArea(left.min, left.max) * left.count + rightCost[b + 1];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // a small leaf stays one when testing its items is cheaper than one more node (traversal and item test cost the same)
+    float nodeArea = halfArea(node.boundsMin, node.boundsMax);
+    if (count <= MAX_LEAF_SIZE && (bestAxis < 0 || nodeArea <= 0.0f || 1.0f + bestCost / nodeArea >= (float)count))
+        return false;
+    if (bestAxis < 0)
+    {
+        makeLeaf(left, first, count / 2, parallel);
+        makeLeaf(right, first + count / 2, count - count / 2, parallel);
+        return true;
+    }
+
+    BuildItem *range = buildItems.data() + first;
+    BuildItem *middle = std::partition(range, range + count, [&](const BuildItem &item) {
+        return binIndex(centroid(item.min, item.max)[bestAxis], centroidMin[bestAxis], binScale[bestAxis]) <= bestSplit;
+    });
+    uint32_t leftCount = (uint32_t)(middle - range);
+
+    // the children's bounds are the union of their bins, no need to walk the items again
+    left = BvhNode{ glm::vec3(FLT_MAX), first, glm::vec3(-FLT_MAX), leftCount };
+    right = BvhNode{ glm::vec3(FLT_MAX), first + leftCount, glm::vec3(-FLT_MAX), count - leftCount };
+    for (unsigned int b = 0; b < BIN_COUNT; b++)
+    {
+        BvhNode &child = b <= bestSplit ? left : right;
+        child.boundsMin = glm::min(child.boundsMin, bins[bestAxis][b].min);
+        child.boundsMax = glm::max(child.boundsMax, bins[bestAxis][b].max);
+    }
+    return true;
+}
+
+void Bvh::buildSubtree(const BuildTask &task, FrameVector<BvhNode> &out)
+{
+    out.clear();
+    out.push_back(nodes[task.node]);
+
+    // depth first, so every left child's subtree directly follows its parent's pair of children
+    FrameVector<BuildTask> stack(1, BuildTask{ 0, task.depth });
+    while (!stack.empty())
+    {
+        BuildTask current = stack.back();
+        stack.pop_back();
+
+        BvhNode leftChild, rightChild;
+        if (!split(out[current.node], current.depth, false, leftChild, rightChild))
+            continue;
+        uint32_t left = (uint32_t)out.size();
+        out.push_back(leftChild);
+        out.push_back(rightChild);
+        out[current.node].leftFirst = left;
+        out[current.node].count = 0;
+        stack.push_back(BuildTask{ left + 1, current.depth + 1 });
+        stack.push_back(BuildTask{ left, current.depth + 1 });
+    }
+}
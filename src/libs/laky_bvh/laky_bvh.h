@@ -0,0 +1,101 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../laky_frustum.h"
+#include "../laky_memory/laky_framearena.h"
+
+
+// One node of the flattened tree, 32 bytes so two share a cache line. Both
+// children of a node are stored next to each other (left, left + 1), and a
+// child always comes after its parent, so walking the array backwards visits
+// children before parents.
+struct BvhNode
+{
+    glm::vec3 boundsMin;
+    uint32_t  leftFirst;  // interior: index of the left child, leaf: first entry in the item list
+    glm::vec3 boundsMax;
+    uint32_t  count;      // number of items in a leaf, 0 for interior nodes
+
+    bool IsLeaf() const { return count != 0; }
+};
+
+// closest item bounds hit by Bvh::Raycast
+struct BvhHit
+{
+    uint32_t item;      // index into the bounds the tree was built from
+    float    distance;  // along the ray, in units of the direction's length
+};
+
+// Bvh is a bounding volume hierarchy over axis-aligned item bounds (scene
+// objects, lights, ...). Build uses the binned surface area heuristic; the
+// large top-level splits bin their items on the JobSystem and the remaining
+// subtrees are built in parallel. Refit keeps the topology and only recomputes
+// the node bounds, which is the cheap way to follow moving items as long as
+// they don't travel far from where they were at build time. Queries return
+// item indices (positions in the array given to Build). Build's scratch
+// comes from the FrameArena.
+class Bvh
+{
+public:
+    // leaves hold at most this many items
+    static const unsigned int MAX_LEAF_SIZE = 4;
+
+    // (re)builds the tree over `count` item bounds, the arrays are referenced (not copied) by the queries until the next Build or Refit
+    void Build(const glm::vec3 *boundsMin, const glm::vec3 *boundsMax, size_t count);
+    // recomputes the node bounds after items moved, the arrays must hold the same items as in Build
+    void Refit(const glm::vec3 *boundsMin, const glm::vec3 *boundsMax);
+    // appends every item whose bounds intersect the frustum
+    void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &result) const;
+    // appends every item whose bounds touch the sphere (e.g. objects inside a light's radius)
+    void QuerySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &result) const;
+    // finds the closest item bounds along a ray within maxDistance, false if none is hit
+    bool Raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, BvhHit &hit) const;
+
+    const std::vector<BvhNode> &Nodes() const { return nodes; }
+    size_t NodeCount() const { return nodes.size(); }
+    size_t ItemCount() const { return items.size(); }
+    // SAH cost of the current tree (traversal steps + item tests per random ray, relative to the root)
+    float Cost() const;
+private:
+    std::vector<BvhNode>   nodes;
+    std::vector<uint32_t>  items;      // item indices, each leaf owns a contiguous range
+    const glm::vec3       *itemMin = NULL;
+    const glm::vec3       *itemMax = NULL;
+
+    // item bounds copied next to their index while building, so splits stream through memory instead of chasing indices
+    struct BuildItem
+    {
+        glm::vec3 min;
+        uint32_t  index;
+        glm::vec3 max;
+    };
+    std::vector<BuildItem> buildItems;
+
+    // below this depth SAH splits give way to median splits, which keeps every traversal within a fixed size stack
+    static const unsigned int SAH_MAX_DEPTH = 32;
+    static const unsigned int STACK_SIZE = 96;
+
+    // a node whose range of items still has to be split
+    struct BuildTask
+    {
+        uint32_t node;
+        uint32_t depth;
+    };
+
+    // bounds of a range of build items, optionally reduced on the JobSystem
+    void itemBounds(uint32_t first, uint32_t count, glm::vec3 &min, glm::vec3 &max, bool parallel) const;
+    // turns a node into a leaf over a range of items with matching bounds
+    void makeLeaf(BvhNode &node, uint32_t first, uint32_t count, bool parallel) const;
+    // reorders a leaf's items into two halves described by left and right, false if it should stay a leaf
+    bool split(const BvhNode &node, uint32_t depth, bool parallel, BvhNode &left, BvhNode &right);
+    // builds the subtree below a task depth first into `out`, node 0 of `out` is the task's node
+    void buildSubtree(const BuildTask &task, FrameVector<BvhNode> &out);
+};
+
+#endif
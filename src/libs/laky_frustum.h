@@ -0,0 +1,121 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+// Frustum holds the six clip planes of a view-projection matrix, each as
+// (normal, distance) with the normal pointing into the frustum, so a point
+// p is inside a plane when dot(normal, p) + distance >= 0. The plane order
+// (left, right, bottom, top, near, far) matches the culling shaders.
+class Frustum
+{
+public:
+    static const unsigned int ALL_PLANES = 0x3F;
+
+    glm::vec4 Planes[6];
+
+    Frustum() { }
+    // extracts the planes from a projection * view matrix (Gribb/Hartmann), normalized so distances are in world units
+    explicit Frustum(const glm::mat4 &viewProjection)
+    {
+        // rows of the matrix, glm stores columns
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; i++)
+            row[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+        Planes[0] = row[3] + row[0]; // left
+        Planes[1] = row[3] - row[0]; // right
+        Planes[2] = row[3] + row[1]; // bottom
+        Planes[3] = row[3] - row[1]; // top
+        Planes[4] = row[3] + row[2]; // near
+        Planes[5] = row[3] - row[2]; // far
+        for (int i = 0; i < 6; i++)
+            Planes[i] /= glm::length(glm::vec3(Planes[i]));
+    }
+
+    // true if the sphere is at least partially inside
+    bool IntersectsSphere(const glm::vec3 &center, float radius) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            if (glm::dot(glm::vec3(Planes[i]), center) + Planes[i].w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    // same, testing only the planes set in the mask (bit i = Planes[i])
+    bool IntersectsSphere(const glm::vec3 &center, float radius, unsigned int mask) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            if ((mask & (1u << i)) && glm::dot(glm::vec3(Planes[i]), center) + Planes[i].w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    // true if the axis-aligned box is at least partially inside (conservative near the frustum's corners)
+    bool IntersectsAABB(const glm::vec3 &min, const glm::vec3 &max) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            // the box corner furthest along the plane normal
+            glm::vec3 positive(Planes[i].x >= 0.0f ? max.x : min.x,
+                               Planes[i].y >= 0.0f ? max.y : min.y,
+                               Planes[i].z >= 0.0f ? max.z : min.z);
+            if (glm::dot(glm::vec3(Planes[i]), positive) + Planes[i].w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    // same, testing only the planes set in the mask and clearing the ones the box is entirely inside of,
+    // so a hierarchy passes the mask down and anything below a box skips the planes it can't cross
+    bool IntersectsAABB(const glm::vec3 &min, const glm::vec3 &max, unsigned int &mask) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            if (!(mask & (1u << i)))
+                continue;
+            glm::vec3 normal = glm::vec3(Planes[i]);
+            glm::vec3 positive(normal.x >= 0.0f ? max.x : min.x, normal.y >= 0.0f ? max.y : min.y, normal.z >= 0.0f ? max.z : min.z);
+            if (glm::dot(normal, positive) + Planes[i].w < 0.0f)
+                return false;
+            glm::vec3 negative(normal.x >= 0.0f ? min.x : max.x, normal.y >= 0.0f ? min.y : max.y, normal.z >= 0.0f ? min.z : max.z);
+            if (glm::dot(normal, negative) + Planes[i].w >= 0.0f)
+                mask &= ~(1u << i);
+        }
+        return true;
+    }
+};
+
+// bounding sphere of a local-space sphere after a model transform (the radius grows with the largest axis scale)
+inline glm::vec4 TransformSphere(const glm::mat4 &model, const glm::vec4 &sphere)
+{
+    glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(sphere), 1.0f));
+    float scale = std::sqrt(glm::max(glm::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                              glm::dot(glm::vec3(model[1]), glm::vec3(model[1]))),
+                                     glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))));
+    return glm::vec4(center, sphere.w * scale);
+}
+
+// axis-aligned bounds of a local-space box after a model transform (Arvo's method, tight around the transformed corners)
+inline void TransformAABB(const glm::mat4 &model, const glm::vec3 &min, const glm::vec3 &max, glm::vec3 &outMin, glm::vec3 &outMax)
+{
+    outMin = outMax = glm::vec3(model[3]);
+    for (int column = 0; column < 3; column++)
+    {
+        for (int row = 0; row < 3; row++)
+        {
+            float a = model[column][row] * min[column];
+            float b = model[column][row] * max[column];
+            outMin[row] += a < b ? a : b;
+            outMax[row] += a < b ? b : a;
+        }
+    }
+}
+
+#endif
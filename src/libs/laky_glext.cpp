@@ -0,0 +1,50 @@
+// LAKY'S GL EXTENSIONS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_glext.h"
+
+#include <cstring>
+#include <iostream>
+
+// Instantiate static variables
+bool                                  GLExtensions::ParallelShaderCompile = false;
+LAKYPFNGLMAXSHADERCOMPILERTHREADSPROC GLExtensions::MaxShaderCompilerThreads = NULL;
+bool                                  GLExtensions::BindlessTexture = false;
+LAKYPFNGLGETTEXTUREHANDLEARBPROC             GLExtensions::GetTextureHandle = NULL;
+LAKYPFNGLMAKETEXTUREHANDLERESIDENTARBPROC    GLExtensions::MakeTextureHandleResident = NULL;
+LAKYPFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC GLExtensions::MakeTextureHandleNonResident = NULL;
+
+
+void GLExtensions::Load(GLADloadproc load)
+{
+    if (Has("GL_KHR_parallel_shader_compile"))
+        MaxShaderCompilerThreads = (LAKYPFNGLMAXSHADERCOMPILERTHREADSPROC)load("glMaxShaderCompilerThreadsKHR");
+    else if (Has("GL_ARB_parallel_shader_compile"))
+        MaxShaderCompilerThreads = (LAKYPFNGLMAXSHADERCOMPILERTHREADSPROC)load("glMaxShaderCompilerThreadsARB");
+    ParallelShaderCompile = MaxShaderCompilerThreads != NULL;
+
+    if (Has("GL_ARB_bindless_texture"))
+    {
+        GetTextureHandle = (LAKYPFNGLGETTEXTUREHANDLEARBPROC)load("glGetTextureHandleARB");
+        MakeTextureHandleResident = (LAKYPFNGLMAKETEXTUREHANDLERESIDENTARBPROC)load("glMakeTextureHandleResidentARB");
+        MakeTextureHandleNonResident = (LAKYPFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)load("glMakeTextureHandleNonResidentARB");
+    }
+    BindlessTexture = GetTextureHandle != NULL && MakeTextureHandleResident != NULL && MakeTextureHandleNonResident != NULL;
+
+    std::cout << "GL extensions: parallel shader compile " << (ParallelShaderCompile ? "yes" : "no")
+              << ", bindless texture " << (BindlessTexture ? "yes" : "no") << std::endl;
+}
+
+bool GLExtensions::Has(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+    {
+        const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if (extension != NULL && strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#ifndef GL_EXTENSIONS_H
+#define GL_EXTENSIONS_H
+
+#include <glad/glad.h>
+
+// Our glad loader is generated for plain GL 4.6 without extensions, so the
+// few optional extensions we take advantage of are declared and loaded here.
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP LAKYPFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+// GL_ARB_bindless_texture
+typedef GLuint64 (APIENTRYP LAKYPFNGLGETTEXTUREHANDLEARBPROC)(GLuint texture);
+typedef void (APIENTRYP LAKYPFNGLMAKETEXTUREHANDLERESIDENTARBPROC)(GLuint64 handle);
+typedef void (APIENTRYP LAKYPFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)(GLuint64 handle);
+
+
+// Static registry of the optional extensions the driver exposes. Load()
+// must run once after gladLoadGLLoader, with the same loader function.
+class GLExtensions
+{
+public:
+    // parallel shader compilation (KHR or ARB flavour), lets us poll GL_COMPLETION_STATUS_KHR
+    static bool ParallelShaderCompile;
+    static LAKYPFNGLMAXSHADERCOMPILERTHREADSPROC MaxShaderCompilerThreads;
+    // bindless textures, shaders sample through 64-bit handles instead of texture units (not on every driver, e.g. most Mesa ones)
+    static bool BindlessTexture;
+    static LAKYPFNGLGETTEXTUREHANDLEARBPROC             GetTextureHandle;
+    static LAKYPFNGLMAKETEXTUREHANDLERESIDENTARBPROC    MakeTextureHandleResident;
+    static LAKYPFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC MakeTextureHandleNonResident;
+
+    // queries the extension list and loads the entry points we use
+    static void Load(GLADloadproc load);
+    // true if the driver advertises the extension
+    static bool Has(const char *name);
+private:
+    GLExtensions() { }
+};
+
+#endif
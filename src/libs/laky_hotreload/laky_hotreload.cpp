@@ -0,0 +1,282 @@
+// LAKY'S HOT RELOADER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_hotreload.h"
+
+#include <cstdio>
+#include <iostream>
+#include <algorithm>
+
+#include "../laky_resmanager.h"
+#include "../stb_image.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+
+// returns the lower case extension of a path including the dot, or an empty string
+static std::string fileExtension(const std::string &path)
+{
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && slash > dot))
+        return std::string();
+    std::string extension = path.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+static bool isImageFile(const std::string &extension)
+{
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".tga";
+}
+
+static bool isShaderFile(const std::string &extension)
+{
+    return extension == ".vert" || extension == ".frag" || extension == ".geom" || extension == ".comp" || extension == ".glsl";
+}
+
+
+HotReloader::HotReloader()
+    : running(false), inotifyFd(-1), layerFilesVersion(~0u)
+{
+    wakeFd[0] = wakeFd[1] = -1;
+}
+
+HotReloader::~HotReloader()
+{
+    Stop();
+    for (DecodedImage &image : pendingImages)
+    {
+        if (image.rgba != image.data)
+            stbi_image_free(image.rgba);
+        stbi_image_free(image.data);
+    }
+}
+
+#ifdef __linux__
+
+bool HotReloader::Start(const std::string &rootDirectory)
+{
+    if (running)
+        return true;
+
+    inotifyFd = inotify_init1(IN_CLOEXEC);
+    if (inotifyFd < 0)
+    {
+        std::cout << "ERROR::HOT_RELOAD: inotify_init1 failed, hot reloading is disabled" << std::endl;
+        return false;
+    }
+    if (pipe(wakeFd) != 0)
+    {
+        std::cout << "ERROR::HOT_RELOAD: pipe failed, hot reloading is disabled" << std::endl;
+        close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+
+    watchDirectory(rootDirectory);
+
+    running = true;
+    watcher = std::thread(&HotReloader::watch, this);
+    std::cout << "Hot reload: watching " << watchedDirectories.size() << " directories under " << rootDirectory << std::endl;
+    return true;
+}
+
+void HotReloader::Stop()
+{
+    if (!running)
+        return;
+
+    running = false;
+    char wake = 1;
+    if (write(wakeFd[1], &wake, 1) != 1)
+        std::cout << "ERROR::HOT_RELOAD: failed to wake the watcher thread" << std::endl;
+    watcher.join();
+
+    close(inotifyFd);
+    close(wakeFd[0]);
+    close(wakeFd[1]);
+    inotifyFd = wakeFd[0] = wakeFd[1] = -1;
+    watchedDirectories.clear();
+}
+
+void HotReloader::watchDirectory(const std::string &directory)
+{
+    int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        std::cout << "ERROR::HOT_RELOAD: Failed to watch " << directory << std::endl;
+        return;
+    }
+    watchedDirectories[wd] = directory;
+
+    DIR *dir = opendir(directory.c_str());
+    if (dir == NULL)
+        return;
+    while (dirent *entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if (entry->d_type == DT_DIR && name != "." && name != "..")
+            watchDirectory(directory + "/" + name);
+    }
+    closedir(dir);
+}
+
+void HotReloader::watch()
+{
+    // inotify events are variable sized, the buffer must be aligned for inotify_event
+    alignas(inotify_event) char buffer[4096];
+    std::vector<std::string> changed;
+
+    while (running)
+    {
+        pollfd fds[2] = { { inotifyFd, POLLIN, 0 }, { wakeFd[0], POLLIN, 0 } };
+        // block until something happens, then keep collecting until the directory has been quiet for 100ms
+        // (editors often write a file in several steps and we only want to reload it once)
+        int timeout = changed.empty() ? -1 : 100;
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0 || (fds[1].revents & POLLIN))
+            break;
+
+        if (ready == 0)
+        {
+            for (const std::string &path : changed)
+                fileChanged(path);
+            changed.clear();
+            continue;
+        }
+
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        for (char *ptr = buffer; length > 0 && ptr < buffer + length; )
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+            if (event->len == 0)
+                continue;
+
+            auto directory = watchedDirectories.find(event->wd);
+            if (directory == watchedDirectories.end())
+                continue;
+            std::string path = directory->second + "/" + event->name;
+
+            if ((event->mask & IN_CREATE) && (event->mask & IN_ISDIR))
+                watchDirectory(path);
+            else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && std::find(changed.begin(), changed.end(), path) == changed.end())
+                changed.push_back(path);
+        }
+    }
+}
+
+#else
+
+bool HotReloader::Start(const std::string &rootDirectory)
+{
+    std::cout << "Hot reload: not supported on this platform, " << rootDirectory << " will not be watched" << std::endl;
+    return false;
+}
+
+void HotReloader::Stop()
+{
+}
+
+void HotReloader::watchDirectory(const std::string &directory)
+{
+}
+
+void HotReloader::watch()
+{
+}
+
+#endif
+
+void HotReloader::fileChanged(const std::string &path)
+{
+    std::string extension = fileExtension(path);
+
+    if (isImageFile(extension))
+    {
+        // decoding is the expensive part of a texture reload, do it here instead of on the render thread
+        DecodedImage image;
+        image.path = path;
+        bool pooled;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pooled = layerFiles.count(path) > 0;
+        }
+        FILE *file = fopen(path.c_str(), "rb");
+        image.data = file != NULL ? stbi_load_from_file(file, &image.width, &image.height, &image.nrChannels, 0) : NULL;
+        image.rgba = image.data != NULL && image.nrChannels == 4 ? image.data : NULL;
+        if (image.data != NULL && pooled && image.nrChannels != 4)
+        {
+            // pooled layers are RGBA8, let stbi expand them exactly like LoadTextureLayer does
+            int width, height, nrChannels;
+            fseek(file, 0, SEEK_SET);
+            image.rgba = stbi_load_from_file(file, &width, &height, &nrChannels, 4);
+            if (image.rgba == NULL)
+            {
+                stbi_image_free(image.data);
+                image.data = NULL;
+            }
+        }
+        if (file != NULL)
+            fclose(file);
+        if (image.data == NULL)
+        {
+            std::cout << "ERROR::HOT_RELOAD: Failed to decode " << path << ": " << (file != NULL ? stbi_failure_reason() : "can't open file") << std::endl;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingImages.push_back(image);
+    }
+    else if (isShaderFile(extension))
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (std::find(pendingShaders.begin(), pendingShaders.end(), path) == pendingShaders.end())
+            pendingShaders.push_back(path);
+    }
+}
+
+void HotReloader::Update()
+{
+    // programs resubmitted on earlier frames go live once the driver is done with them
+    ResourceManager::FinishShaderReloads();
+
+    // never wait on the watcher, if it is busy queueing we pick the changes up next frame
+    std::vector<std::string> shaders;
+    std::vector<DecodedImage> images;
+    if (!pendingMutex.try_lock())
+        return;
+    // the watcher only decodes RGBA copies for these, refresh them whenever layers were loaded
+    if (layerFilesVersion != ResourceManager::GetTextureLayerVersion())
+    {
+        layerFilesVersion = ResourceManager::GetTextureLayerVersion();
+        std::vector<std::string> files = ResourceManager::GetTextureLayerFiles();
+        layerFiles = std::unordered_set<std::string>(files.begin(), files.end());
+    }
+    if (pendingShaders.empty() && pendingImages.empty())
+    {
+        pendingMutex.unlock();
+        return;
+    }
+    shaders.swap(pendingShaders);
+    images.swap(pendingImages);
+    pendingMutex.unlock();
+
+    for (const std::string &path : shaders)
+        ResourceManager::ReloadShaderFile(path);
+
+    for (DecodedImage &image : images)
+    {
+        ResourceManager::ReloadTextureFile(image.path, image.width, image.height, image.nrChannels, image.data, image.rgba);
+        if (image.rgba != image.data)
+            stbi_image_free(image.rgba);
+        stbi_image_free(image.data);
+    }
+}
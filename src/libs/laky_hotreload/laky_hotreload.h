@@ -0,0 +1,62 @@
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+// HotReloader watches an asset directory (and its sub directories) with
+// inotify on a background thread. Changed images are decoded on that
+// thread, changed shader sources are only queued; Update() then hands
+// everything over to the ResourceManager on the render thread, so the
+// swap always happens at a frame boundary. On platforms without inotify
+// Start() simply reports that hot reloading is unavailable.
+class HotReloader
+{
+public:
+    HotReloader();
+    ~HotReloader();
+    // starts watching the directory tree, paths are reported relative to the same root (e.g. "assets")
+    bool Start(const std::string &rootDirectory);
+    // stops the watcher thread
+    void Stop();
+    // applies all changes collected since the last call, call once per frame on the thread owning the GL context
+    void Update();
+private:
+    // an image decoded off-thread, waiting to be uploaded
+    struct DecodedImage
+    {
+        std::string    path;
+        int            width;
+        int            height;
+        int            nrChannels;
+        unsigned char *data;
+        unsigned char *rgba;    // the same image decoded to RGBA8 if it backs a pooled texture layer (else NULL), equals data if it already was
+    };
+
+    std::thread               watcher;
+    std::atomic<bool>         running;
+    int                       inotifyFd;
+    int                       wakeFd[2];    // pipe used to wake the watcher thread when stopping
+    std::unordered_map<int, std::string> watchedDirectories; // inotify watch descriptor -> directory path
+
+    std::mutex                pendingMutex;
+    std::vector<std::string>  pendingShaders;
+    std::vector<DecodedImage> pendingImages;
+    std::unordered_set<std::string> layerFiles; // files behind pooled texture layers, copied from the ResourceManager by Update
+    unsigned int              layerFilesVersion;
+
+    // recursively adds inotify watches for a directory tree
+    void watchDirectory(const std::string &directory);
+    // body of the watcher thread
+    void watch();
+    // handles a single changed file on the watcher thread
+    void fileChanged(const std::string &path);
+};
+
+#endif
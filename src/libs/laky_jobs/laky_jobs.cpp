@@ -0,0 +1,149 @@
+// LAKY'S JOB SYSTEM v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_jobs.h"
+
+// Instantiate static variables
+std::vector<std::thread>                     JobSystem::workers;
+std::mutex                                   JobSystem::mutex;
+std::condition_variable                      JobSystem::wake;
+std::condition_variable                      JobSystem::done;
+std::atomic<bool>                            JobSystem::busy(false);
+std::atomic<size_t>                          JobSystem::nextChunk(0);
+std::atomic<size_t>                          JobSystem::remaining(0);
+const void                                  *JobSystem::job = NULL;
+JobSystem::ChunkFunction                     JobSystem::jobFunction = NULL;
+size_t                                       JobSystem::jobCount = 0;
+size_t                                       JobSystem::jobGrain = 1;
+size_t                                       JobSystem::chunkCount = 0;
+unsigned long long                           JobSystem::generation = 0;
+unsigned int                                 JobSystem::activeWorkers = 0;
+bool                                         JobSystem::stopping = false;
+
+// set once by every worker, other threads keep 0
+static thread_local unsigned int threadIndex = 0;
+
+
+void JobSystem::Start(unsigned int threads)
+{
+    if (!workers.empty())
+        return;
+
+    if (threads == 0)
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 0;
+    }
+    stopping = false;
+    for (unsigned int i = 0; i < threads; i++)
+        workers.push_back(std::thread(workerLoop, i + 1));
+}
+
+void JobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+unsigned int JobSystem::ThreadCount()
+{
+    return (unsigned int)workers.size() + 1;
+}
+
+unsigned int JobSystem::ThreadIndex()
+{
+    return threadIndex;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const void *fn, ChunkFunction function)
+{
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+
+    // nested loops and single-chunk loops aren't worth waking anyone for
+    bool expected = false;
+    if (workers.empty() || count <= grain || !busy.compare_exchange_strong(expected, true))
+    {
+        for (size_t begin = 0; begin < count; begin += grain)
+            function(fn, begin, begin + grain < count ? begin + grain : count);
+        return;
+    }
+
+    {
+        // workers only read the loop description while they're counted as active, so wait for stragglers of the last loop
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [] { return activeWorkers == 0; });
+        job = fn;
+        jobFunction = function;
+        jobCount = count;
+        jobGrain = grain;
+        chunkCount = (count + grain - 1) / grain;
+        nextChunk = 0;
+        remaining = chunkCount;
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [] { return remaining == 0 && activeWorkers == 0; });
+        job = NULL;
+    }
+    busy = false;
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    threadIndex = index;
+    unsigned long long seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&seen] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            activeWorkers++;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        done.notify_all();
+    }
+}
+
+void JobSystem::runChunks()
+{
+    for (;;)
+    {
+        size_t chunk = nextChunk.fetch_add(1);
+        if (chunk >= chunkCount)
+            return;
+
+        size_t begin = chunk * jobGrain;
+        size_t end = begin + jobGrain < jobCount ? begin + jobGrain : jobCount;
+        jobFunction(job, begin, end);
+        if (remaining.fetch_sub(1) == 1)
+        {
+            // lock so the caller can't miss the wakeup between checking and waiting
+            std::lock_guard<std::mutex> lock(mutex);
+            done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// A static singleton JobSystem class that keeps a pool of worker threads
+// around for data-parallel loops. ParallelFor splits a range into chunks
+// that the workers and the calling thread pull from a shared counter, and
+// returns once every chunk ran. Only one loop runs at a time: calls from
+// inside a running loop (or before Start) simply run on the calling thread.
+// The loop body is only referenced, never copied, so starting a loop
+// doesn't touch the heap whatever the lambda captures.
+class JobSystem
+{
+public:
+    // starts `threads` workers, 0 = one less than the hardware threads (the caller also works)
+    static void         Start(unsigned int threads = 0);
+    // joins all workers
+    static void         Stop();
+    // threads taking part in a ParallelFor, including the caller
+    static unsigned int ThreadCount();
+    // index of the calling thread: 0 for any thread that isn't a worker, 1 to ThreadCount() - 1 for the workers
+    static unsigned int ThreadIndex();
+    // calls fn(begin, end) for consecutive chunks of at most `grain` items covering [0, count), blocks until all are done
+    template <typename Function>
+    static void         ParallelFor(size_t count, size_t grain, const Function &fn)
+    {
+        parallelFor(count, grain, &fn, &callChunk<Function>);
+    }
+private:
+    // the loop body behind a type-erased pointer
+    typedef void (*ChunkFunction)(const void *fn, size_t begin, size_t end);
+    template <typename Function>
+    static void callChunk(const void *fn, size_t begin, size_t end) { (*(const Function *)fn)(begin, end); }
+
+    static std::vector<std::thread> workers;
+    static std::mutex               mutex;
+    static std::condition_variable  wake;       // workers wait for a new loop
+    static std::condition_variable  done;       // the caller waits for the loop to drain
+    static std::atomic<bool>        busy;       // a loop is running
+    static std::atomic<size_t>      nextChunk;
+    static std::atomic<size_t>      remaining;  // chunks not finished yet
+    static const void        *job;
+    static ChunkFunction      jobFunction;
+    static size_t             jobCount;
+    static size_t             jobGrain;
+    static size_t             chunkCount;
+    static unsigned long long generation;       // bumped for every loop, wakes the workers
+    static unsigned int       activeWorkers;    // workers currently looking at the loop
+    static bool               stopping;
+    // private constructor, that is we do not want any actual job system objects
+    JobSystem() { }
+    static void parallelFor(size_t count, size_t grain, const void *fn, ChunkFunction function);
+    static void workerLoop(unsigned int index);
+    // pulls chunks of the current loop until none are left
+    static void runChunks();
+};
+
+#endif
@@ -0,0 +1,275 @@
+// LAKY'S LIGHT GRID v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_lightgrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LAKY_LIGHTGRID_SSE
+#include <emmintrin.h>
+#endif
+
+#include "../laky_jobs/laky_jobs.h"
+
+// lights binned per job
+static const size_t BIN_GRAIN = 1024;
+
+// signed distance of (a, b) to a boundary plane
+static inline float planeDistance(const glm::vec3 &plane, float a, float b)
+{
+    return plane.x * a + plane.y * b + plane.z;
+}
+
+// how many planes in a row, from `first` towards `last` (exclusive), the sphere lies completely on the
+// positive side of (negative side with sign = -1), stopping at the first one it doesn't
+static unsigned int leadingPlanes(const glm::vec3 *planes, int first, int last, int step, float a, float b, float radius, float sign)
+{
+    unsigned int count = 0;
+    for (int i = first; i != last; i += step)
+    {
+        if (!(planeDistance(planes[i], a, b) * sign > radius))
+            break;
+        count++;
+    }
+    return count;
+}
+
+#ifdef LAKY_LIGHTGRID_SSE
+static inline __m128 planeDistance(const glm::vec3 &plane, __m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), a), _mm_mul_ps(_mm_set1_ps(plane.y), b)), _mm_set1_ps(plane.z));
+}
+
+// leadingPlanes for four spheres, every lane stops counting on its own
+static __m128i leadingPlanes(const glm::vec3 *planes, int first, int last, int step, __m128 a, __m128 b, __m128 radius, __m128 sign)
+{
+    __m128i count = _mm_setzero_si128();
+    __m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = first; i != last; i += step)
+    {
+        active = _mm_and_ps(active, _mm_cmpgt_ps(_mm_mul_ps(planeDistance(planes[i], a, b), sign), radius));
+        if (_mm_movemask_ps(active) == 0)
+            break;
+        // active lanes are all ones, that is -1
+        count = _mm_sub_epi32(count, _mm_castps_si128(active));
+    }
+    return count;
+}
+#endif
+
+
+LightGrid::LightGrid()
+    : tanHalfX(1.0f), tanHalfY(1.0f), near(0.1f), far(100.0f), sliceScale(0.0f), sliceBias(0.0f), stats()
+{
+    clusters.resize(CLUSTER_COUNT);
+}
+
+void LightGrid::Build(const PointLight *lights, size_t count, const glm::mat4 &view, float fovY, float aspect, float near, float far)
+{
+    this->near = near;
+    this->far = far;
+    tanHalfY = std::tan(fovY * 0.5f);
+    tanHalfX = tanHalfY * aspect;
+
+    // column and row boundaries are planes through the eye, x / -z = t on the boundary
+    for (unsigned int i = 0; i <= CLUSTERS_X; i++)
+    {
+        float t = (2.0f * i / CLUSTERS_X - 1.0f) * tanHalfX;
+        float scale = 1.0f / std::sqrt(1.0f + t * t);
+        columnPlanes[i] = glm::vec3(scale, t * scale, 0.0f);
+    }
+    for (unsigned int i = 0; i <= CLUSTERS_Y; i++)
+    {
+        float t = (2.0f * i / CLUSTERS_Y - 1.0f) * tanHalfY;
+        float scale = 1.0f / std::sqrt(1.0f + t * t);
+        rowPlanes[i] = glm::vec3(scale, t * scale, 0.0f);
+    }
+    // slices grow exponentially with depth, so clusters stay roughly cube shaped
+    float logRatio = std::log(far / near);
+    for (unsigned int i = 0; i <= CLUSTERS_Z; i++)
+        slicePlanes[i] = glm::vec3(1.0f, 0.0f, -near * std::exp(logRatio * i / CLUSTERS_Z));
+    sliceScale = CLUSTERS_Z / logRatio;
+    sliceBias = -(float)CLUSTERS_Z * std::log(near) / logRatio;
+
+    stats = LightGridStats();
+    stats.lights = count;
+    // fresh from this frame's arena, last frame's arrays went with it
+    FrameVector<LightRange>(count).swap(ranges);
+    JobSystem::ParallelFor(count, BIN_GRAIN, [&](size_t begin, size_t end) {
+        bin(lights, begin, end, view);
+    });
+    FrameVector<LightRange>().swap(visibleRanges);
+    visibleRanges.reserve(count);
+    for (const LightRange &range : ranges)
+    {
+        if (range.visible)
+            visibleRanges.push_back(range);
+    }
+    stats.visibleLights = visibleRanges.size();
+
+    // every depth slice counts its own clusters' lights
+    const unsigned int sliceClusters = CLUSTERS_X * CLUSTERS_Y;
+    JobSystem::ParallelFor(CLUSTERS_Z, 1, [&](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; z++)
+        {
+            LightCluster *slice = &clusters[z * sliceClusters];
+            for (unsigned int i = 0; i < sliceClusters; i++)
+                slice[i].count = 0;
+            for (const LightRange &range : visibleRanges)
+            {
+                if (z < range.minZ || z > range.maxZ)
+                    continue;
+                for (unsigned int y = range.minY; y <= range.maxY; y++)
+                {
+                    for (unsigned int x = range.minX; x <= range.maxX; x++)
+                        slice[y * CLUSTERS_X + x].count++;
+                }
+            }
+        }
+    });
+
+    // the lists are stored back to back in cluster order
+    uint32_t offset = 0;
+    for (LightCluster &cluster : clusters)
+    {
+        cluster.offset = offset;
+        offset += cluster.count;
+        stats.maxClusterLights = std::max(stats.maxClusterLights, (size_t)cluster.count);
+    }
+    indices.resize(offset);
+    stats.indexCount = offset;
+
+    // and fills them, in light order
+    JobSystem::ParallelFor(CLUSTERS_Z, 1, [&](size_t begin, size_t end) {
+        uint32_t cursor[CLUSTERS_X * CLUSTERS_Y];
+        for (size_t z = begin; z < end; z++)
+        {
+            const LightCluster *slice = &clusters[z * sliceClusters];
+            for (unsigned int i = 0; i < sliceClusters; i++)
+                cursor[i] = slice[i].offset;
+            for (const LightRange &range : visibleRanges)
+            {
+                if (z < range.minZ || z > range.maxZ)
+                    continue;
+                for (unsigned int y = range.minY; y <= range.maxY; y++)
+                {
+                    for (unsigned int x = range.minX; x <= range.maxX; x++)
+                        indices[cursor[y * CLUSTERS_X + x]++] = range.light;
+                }
+            }
+        }
+    });
+}
+
+int LightGrid::ClusterOf(const glm::vec3 &viewPosition) const
+{
+    float depth = -viewPosition.z;
+    if (!(depth >= near && depth <= far))
+        return -1;
+    float ndcX = viewPosition.x / (depth * tanHalfX);
+    float ndcY = viewPosition.y / (depth * tanHalfY);
+    if (!(ndcX >= -1.0f && ndcX <= 1.0f && ndcY >= -1.0f && ndcY <= 1.0f))
+        return -1;
+
+    int x = std::min((int)((ndcX * 0.5f + 0.5f) * CLUSTERS_X), (int)CLUSTERS_X - 1);
+    int y = std::min((int)((ndcY * 0.5f + 0.5f) * CLUSTERS_Y), (int)CLUSTERS_Y - 1);
+    int z = (int)std::floor(std::log(depth) * sliceScale + sliceBias);
+    z = std::max(0, std::min(z, (int)CLUSTERS_Z - 1));
+    return (z * CLUSTERS_Y + y) * CLUSTERS_X + x;
+}
+
+
+void LightGrid::bin(const PointLight *lights, size_t begin, size_t end, const glm::mat4 &view)
+{
+    size_t i = begin;
+#ifdef LAKY_LIGHTGRID_SSE
+    // view matrix entries broadcast, so four positions go to view space at once
+    __m128 m[4][3];
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 3; row++)
+            m[column][row] = _mm_set1_ps(view[column][row]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 positive = _mm_set1_ps(1.0f);
+    const __m128 negative = _mm_set1_ps(-1.0f);
+
+    for (; i + 4 <= end; i += 4)
+    {
+        const PointLight *group = lights + i;
+        __m128 px = _mm_setr_ps(group[0].positionRadius.x, group[1].positionRadius.x, group[2].positionRadius.x, group[3].positionRadius.x);
+        __m128 py = _mm_setr_ps(group[0].positionRadius.y, group[1].positionRadius.y, group[2].positionRadius.y, group[3].positionRadius.y);
+        __m128 pz = _mm_setr_ps(group[0].positionRadius.z, group[1].positionRadius.z, group[2].positionRadius.z, group[3].positionRadius.z);
+        __m128 radius = _mm_setr_ps(group[0].positionRadius.w, group[1].positionRadius.w, group[2].positionRadius.w, group[3].positionRadius.w);
+        __m128 negativeRadius = _mm_sub_ps(zero, radius);
+        __m128 vx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][0], px), _mm_mul_ps(m[1][0], py)), _mm_add_ps(_mm_mul_ps(m[2][0], pz), m[3][0]));
+        __m128 vy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][1], px), _mm_mul_ps(m[1][1], py)), _mm_add_ps(_mm_mul_ps(m[2][1], pz), m[3][1]));
+        __m128 vz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][2], px), _mm_mul_ps(m[1][2], py)), _mm_add_ps(_mm_mul_ps(m[2][2], pz), m[3][2]));
+        __m128 depth = _mm_sub_ps(zero, vz);
+
+        // completely outside one of the frustum planes means outside of every cluster
+        __m128 visible = _mm_and_ps(_mm_cmpge_ps(planeDistance(columnPlanes[0], vx, vz), negativeRadius),
+                                    _mm_cmple_ps(planeDistance(columnPlanes[CLUSTERS_X], vx, vz), radius));
+        visible = _mm_and_ps(visible, _mm_and_ps(_mm_cmpge_ps(planeDistance(rowPlanes[0], vy, vz), negativeRadius),
+                                                 _mm_cmple_ps(planeDistance(rowPlanes[CLUSTERS_Y], vy, vz), radius)));
+        visible = _mm_and_ps(visible, _mm_and_ps(_mm_cmpge_ps(planeDistance(slicePlanes[0], depth, zero), negativeRadius),
+                                                 _mm_cmple_ps(planeDistance(slicePlanes[CLUSTERS_Z], depth, zero), radius)));
+        int visibleMask = _mm_movemask_ps(visible);
+        if (visibleMask == 0)
+        {
+            for (int lane = 0; lane < 4; lane++)
+                ranges[i + lane].visible = false;
+            continue;
+        }
+
+        // the block of clusters is what is left after skipping the boundaries the sphere is entirely beyond, from both ends
+        alignas(16) int32_t skipped[6][4];
+        _mm_store_si128((__m128i *)skipped[0], leadingPlanes(columnPlanes, 1, CLUSTERS_X, 1, vx, vz, radius, positive));
+        _mm_store_si128((__m128i *)skipped[1], leadingPlanes(columnPlanes, CLUSTERS_X - 1, 0, -1, vx, vz, radius, negative));
+        _mm_store_si128((__m128i *)skipped[2], leadingPlanes(rowPlanes, 1, CLUSTERS_Y, 1, vy, vz, radius, positive));
+        _mm_store_si128((__m128i *)skipped[3], leadingPlanes(rowPlanes, CLUSTERS_Y - 1, 0, -1, vy, vz, radius, negative));
+        _mm_store_si128((__m128i *)skipped[4], leadingPlanes(slicePlanes, 1, CLUSTERS_Z, 1, depth, zero, radius, positive));
+        _mm_store_si128((__m128i *)skipped[5], leadingPlanes(slicePlanes, CLUSTERS_Z - 1, 0, -1, depth, zero, radius, negative));
+        for (int lane = 0; lane < 4; lane++)
+        {
+            LightRange &range = ranges[i + lane];
+            range.light = (uint32_t)(i + lane);
+            range.minX = (uint8_t)skipped[0][lane];
+            range.maxX = (uint8_t)(CLUSTERS_X - 1 - skipped[1][lane]);
+            range.minY = (uint8_t)skipped[2][lane];
+            range.maxY = (uint8_t)(CLUSTERS_Y - 1 - skipped[3][lane]);
+            range.minZ = (uint8_t)skipped[4][lane];
+            range.maxZ = (uint8_t)(CLUSTERS_Z - 1 - skipped[5][lane]);
+            range.visible = (visibleMask >> lane & 1) && range.minX <= range.maxX && range.minY <= range.maxY && range.minZ <= range.maxZ;
+        }
+    }
+#endif
+    for (; i < end; i++)
+        binOne(lights[i], (uint32_t)i, view);
+}
+
+void LightGrid::binOne(const PointLight &light, uint32_t index, const glm::mat4 &view)
+{
+    LightRange &range = ranges[index];
+    range.light = index;
+    glm::vec3 position = glm::vec3(view * glm::vec4(glm::vec3(light.positionRadius), 1.0f));
+    float radius = light.positionRadius.w;
+    float depth = -position.z;
+
+    range.visible = planeDistance(columnPlanes[0], position.x, position.z) >= -radius && planeDistance(columnPlanes[CLUSTERS_X], position.x, position.z) <= radius
+                 && planeDistance(rowPlanes[0], position.y, position.z) >= -radius && planeDistance(rowPlanes[CLUSTERS_Y], position.y, position.z) <= radius
+                 && planeDistance(slicePlanes[0], depth, 0.0f) >= -radius && planeDistance(slicePlanes[CLUSTERS_Z], depth, 0.0f) <= radius;
+    if (!range.visible)
+        return;
+
+    range.minX = (uint8_t)leadingPlanes(columnPlanes, 1, CLUSTERS_X, 1, position.x, position.z, radius, 1.0f);
+    range.maxX = (uint8_t)(CLUSTERS_X - 1 - leadingPlanes(columnPlanes, CLUSTERS_X - 1, 0, -1, position.x, position.z, radius, -1.0f));
+    range.minY = (uint8_t)leadingPlanes(rowPlanes, 1, CLUSTERS_Y, 1, position.y, position.z, radius, 1.0f);
+    range.maxY = (uint8_t)(CLUSTERS_Y - 1 - leadingPlanes(rowPlanes, CLUSTERS_Y - 1, 0, -1, position.y, position.z, radius, -1.0f));
+    range.minZ = (uint8_t)leadingPlanes(slicePlanes, 1, CLUSTERS_Z, 1, depth, 0.0f, radius, 1.0f);
+    range.maxZ = (uint8_t)(CLUSTERS_Z - 1 - leadingPlanes(slicePlanes, CLUSTERS_Z - 1, 0, -1, depth, 0.0f, radius, -1.0f));
+    range.visible = range.minX <= range.maxX && range.minY <= range.maxY && range.minZ <= range.maxZ;
+}
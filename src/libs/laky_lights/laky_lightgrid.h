@@ -0,0 +1,96 @@
+#ifndef LIGHT_GRID_H
+#define LIGHT_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../laky_memory/laky_framearena.h"
+
+
+// std430 layout of one entry of the ClusterLights buffer (see include/clustered_lights.glsl)
+struct PointLight
+{
+    glm::vec4 positionRadius; // world position, w = range (the light fades out to nothing there)
+    glm::vec4 color;          // rgb diffuse and specular color, w unused
+};
+
+// one cluster's range of the light index list
+struct LightCluster
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+// counts of the last LightGrid::Build
+struct LightGridStats
+{
+    size_t lights;           // lights handed to Build
+    size_t visibleLights;    // lights touching at least one cluster
+    size_t indexCount;       // light references over all clusters
+    size_t maxClusterLights; // most lights in a single cluster
+};
+
+// LightGrid splits the view frustum into clusters (screen tiles times
+// exponentially growing depth slices) and lists the point lights that may
+// reach each of them, so a fragment only has to loop over the lights of
+// its own cluster. Binning is CPU-only: every light's sphere is tested
+// against the planes between the cluster columns, rows and slices (SSE,
+// four lights at a time), which yields the inclusive block of clusters it
+// touches; the per-cluster lists are then counted and filled one depth
+// slice per job on the JobSystem. The lists are conservative, a light may
+// show up in a corner cluster of its block that its sphere misses.
+class LightGrid
+{
+public:
+    static const unsigned int CLUSTERS_X = 16;
+    static const unsigned int CLUSTERS_Y = 9;
+    static const unsigned int CLUSTERS_Z = 24;
+    static const unsigned int CLUSTER_COUNT = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+
+    LightGrid();
+    // bins the lights for a perspective view (fovY in radians), clusters are indexed (z * CLUSTERS_Y + y) * CLUSTERS_X + x, rows bottom to top
+    void Build(const PointLight *lights, size_t count, const glm::mat4 &view, float fovY, float aspect, float near, float far);
+    // cluster of a view-space position, the same one the shader picks for a fragment there, -1 outside the frustum
+    int  ClusterOf(const glm::vec3 &viewPosition) const;
+
+    // depth slice of a view-space distance d is floor(log(d) * SliceScale() + SliceBias())
+    float SliceScale() const { return sliceScale; }
+    float SliceBias() const { return sliceBias; }
+    const std::vector<LightCluster> &Clusters() const { return clusters; }
+    // light indices (positions in the array given to Build), grouped by cluster
+    const std::vector<uint32_t>     &Indices() const { return indices; }
+    const LightGridStats            &Stats() const { return stats; }
+private:
+    // inclusive block of clusters a light's sphere touches
+    struct LightRange
+    {
+        uint32_t light;
+        uint8_t  minX, maxX, minY, maxY, minZ, maxZ;
+        bool     visible;
+    };
+
+    // boundaries between the clusters as planes a * x + b * y + c, where (x, y) is (view x, view z) for
+    // columns, (view y, view z) for rows and (depth, 0) for slices. Positive on the far/right/top side
+    glm::vec3 columnPlanes[CLUSTERS_X + 1];
+    glm::vec3 rowPlanes[CLUSTERS_Y + 1];
+    glm::vec3 slicePlanes[CLUSTERS_Z + 1];
+    float     tanHalfX, tanHalfY;
+    float     near, far;
+    float     sliceScale, sliceBias;
+
+    FrameVector<LightRange>   ranges;        // one per light, filled in parallel (only valid during Build)
+    FrameVector<LightRange>   visibleRanges; // the visible ones, in light order (only valid during Build)
+    std::vector<LightCluster> clusters;
+    std::vector<uint32_t>     indices;
+    LightGridStats            stats;
+
+    // works out the cluster blocks of lights [begin, end)
+    void bin(const PointLight *lights, size_t begin, size_t end, const glm::mat4 &view);
+    // one light at a time, for the tail of a chunk (or everything without SSE)
+    void binOne(const PointLight &light, uint32_t index, const glm::mat4 &view);
+};
+
+#endif
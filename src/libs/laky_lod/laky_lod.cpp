@@ -0,0 +1,482 @@
+// LAKY'S LOD v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_lod.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include "../laky_jobs/laky_jobs.h"
+
+// a level that keeps more than this much of the previous one's triangles ends the chain
+static const float MIN_REDUCTION = 0.9f;
+// so does one whose error exceeds this fraction of the mesh's bounding radius: with the seams and borders locked, the
+// last collapses only make slivers, and such a level would be picked where the whole object is a few pixels anyway
+static const float MAX_ERROR_RADIUS = 0.1f;
+
+// symmetric 4x4 error quadric (upper triangle), area weighted sum of squared distances to a set of planes
+struct Quadric
+{
+    double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+    double weight; // total area, the error is divided by it to come out in squared model units
+
+    void AddPlane(const glm::vec3 &normal, float d, float weight)
+    {
+        double x = normal.x, y = normal.y, z = normal.z, w = d;
+        a00 += weight * x * x; a01 += weight * x * y; a02 += weight * x * z; a03 += weight * x * w;
+        a11 += weight * y * y; a12 += weight * y * z; a13 += weight * y * w;
+        a22 += weight * z * z; a23 += weight * z * w;
+        a33 += weight * w * w;
+        this->weight += weight;
+    }
+    void Add(const Quadric &q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03; a11 += q.a11;
+        a12 += q.a12; a13 += q.a13; a22 += q.a22; a23 += q.a23; a33 += q.a33;
+        weight += q.weight;
+    }
+    // mean squared distance of p to the planes of both quadrics, the cost of moving the vertices that gathered them to p
+    static double Error(const Quadric &q, const Quadric &r, const glm::vec3 &p)
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double e = (q.a00 + r.a00) * x * x + (q.a11 + r.a11) * y * y + (q.a22 + r.a22) * z * z + (q.a33 + r.a33)
+                 + 2.0 * ((q.a01 + r.a01) * x * y + (q.a02 + r.a02) * x * z + (q.a03 + r.a03) * x
+                        + (q.a12 + r.a12) * y * z + (q.a13 + r.a13) * y + (q.a23 + r.a23) * z);
+        double weight = q.weight + r.weight;
+        return e > 0.0 && weight > 0.0 ? e / weight : 0.0;
+    }
+};
+
+// vertex `from` moves onto vertex `to`
+struct Collapse
+{
+    unsigned int from, to;
+    double       error;
+    unsigned int version; // of `from` when queued, the entry is outdated once the vertex's neighborhood changed
+};
+
+// orders the priority queue cheapest first
+struct CheaperCollapse
+{
+    bool operator()(const Collapse &a, const Collapse &b) const { return a.error > b.error; }
+};
+
+// exact position match, vertices duplicated for their normals or UVs weld together
+struct PositionHash
+{
+    size_t operator()(const glm::vec3 &p) const
+    {
+        unsigned int bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+static inline unsigned long long edgeKey(unsigned int a, unsigned int b)
+{
+    return a < b ? ((unsigned long long)a << 32) | b : ((unsigned long long)b << 32) | a;
+}
+
+// collapsing would turn one of the triangles around `from` over (or squash it flat)
+static bool flipsTriangle(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, const unsigned int *triangles,
+                          unsigned int triangleCount, unsigned int from, unsigned int to)
+{
+    for (unsigned int t = 0; t < triangleCount; t++)
+    {
+        const unsigned int *triangle = &indices[triangles[t] * 3];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+            continue; // goes away with the collapse
+        glm::vec3 before[3], after[3];
+        for (int k = 0; k < 3; k++)
+        {
+            before[k] = positions[triangle[k]];
+            after[k] = triangle[k] == from ? positions[to] : before[k];
+        }
+        glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+        glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+        if (glm::dot(normalBefore, normalAfter) <= 0.0f)
+            return true;
+    }
+    return false;
+}
+
+// the cheapest collapse of `from` onto a neighbor that stays under maxError and turns no triangle over, false if there is none
+static bool cheapestCollapse(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, const std::vector<unsigned int> &positionId,
+                             const std::vector<bool> &locked, const std::vector<Quadric> &quadrics, const std::vector<bool> &removed,
+                             std::vector<std::vector<unsigned int>> &vertexTriangles, unsigned int from, double maxError, Collapse &collapse)
+{
+    if (locked[positionId[from]])
+        return false;
+    std::vector<unsigned int> &triangles = vertexTriangles[from];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [&](unsigned int t) { return removed[t]; }), triangles.end());
+
+    // a vertex that may move is inside the surface, so each neighbor follows it in exactly one of its triangles
+    bool found = false;
+    for (unsigned int t : triangles)
+        for (int k = 0; k < 3; k++)
+        {
+            if (indices[t * 3 + k] != from)
+                continue;
+            unsigned int to = indices[t * 3 + (k + 1) % 3];
+            double error = Quadric::Error(quadrics[positionId[from]], quadrics[positionId[to]], positions[to]);
+            if (error > maxError || (found && error >= collapse.error))
+                continue;
+            if (flipsTriangle(positions, indices, triangles.data(), (unsigned int)triangles.size(), from, to))
+                continue;
+            collapse = Collapse{ from, to, error, 0 };
+            found = true;
+        }
+    return found;
+}
+
+// distance from p to triangle abc
+static float pointTriangleDistance(const glm::vec3 &p, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    glm::vec3 ab = b - a, ac = c - a, normal = glm::cross(ab, ac);
+    float area = glm::dot(normal, normal);
+    if (area > 0.0f)
+    {
+        // inside the prism over the triangle the plane distance is the answer
+        glm::vec3 ap = p - a;
+        float u = glm::dot(glm::cross(ap, ac), normal) / area, v = glm::dot(glm::cross(ab, ap), normal) / area;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f)
+            return std::fabs(glm::dot(ap, normal)) / std::sqrt(area);
+    }
+    // otherwise the nearest point is on an edge
+    const glm::vec3 *corners[3] = { &a, &b, &c };
+    float best = FLT_MAX;
+    for (int k = 0; k < 3; k++)
+    {
+        const glm::vec3 &from = *corners[k], &to = *corners[(k + 1) % 3];
+        glm::vec3 edge = to - from;
+        float length2 = glm::dot(edge, edge);
+        float t = length2 > 0.0f ? glm::clamp(glm::dot(p - from, edge) / length2, 0.0f, 1.0f) : 0.0f;
+        best = std::min(best, glm::length(p - (from + edge * t)));
+    }
+    return best;
+}
+
+// largest distance of a removed vertex to the triangles within two rings of the vertex it ended up on; the whole surface can
+// only be nearer than those. collapsedTo must be resolved (every entry a vertex that is still there)
+static float measureError(const std::vector<glm::vec3> &positions, const std::vector<bool> &used, const std::vector<unsigned int> &positionId,
+                          size_t positionCount, const std::vector<unsigned int> &collapsedTo, const std::vector<unsigned int> &result)
+{
+    size_t vertexCount = positions.size();
+    std::vector<unsigned int> positionStart(positionCount + 1, 0), positionTriangles(result.size());
+    for (unsigned int index : result)
+        positionStart[positionId[index] + 1]++;
+    for (size_t p = 0; p < positionCount; p++)
+        positionStart[p + 1] += positionStart[p];
+    std::vector<unsigned int> fill(positionStart.begin(), positionStart.end() - 1);
+    for (size_t i = 0; i < result.size(); i++)
+        positionTriangles[fill[positionId[result[i]]]++] = (unsigned int)(i / 3);
+
+    // the last vertex each position and triangle was looked at for, so shared ones are measured once
+    std::vector<unsigned int> ringVisit(positionCount, ~0u), triangleVisit(result.size() / 3, ~0u);
+    float reachedError = 0.0f;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        if (!used[v] || collapsedTo[v] == v)
+            continue;
+        unsigned int position = positionId[collapsedTo[v]];
+        float nearest = FLT_MAX;
+        for (unsigned int t = positionStart[position]; t < positionStart[position + 1]; t++)
+        {
+            unsigned int triangle = positionTriangles[t];
+            triangleVisit[triangle] = (unsigned int)v;
+            const unsigned int *corners = &result[triangle * 3];
+            nearest = std::min(nearest, pointTriangleDistance(positions[v], positions[corners[0]], positions[corners[1]], positions[corners[2]]));
+        }
+        // the second ring can only bring the vertex nearer, it matters only if the first one leaves it the farthest so far
+        if (nearest > reachedError)
+        {
+            ringVisit[position] = (unsigned int)v;
+            for (unsigned int t = positionStart[position]; t < positionStart[position + 1]; t++)
+            {
+                const unsigned int *triangle = &result[positionTriangles[t] * 3];
+                for (int k = 0; k < 3; k++)
+                {
+                    unsigned int ring = positionId[triangle[k]];
+                    if (ringVisit[ring] == v)
+                        continue;
+                    ringVisit[ring] = (unsigned int)v;
+                    for (unsigned int r = positionStart[ring]; r < positionStart[ring + 1]; r++)
+                    {
+                        unsigned int nearTriangle = positionTriangles[r];
+                        if (triangleVisit[nearTriangle] == v)
+                            continue;
+                        triangleVisit[nearTriangle] = (unsigned int)v;
+                        const unsigned int *near = &result[nearTriangle * 3];
+                        nearest = std::min(nearest, pointTriangleDistance(positions[v], positions[near[0]], positions[near[1]], positions[near[2]]));
+                    }
+                }
+            }
+        }
+        // the vertex it moved onto lost all its triangles, fall back to the distance it moved
+        if (nearest == FLT_MAX)
+            nearest = glm::length(positions[v] - positions[collapsedTo[v]]);
+        reachedError = std::max(reachedError, nearest);
+    }
+    return reachedError;
+}
+
+// one collapse sequence for all target sizes (descending), each result is taken when the mesh gets down to its target, or
+// where collapsing stops; the greedy order doesn't depend on the target, so each comes out as if simplified on its own
+static void simplify(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, const size_t *targetIndexCounts,
+                     size_t targetCount, float maxError, std::vector<unsigned int> *results, float *errors)
+{
+    size_t vertexCount = positions.size();
+    std::vector<unsigned int> mesh = indices;
+
+    // weld by position, the quadrics and the topology live on positions
+    std::vector<unsigned int> positionId(vertexCount);
+    std::vector<unsigned int> copies;
+    std::unordered_map<glm::vec3, unsigned int, PositionHash> welded;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        auto inserted = welded.insert(std::make_pair(positions[v], (unsigned int)copies.size()));
+        if (inserted.second)
+            copies.push_back(0);
+        positionId[v] = inserted.first->second;
+        copies[positionId[v]]++;
+    }
+    // seams (a position shared by several vertices) and open borders (an edge only one triangle uses) stay put
+    std::vector<bool> locked(copies.size());
+    for (size_t p = 0; p < copies.size(); p++)
+        locked[p] = copies[p] > 1;
+    std::vector<unsigned long long> edges;
+    edges.reserve(mesh.size());
+    for (size_t i = 0; i < mesh.size(); i += 3)
+        for (int k = 0; k < 3; k++)
+            edges.push_back(edgeKey(positionId[mesh[i + k]], positionId[mesh[i + (k + 1) % 3]]));
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size(); i++)
+        if ((i == 0 || edges[i - 1] != edges[i]) && (i + 1 == edges.size() || edges[i + 1] != edges[i]))
+            locked[edges[i] >> 32] = locked[edges[i] & 0xffffffffu] = true;
+
+    // every triangle's plane, weighted by its area, goes to its corners
+    std::vector<Quadric> quadrics(copies.size(), Quadric{});
+    for (size_t i = 0; i < mesh.size(); i += 3)
+    {
+        const glm::vec3 &p0 = positions[mesh[i]], &p1 = positions[mesh[i + 1]], &p2 = positions[mesh[i + 2]];
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float doubleArea = glm::length(normal);
+        if (doubleArea <= 0.0f)
+            continue;
+        normal /= doubleArea;
+        for (int k = 0; k < 3; k++)
+            quadrics[positionId[mesh[i + k]]].AddPlane(normal, -glm::dot(normal, p0), doubleArea * 0.5f);
+    }
+
+    // triangles around every vertex; one that collapsed away stays listed and is dropped from a list once it is walked
+    size_t triangleCount = mesh.size() / 3;
+    std::vector<std::vector<unsigned int>> vertexTriangles(vertexCount);
+    std::vector<bool> used(vertexCount, false);
+    for (size_t i = 0; i < mesh.size(); i++)
+    {
+        vertexTriangles[mesh[i]].push_back((unsigned int)(i / 3));
+        used[mesh[i]] = true;
+    }
+    std::vector<bool> removed(triangleCount, false);
+    std::vector<unsigned int> collapsedTo(vertexCount), version(vertexCount, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+        collapsedTo[v] = (unsigned int)v;
+
+    // every vertex queues its cheapest collapse; a collapse requeues the vertices around it, which outdates their older entries
+    double maxQuadricError = (double)maxError * maxError;
+    std::priority_queue<Collapse, std::vector<Collapse>, CheaperCollapse> queue;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        Collapse collapse;
+        if (cheapestCollapse(positions, mesh, positionId, locked, quadrics, removed, vertexTriangles, (unsigned int)v, maxQuadricError, collapse))
+            queue.push(collapse);
+    }
+    size_t liveTriangles = triangleCount, level = 0;
+    std::vector<unsigned int> ring;
+    while (level < targetCount)
+    {
+        bool reached = liveTriangles * 3 <= targetIndexCounts[level];
+        if (reached || queue.empty())
+        {
+            // keep the surviving triangles in their original order, and resolve chains of collapses
+            std::vector<unsigned int> &result = results[level];
+            result.clear();
+            for (size_t t = 0; t < triangleCount; t++)
+                if (!removed[t])
+                    result.insert(result.end(), &mesh[t * 3], &mesh[t * 3] + 3);
+            for (size_t v = 0; v < vertexCount; v++)
+                while (collapsedTo[collapsedTo[v]] != collapsedTo[v])
+                    collapsedTo[v] = collapsedTo[collapsedTo[v]];
+            errors[level] = measureError(positions, used, positionId, copies.size(), collapsedTo, result);
+            level++;
+            continue;
+        }
+
+        Collapse collapse = queue.top();
+        queue.pop();
+        unsigned int from = collapse.from, to = collapse.to;
+        if (collapse.version != version[from] || collapsedTo[from] != from || collapsedTo[to] != to)
+            continue;
+
+        collapsedTo[from] = to;
+        quadrics[positionId[to]].Add(quadrics[positionId[from]]);
+        for (unsigned int t : vertexTriangles[from])
+        {
+            if (removed[t])
+                continue;
+            unsigned int *triangle = &mesh[t * 3];
+            for (int k = 0; k < 3; k++)
+                if (triangle[k] == from)
+                    triangle[k] = to;
+            // the triangles along the collapsed edge lose a corner
+            if (positionId[triangle[0]] == positionId[triangle[1]] || positionId[triangle[1]] == positionId[triangle[2]] ||
+                positionId[triangle[0]] == positionId[triangle[2]])
+            {
+                removed[t] = true;
+                liveTriangles--;
+            }
+            else
+                vertexTriangles[to].push_back(t);
+        }
+        std::vector<unsigned int>().swap(vertexTriangles[from]);
+
+        // `to` gathered new planes and its neighbors' triangles moved, so their cheapest collapses change
+        ring.clear();
+        for (unsigned int t : vertexTriangles[to])
+            if (!removed[t])
+                ring.insert(ring.end(), &mesh[t * 3], &mesh[t * 3] + 3);
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+        for (unsigned int v : ring)
+        {
+            version[v]++;
+            Collapse next;
+            if (cheapestCollapse(positions, mesh, positionId, locked, quadrics, removed, vertexTriangles, v, maxQuadricError, next))
+            {
+                next.version = version[v];
+                queue.push(next);
+            }
+        }
+    }
+}
+
+float SimplifyMesh(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, size_t targetIndexCount, float maxError,
+                   std::vector<unsigned int> &result)
+{
+    float error = 0.0f;
+    simplify(positions, indices, &targetIndexCount, 1, maxError, &result, &error);
+    return error;
+}
+
+void GenerateLods(const LodSource *meshes, size_t meshCount, unsigned int maxLevels, float ratio, std::vector<MeshLod> *chains)
+{
+    JobSystem::ParallelFor(meshCount, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; m++)
+        {
+            const std::vector<unsigned int> &indices = *meshes[m].indices;
+            std::vector<MeshLod> &chain = chains[m];
+            chain.clear();
+            chain.push_back(MeshLod{ indices, 0.0f });
+            if (maxLevels < 2)
+                continue;
+
+            const std::vector<glm::vec3> &positions = *meshes[m].positions;
+            glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+            for (unsigned int index : indices)
+            {
+                low = glm::min(low, positions[index]);
+                high = glm::max(high, positions[index]);
+            }
+            glm::vec3 center = (low + high) * 0.5f;
+            float radius = 0.0f;
+            for (unsigned int index : indices)
+                radius = std::max(radius, glm::length(positions[index] - center));
+            // the quadric error never exceeds the largest deviation, so collapses above the limit can't make a usable level
+            float maxError = radius * MAX_ERROR_RADIUS;
+
+            // all levels come out of one simplification of the full-detail mesh
+            std::vector<size_t> targets(maxLevels - 1);
+            std::vector<std::vector<unsigned int>> levels(maxLevels - 1);
+            std::vector<float> errors(maxLevels - 1);
+            float keep = 1.0f;
+            for (unsigned int level = 1; level < maxLevels; level++)
+            {
+                keep *= ratio;
+                targets[level - 1] = (size_t)(indices.size() / 3 * keep) * 3;
+            }
+            simplify(positions, indices, targets.data(), targets.size(), maxError, levels.data(), errors.data());
+
+            for (unsigned int level = 1; level < maxLevels; level++)
+            {
+                MeshLod lod;
+                lod.indices = std::move(levels[level - 1]);
+                if (lod.indices.empty() || lod.indices.size() > chain.back().indices.size() * MIN_REDUCTION || errors[level - 1] > maxError)
+                    break;
+                // levels never get more accurate further down the chain
+                lod.error = std::max(errors[level - 1], chain.back().error);
+                chain.push_back(std::move(lod));
+            }
+        }
+    });
+}
+
+
+LodSelector::LodSelector(float pixelError, float hysteresis, unsigned int fadeFrames)
+    : pixelError(pixelError), hysteresis(hysteresis), fadeFrames(fadeFrames), cameraPosition(0.0f), pixelsPerUnit(1.0f)
+{
+}
+
+void LodSelector::SetView(const glm::vec3 &cameraPosition, float fovY, float viewportHeight)
+{
+    this->cameraPosition = cameraPosition;
+    pixelsPerUnit = viewportHeight / (2.0f * std::tan(glm::radians(fovY) * 0.5f));
+}
+
+LodChoice LodSelector::Select(unsigned int object, const float *errors, unsigned int levelCount, const glm::vec3 &center, float radius, float scale)
+{
+    if (object >= objects.size())
+        objects.resize(object + 1, ObjectState{ 0, -1, 0.0f });
+    ObjectState &state = objects[object];
+    if (state.level >= levelCount)
+        state = ObjectState{ 0, -1, 0.0f };
+
+    // the nearest point of the bounds decides, inside them everything is full detail
+    float distance = glm::length(center - cameraPosition) - radius;
+    unsigned int level = 0;
+    if (distance > 0.0f)
+    {
+        for (unsigned int i = levelCount; i-- > 1;)
+        {
+            // a coarser level than the current one has to clear the threshold by the hysteresis margin
+            float limit = i > state.level ? pixelError * (1.0f - hysteresis) : pixelError;
+            if (ProjectedPixels(errors[i] * scale, distance) <= limit)
+            {
+                level = i;
+                break;
+            }
+        }
+    }
+
+    if (level != state.level)
+    {
+        // a change during a fade restarts it from the level on screen
+        state.fadingLevel = fadeFrames > 0 ? (int)state.level : -1;
+        state.level = level;
+        state.fade = 0.0f;
+    }
+    if (state.fadingLevel >= 0)
+    {
+        state.fade += 1.0f / (fadeFrames > 0 ? fadeFrames : 1);
+        if (state.fade >= 1.0f)
+        {
+            state.fadingLevel = -1;
+            state.fade = 0.0f;
+        }
+    }
+    return LodChoice{ state.level, state.fadingLevel, state.fade };
+}
@@ -0,0 +1,84 @@
+#ifndef LOD_H
+#define LOD_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+
+// one level of detail of a mesh, indexing the full-detail mesh's vertices
+struct MeshLod
+{
+    std::vector<unsigned int> indices;
+    float error; // farthest a full-detail vertex ended up from this level's surface, in model units (0 for level 0)
+};
+
+// a mesh handed to GenerateLods
+struct LodSource
+{
+    const std::vector<glm::vec3>    *positions;
+    const std::vector<unsigned int> *indices;
+};
+
+// Simplifies an indexed triangle mesh with quadric error metric edge
+// collapses (Garland and Heckbert), moving a vertex onto a neighbor so the
+// result keeps indexing the original vertices and their attributes. Runs
+// in passes of independent collapses taken cheapest first, until at most
+// targetIndexCount indices are left or the next collapse's quadric error
+// (a root mean square distance) exceeds maxError. Vertices on open borders
+// and on attribute seams (several vertices at one position) never move,
+// so the outline and the UV layout survive. Returns the largest distance
+// of a removed vertex to the triangles within two rings of the one it
+// collapsed onto, so no vertex is farther than that from the result.
+float SimplifyMesh(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, size_t targetIndexCount, float maxError,
+                   std::vector<unsigned int> &result);
+
+// builds the LOD chain of every mesh, one mesh per job on the JobSystem. Level 0 is the mesh itself, level i keeps about
+// ratio^i of its triangles (simplified from the full-detail mesh, so the errors are measured against it); a chain ends
+// after maxLevels, once simplification stops paying off or once a level's error exceeds a tenth of the mesh's bounding radius
+void GenerateLods(const LodSource *meshes, size_t meshCount, unsigned int maxLevels, float ratio, std::vector<MeshLod> *chains);
+
+// what to draw for one object this frame
+struct LodChoice
+{
+    unsigned int level;       // level to draw
+    int          fadingLevel; // level being faded out, -1 = none
+    float        fade;        // cross-fade progress in (0, 1): `level` is drawn dithered in with +fade, `fadingLevel` out with -fade
+};
+
+// LodSelector picks a level per object from the screen size of its levels'
+// errors: the coarsest level whose error covers at most `pixelError`
+// pixels. Going coarser needs the error to drop below (1 - hysteresis) of
+// that, so an object sitting at a switching distance doesn't flicker
+// between two levels. A change can cross-fade over a few frames, drawing
+// both levels with complementary dither patterns (see lod_fade.glsl).
+class LodSelector
+{
+public:
+    LodSelector(float pixelError, float hysteresis, unsigned int fadeFrames);
+    // camera for the next Select calls, fovY in degrees (Camera::Zoom) and the viewport height in pixels
+    void SetView(const glm::vec3 &cameraPosition, float fovY, float viewportHeight);
+    // 0 pops straight to the new level
+    void SetFadeFrames(unsigned int frames) { fadeFrames = frames; }
+    // picks the level of an object (call once per object and frame, it advances the cross-fade) from its levels'
+    // errors in model units, its world bounding sphere and the model's scale
+    LodChoice Select(unsigned int object, const float *errors, unsigned int levelCount, const glm::vec3 &center, float radius, float scale);
+    // pixels covered by a world-space length at a distance from the camera
+    float ProjectedPixels(float size, float distance) const { return size * pixelsPerUnit / (distance > 1e-3f ? distance : 1e-3f); }
+private:
+    struct ObjectState
+    {
+        unsigned int level;
+        int          fadingLevel;
+        float        fade;
+    };
+    float        pixelError;
+    float        hysteresis;
+    unsigned int fadeFrames;
+    glm::vec3    cameraPosition;
+    float        pixelsPerUnit; // screen pixels covered by one unit at distance 1
+    std::vector<ObjectState> objects;
+};
+
+#endif
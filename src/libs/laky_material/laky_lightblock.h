@@ -0,0 +1,27 @@
+#ifndef LIGHT_BLOCK_H
+#define LIGHT_BLOCK_H
+
+#include <glm/glm.hpp>
+
+#include "laky_uniformbuffer.h"
+
+// maximum number of lights in the LightBlock, must match MAX_LIGHTS in include/light_block.glsl
+const int MAX_LIGHTS = 4;
+
+// std140 layout of one Light inside the LightBlock uniform block
+struct LightParams
+{
+    glm::vec4 position;
+    glm::vec4 ambient;
+    glm::vec4 diffuse;
+    glm::vec4 specular;
+};
+
+// std140 layout of the LightBlock uniform block in include/light_block.glsl
+struct LightBlock
+{
+    glm::vec4   viewPos;
+    LightParams lights[MAX_LIGHTS];
+};
+
+#endif
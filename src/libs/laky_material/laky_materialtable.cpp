@@ -0,0 +1,64 @@
+// LAKY'S MATERIAL TABLE v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_materialtable.h"
+
+
+MaterialTable::MaterialTable()
+    : capacity(0), dirtyBegin(0), dirtyEnd(0)
+{
+    glGenBuffers(1, &this->ID);
+}
+
+unsigned int MaterialTable::Add(const MaterialData &material)
+{
+    materials.push_back(material);
+    unsigned int index = (unsigned int)materials.size() - 1;
+    if (dirtyEnd <= dirtyBegin)
+        dirtyBegin = index;
+    dirtyEnd = materials.size();
+    return index;
+}
+
+void MaterialTable::Set(unsigned int index, const MaterialData &material)
+{
+    materials[index] = material;
+    if (dirtyEnd <= dirtyBegin)
+    {
+        dirtyBegin = index;
+        dirtyEnd = index + 1;
+        return;
+    }
+    if (index < dirtyBegin)
+        dirtyBegin = index;
+    if (index + 1 > dirtyEnd)
+        dirtyEnd = index + 1;
+}
+
+void MaterialTable::Bind()
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->ID);
+    if (materials.size() > capacity)
+    {
+        // grow geometrically and re-upload everything
+        capacity = materials.size() * 2;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(MaterialData), NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, materials.size() * sizeof(MaterialData), materials.data());
+        dirtyBegin = dirtyEnd = 0;
+    }
+    else if (dirtyEnd > dirtyBegin)
+    {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, dirtyBegin * sizeof(MaterialData), (dirtyEnd - dirtyBegin) * sizeof(MaterialData), &materials[dirtyBegin]);
+        dirtyBegin = dirtyEnd = 0;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MATERIAL_TABLE_BINDING, this->ID);
+}
+
+void MaterialTable::Destroy()
+{
+    glDeleteBuffers(1, &this->ID);
+    this->ID = 0;
+    capacity = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+
+// shader storage binding points, they must match the layout(binding = N) in the shaders
+enum StorageBinding
+{
+    MATERIAL_TABLE_BINDING = 0
+};
+
+// std430 layout of one entry of the MaterialTable buffer (see include/material_inputs.glsl)
+struct MaterialData
+{
+    glm::vec4 ambient;  // rgb tint applied to the diffuse map for ambient light
+    glm::vec4 diffuse;  // rgb tint applied to the diffuse map
+    glm::vec4 specular; // rgb tint, w = shininess
+    glm::ivec4 maps;    // texture array layers (see ResourceManager::LoadTextureLayer): x = diffuse, y = specular, -1 = none
+    GLuint64 diffuseHandle;  // resident bindless handles (see ResourceManager::MakeTextureResident), 0 = none.
+    GLuint64 specularHandle; // only read by the BINDLESS shader variant, which then ignores `maps`
+};
+
+// MaterialTable packs every material into one shader storage buffer.
+// Draws and instances refer to their material by index (a per-instance
+// vertex attribute), so objects with different materials can share a
+// single draw call. Texture maps are referenced by layer, so all materials
+// drawn together must take their maps from the same texture array (bound
+// to unit 0), or by bindless handle when the driver supports it. Like
+// UniformBuffer, only the changed range is uploaded when the table is bound.
+class MaterialTable
+{
+public:
+    MaterialTable();
+    MaterialTable(const MaterialTable &) = delete;
+    MaterialTable &operator=(const MaterialTable &) = delete;
+    // appends a material and returns its index
+    unsigned int Add(const MaterialData &material);
+    // replaces a material
+    void         Set(unsigned int index, const MaterialData &material);
+    // read access to a material
+    const MaterialData &Get(unsigned int index) const { return materials[index]; }
+    // uploads pending changes and binds the table to MATERIAL_TABLE_BINDING
+    void         Bind();
+    // number of materials in the table
+    unsigned int Count() const { return (unsigned int)materials.size(); }
+    // deletes the GL buffer
+    void         Destroy();
+
+    unsigned int ID;
+private:
+    std::vector<MaterialData> materials;
+    size_t capacity;      // materials the GL buffer can currently hold
+    size_t dirtyBegin;    // dirty range, in materials
+    size_t dirtyEnd;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef UNIFORM_BUFFER_H
+#define UNIFORM_BUFFER_H
+
+#include <cassert>
+#include <cstring>
+
+#include <glad/glad.h>
+
+
+// uniform block binding points, they must match the layout(binding = N) in the shaders
+enum UniformBinding
+{
+    LIGHT_BLOCK_BINDING    = 1,
+    CLUSTER_BLOCK_BINDING  = 2,
+    SHADOW_BLOCK_BINDING   = 3
+};
+
+// UniformBuffer mirrors a std140 uniform block in a CPU-side struct T.
+// Writes go through Set(), which only marks the block dirty when a value
+// actually changed and remembers the smallest byte range that needs
+// uploading. Bind() pushes that range with a single glBufferSubData (or
+// nothing at all when the block is clean) and binds the buffer, so
+// constant parameters cost nothing per frame. T must be laid out to
+// match std140 (use vec4s / pad vec3s to 16 bytes).
+template <typename T>
+class UniformBuffer
+{
+public:
+    UniformBuffer() : dirtyBegin(0), dirtyEnd(sizeof(T)), uploads(0)
+    {
+        memset((void *)&data, 0, sizeof(T));
+        glGenBuffers(1, &this->ID);
+        glBindBuffer(GL_UNIFORM_BUFFER, this->ID);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(T), NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    UniformBuffer(const UniformBuffer &) = delete;
+    UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+    // read access to the CPU copy (also used to name the field passed to Set)
+    const T &Get() const { return data; }
+
+    // writes one field of the block, `field` has to be a member of Get()
+    template <typename F>
+    void Set(const F &field, const F &value)
+    {
+        size_t offset = (const char *)&field - (const char *)&data;
+        assert(offset + sizeof(F) <= sizeof(T));
+        if (memcmp(&field, &value, sizeof(F)) == 0)
+            return;
+
+        memcpy((char *)&data + offset, &value, sizeof(F));
+        markDirty(offset, sizeof(F));
+    }
+
+    // true if there are changes waiting to be uploaded
+    bool IsDirty() const { return dirtyEnd > dirtyBegin; }
+
+    // uploads pending changes and binds the buffer to a uniform block binding point
+    void Bind(GLuint binding)
+    {
+        if (IsDirty())
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, this->ID);
+            glBufferSubData(GL_UNIFORM_BUFFER, dirtyBegin, dirtyEnd - dirtyBegin, (const char *)&data + dirtyBegin);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            dirtyBegin = dirtyEnd = 0;
+            uploads++;
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, this->ID);
+    }
+
+    // number of times the block was actually uploaded
+    unsigned int Uploads() const { return uploads; }
+
+    // deletes the GL buffer
+    void Destroy()
+    {
+        glDeleteBuffers(1, &this->ID);
+        this->ID = 0;
+    }
+
+    unsigned int ID;
+private:
+    T            data;
+    size_t       dirtyBegin;
+    size_t       dirtyEnd;
+    unsigned int uploads;
+
+    void markDirty(size_t offset, size_t size)
+    {
+        if (!IsDirty())
+        {
+            dirtyBegin = offset;
+            dirtyEnd = offset + size;
+            return;
+        }
+        if (offset < dirtyBegin)
+            dirtyBegin = offset;
+        if (offset + size > dirtyEnd)
+            dirtyEnd = offset + size;
+    }
+};
+
+#endif
@@ -0,0 +1,130 @@
+// LAKY'S FRAME ARENA v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_framearena.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "../laky_jobs/laky_jobs.h"
+
+// smallest block an arena takes from the heap, also its size if none was given
+const size_t MIN_BLOCK_SIZE = 64 * 1024;
+// blocks start on this boundary, enough for every type including SSE vectors
+const size_t BLOCK_ALIGNMENT = 64;
+
+// Instantiate static variables
+std::vector<LinearArena *> FrameArena::arenas;
+FrameArenaStats            FrameArena::stats = {};
+
+
+LinearArena::LinearArena(size_t blockSize)
+    : offset(0), used(0), peak(0), blockSize(blockSize > MIN_BLOCK_SIZE ? blockSize : MIN_BLOCK_SIZE), blockAllocations(0)
+{
+}
+
+LinearArena::~LinearArena()
+{
+    for (Block &block : blocks)
+        std::free(block.data);
+}
+
+void *LinearArena::Allocate(size_t size, size_t alignment)
+{
+    if (!blocks.empty())
+    {
+        // aligned on the address, blocks themselves are only BLOCK_ALIGNMENT aligned
+        Block &block = blocks.back();
+        size_t address = (size_t)(block.data + offset);
+        size_t start = offset + ((address + alignment - 1) & ~(alignment - 1)) - address;
+        if (start + size <= block.size)
+        {
+            used += start + size - offset;
+            offset = start + size;
+            return block.data + start;
+        }
+    }
+
+    // a fresh block, the rest of the old one stays unused until Reset
+    addBlock(size + alignment > blockSize ? size + alignment : blockSize);
+    return Allocate(size, alignment);
+}
+
+void LinearArena::Reset()
+{
+    if (used > peak)
+        peak = used;
+    // several blocks mean the round outgrew the arena: trade them for one that would have held it all
+    if (blocks.size() > 1)
+    {
+        for (Block &block : blocks)
+            std::free(block.data);
+        blocks.clear();
+        while (blockSize < peak)
+            blockSize *= 2;
+        addBlock(blockSize);
+    }
+    offset = 0;
+    used = 0;
+}
+
+void LinearArena::addBlock(size_t size)
+{
+    Block block;
+    block.size = (size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    block.data = (char *)std::aligned_alloc(BLOCK_ALIGNMENT, block.size);
+    if (block.data == NULL)
+    {
+        // callers (FrameVector among them) have no way to handle a NULL, stop here instead of crashing somewhere later
+        std::cout << "ERROR::FRAME_ARENA: Out of memory allocating a block of " << block.size << " bytes" << std::endl;
+        std::abort();
+    }
+    blocks.push_back(block);
+    offset = 0;
+    blockAllocations++;
+}
+
+
+void FrameArena::Start(size_t bytesPerThread)
+{
+    if (!arenas.empty())
+        return;
+    for (unsigned int i = 0; i < JobSystem::ThreadCount(); i++)
+        arenas.push_back(new LinearArena(bytesPerThread));
+    stats = FrameArenaStats();
+}
+
+void FrameArena::Stop()
+{
+    for (LinearArena *arena : arenas)
+        delete arena;
+    arenas.clear();
+}
+
+void FrameArena::BeginFrame()
+{
+    stats.usedBytes = 0;
+    size_t peak = 0, blockAllocations = 0;
+    for (LinearArena *arena : arenas)
+    {
+        stats.usedBytes += arena->Used();
+        arena->Reset();
+        peak += arena->Peak();
+        blockAllocations += arena->BlockAllocations();
+    }
+    stats.peakBytes = peak;
+    stats.blockAllocations = blockAllocations;
+}
+
+void *FrameArena::Allocate(size_t size, size_t alignment)
+{
+    // workers started after FrameArena::Start have no arena, and neither has anyone before it (or after Stop)
+    unsigned int thread = JobSystem::ThreadIndex();
+    if (thread >= arenas.size())
+    {
+        std::cout << "ERROR::FRAME_ARENA: Thread " << thread << " has no arena, call FrameArena::Start after JobSystem::Start" << std::endl;
+        std::abort();
+    }
+    return arenas[thread]->Allocate(size, alignment);
+}
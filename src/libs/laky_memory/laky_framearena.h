@@ -0,0 +1,100 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+
+// LinearArena hands out memory by bumping a pointer through big blocks and
+// frees everything at once on Reset. When a round needed more than one
+// block, Reset swaps them for a single block as large as the round's peak,
+// so after the first few rounds the arena never touches the heap again.
+class LinearArena
+{
+public:
+    explicit LinearArena(size_t blockSize = 0);
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+    ~LinearArena();
+    // `alignment` must be a power of two; never returns NULL, a request that doesn't fit starts a new block (out of memory aborts)
+    void  *Allocate(size_t size, size_t alignment);
+    // forgets every allocation since the last Reset
+    void   Reset();
+    // bytes handed out since the last Reset
+    size_t Used() const { return used; }
+    // most bytes handed out between two Resets
+    size_t Peak() const { return peak; }
+    // blocks taken from the heap so far, stops growing once the arena has settled
+    size_t BlockAllocations() const { return blockAllocations; }
+private:
+    struct Block
+    {
+        char  *data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;   // the last one is being filled
+    size_t             offset;   // fill level of the last block
+    size_t             used;
+    size_t             peak;
+    size_t             blockSize;
+    size_t             blockAllocations;
+    void addBlock(size_t size);
+};
+
+// numbers of all FrameArena threads together
+struct FrameArenaStats
+{
+    size_t usedBytes;        // allocated during the last finished frame
+    size_t peakBytes;        // most allocated in one frame, summed over the threads
+    size_t blockAllocations; // heap blocks the arenas ever took
+};
+
+// A static singleton FrameArena class for data that lives for one frame:
+// draw lists, culling results, scratch arrays. Every JobSystem thread owns
+// a LinearArena (see JobSystem::ThreadIndex), so loop bodies allocate
+// without locking; all of them are reset together by BeginFrame. Nothing
+// allocated here may be kept past the next BeginFrame.
+class FrameArena
+{
+public:
+    // one arena per JobSystem thread, call after JobSystem::Start
+    static void   Start(size_t bytesPerThread);
+    static void   Stop();
+    // frees everything allocated during the last frame, call while no loop is running
+    static void   BeginFrame();
+    // from the calling thread's arena, aborts if the thread has none
+    static void  *Allocate(size_t size, size_t alignment);
+    static const FrameArenaStats &Stats() { return stats; }
+private:
+    static std::vector<LinearArena *> arenas;
+    static FrameArenaStats            stats;
+    // private constructor, that is we do not want any actual frame arena objects
+    FrameArena() { }
+};
+
+// STL allocator on top of the FrameArena: deallocate is a no-op, the memory
+// comes back at the next FrameArena::BeginFrame, so containers using it
+// must not outlive the frame. Reserve up front where the size is known,
+// every reallocation leaves the old array behind until then.
+template <typename T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameAllocator() { }
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &) { }
+    T *allocate(size_t count) { return (T *)FrameArena::Allocate(count * sizeof(T), alignof(T)); }
+    void deallocate(T *, size_t) { }
+    template <typename U>
+    bool operator==(const FrameAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U> &) const { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif
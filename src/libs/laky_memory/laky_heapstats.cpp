@@ -0,0 +1,100 @@
+// LAKY'S HEAP STATS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_heapstats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// relaxed is enough, they are only read as totals
+static std::atomic<size_t> allocations(0);
+static std::atomic<size_t> frees(0);
+static std::atomic<size_t> allocatedBytes(0);
+
+
+HeapStats GetHeapStats()
+{
+    HeapStats stats;
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.frees = frees.load(std::memory_order_relaxed);
+    stats.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+static void *countedAllocate(size_t size, size_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+}
+
+static void countedFree(void *pointer)
+{
+    if (pointer == NULL)
+        return;
+    frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(pointer);
+}
+
+// throwing forms
+void *operator new(size_t size)
+{
+    void *pointer = countedAllocate(size, 0);
+    if (pointer == NULL)
+        throw std::bad_alloc();
+    return pointer;
+}
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    void *pointer = countedAllocate(size, (size_t)alignment);
+    if (pointer == NULL)
+        throw std::bad_alloc();
+    return pointer;
+}
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+// nothrow forms
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size, 0);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size, 0);
+}
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size, (size_t)alignment);
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size, (size_t)alignment);
+}
+
+// every delete ends up in free, malloc and aligned_alloc memory alike
+void operator delete(void *pointer) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { countedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { countedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { countedFree(pointer); }
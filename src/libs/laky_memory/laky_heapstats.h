@@ -0,0 +1,22 @@
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <cstddef>
+
+
+// Counts of the program's heap traffic. Linking laky_heapstats.cpp replaces
+// the global operator new and delete (every form) with versions that bump
+// these counters before calling malloc and free, so the difference between
+// two snapshots is exactly the number of new/delete calls in between,
+// including the ones inside the standard library.
+struct HeapStats
+{
+    size_t allocations;
+    size_t frees;
+    size_t allocatedBytes;
+};
+
+// the counters as of now, from any thread
+HeapStats GetHeapStats();
+
+#endif
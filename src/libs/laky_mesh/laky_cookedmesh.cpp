@@ -0,0 +1,124 @@
+// LAKY'S COOKED MESH v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_cookedmesh.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+
+CookedMesh::CookedMesh()
+    : header(NULL)
+{
+}
+
+bool CookedMesh::Open(const std::string &path)
+{
+    Close();
+    if (!file.Open(path))
+        return false;
+    const CookedMeshHeader *candidate = (const CookedMeshHeader *)file.Data();
+    if (file.Size() < sizeof(CookedMeshHeader) || candidate->magic != COOKED_MESH_MAGIC)
+    {
+        std::cout << "ERROR::COOKED_MESH: Not a cooked mesh: " << path << std::endl;
+        Close();
+        return false;
+    }
+    if (candidate->version != COOKED_MESH_VERSION || candidate->vertexSize != sizeof(Vertex) || candidate->sectionCount != COOKED_SECTION_COUNT)
+    {
+        std::cout << "ERROR::COOKED_MESH: " << path << " was cooked by another version (format " << candidate->version << "), cook it again" << std::endl;
+        Close();
+        return false;
+    }
+    // every section must lie inside the file and hold exactly what the counts say
+    const unsigned long long expected[COOKED_SECTION_COUNT] = {
+        (unsigned long long)candidate->vertexCount * sizeof(Vertex),
+        (unsigned long long)candidate->indexCount * sizeof(unsigned int),
+        (unsigned long long)candidate->meshletCount * sizeof(Meshlet),
+    };
+    for (unsigned int i = 0; i < COOKED_SECTION_COUNT; i++)
+    {
+        if (candidate->sections[i].size != expected[i] || candidate->sections[i].offset % COOKED_MESH_ALIGNMENT != 0
+            || candidate->sections[i].offset > file.Size() || candidate->sections[i].size > file.Size() - candidate->sections[i].offset)
+        {
+            std::cout << "ERROR::COOKED_MESH: " << path << " is truncated or damaged" << std::endl;
+            Close();
+            return false;
+        }
+    }
+    header = candidate;
+    return true;
+}
+
+void CookedMesh::Close()
+{
+    file.Close();
+    header = NULL;
+}
+
+bool WriteCookedMesh(const std::string &path, const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount,
+                     const Meshlet *meshlets, size_t meshletCount)
+{
+    CookedMeshHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = COOKED_MESH_MAGIC;
+    header.version = COOKED_MESH_VERSION;
+    header.vertexSize = sizeof(Vertex);
+    header.vertexCount = (unsigned int)vertexCount;
+    header.indexCount = (unsigned int)indexCount;
+    header.meshletCount = (unsigned int)meshletCount;
+    header.sectionCount = COOKED_SECTION_COUNT;
+
+    // the same bounds MeshArena::Add would compute, so loading doesn't have to look at the vertices
+    glm::vec3 min(0.0f), max(0.0f);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        min = i == 0 ? vertices[i].position : glm::min(min, vertices[i].position);
+        max = i == 0 ? vertices[i].position : glm::max(max, vertices[i].position);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (size_t i = 0; i < vertexCount; i++)
+        radius = glm::max(radius, glm::length(vertices[i].position - center));
+    for (int axis = 0; axis < 3; axis++)
+    {
+        header.boundsMin[axis] = min[axis];
+        header.boundsMax[axis] = max[axis];
+    }
+    header.boundsRadius = radius;
+
+    const void *data[COOKED_SECTION_COUNT] = { vertices, indices, meshlets };
+    header.sections[COOKED_VERTICES].size = vertexCount * sizeof(Vertex);
+    header.sections[COOKED_INDICES].size = indexCount * sizeof(unsigned int);
+    header.sections[COOKED_MESHLETS].size = meshletCount * sizeof(Meshlet);
+    unsigned long long offset = sizeof(header);
+    for (unsigned int i = 0; i < COOKED_SECTION_COUNT; i++)
+    {
+        offset = (offset + COOKED_MESH_ALIGNMENT - 1) / COOKED_MESH_ALIGNMENT * COOKED_MESH_ALIGNMENT;
+        header.sections[i].offset = offset;
+        offset += header.sections[i].size;
+    }
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == NULL)
+    {
+        std::cout << "ERROR::COOKED_MESH: Could not write " << path << std::endl;
+        return false;
+    }
+    static const char padding[COOKED_MESH_ALIGNMENT] = {};
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    unsigned long long position = sizeof(header);
+    for (unsigned int i = 0; written && i < COOKED_SECTION_COUNT; i++)
+    {
+        written = fwrite(padding, 1, (size_t)(header.sections[i].offset - position), file) == header.sections[i].offset - position;
+        if (written && header.sections[i].size > 0)
+            written = fwrite(data[i], (size_t)header.sections[i].size, 1, file) == 1;
+        position = header.sections[i].offset + header.sections[i].size;
+    }
+    written = fclose(file) == 0 && written;
+    if (!written)
+        std::cout << "ERROR::COOKED_MESH: Could not write " << path << std::endl;
+    return written;
+}
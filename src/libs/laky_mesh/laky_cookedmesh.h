@@ -0,0 +1,85 @@
+#ifndef COOKED_MESH_H
+#define COOKED_MESH_H
+
+#include <cstddef>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include "laky_mappedfile.h"
+#include "laky_meshlets.h"
+#include "laky_vertex.h"
+
+
+const unsigned int COOKED_MESH_MAGIC = 0x484D4B4C; // "LKMH" in a little-endian file
+const unsigned int COOKED_MESH_VERSION = 2;
+const size_t COOKED_MESH_ALIGNMENT = 64;           // every section starts on a cache line
+
+// the blobs of a cooked mesh, in file order
+enum CookedSection
+{
+    COOKED_VERTICES, // Vertex[vertexCount]
+    COOKED_INDICES,  // unsigned int[indexCount], relative to the mesh's first vertex, ordered meshlet by meshlet
+    COOKED_MESHLETS, // Meshlet[meshletCount]
+    COOKED_SECTION_COUNT
+};
+
+// start of a cooked mesh file (.lkm), the sections follow it; offsets are from the start of the file
+struct CookedMeshHeader
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int vertexSize;   // sizeof(Vertex) when the file was cooked, a different layout can't be loaded
+    unsigned int vertexCount;
+    unsigned int indexCount;
+    unsigned int meshletCount;
+    float        boundsMin[3]; // local bounding box, and the bounding sphere radius around its center
+    float        boundsMax[3];
+    float        boundsRadius;
+    unsigned int sectionCount;
+    struct
+    {
+        unsigned long long offset;
+        unsigned long long size;
+    } sections[COOKED_SECTION_COUNT];
+};
+
+// CookedMesh maps a file written by WriteCookedMesh (laky_cook converts
+// OBJ and .glb files). The sections already have the layout the GPU
+// buffers use, so after checking the header nothing is parsed: Vertices()
+// and Indices() point into the mapping and go to glBufferSubData as they
+// are, which reads every page once, straight from the page cache. The
+// meshlets index ranges of the index section, see MeshArena::AddMeshlet.
+// Cooked files are native little-endian and only checked for consistent
+// sizes, the indices are trusted to stay within the mesh's vertices.
+class CookedMesh
+{
+public:
+    CookedMesh();
+    // maps the file and checks its header, prints an error and returns false if it isn't a cooked mesh of this version
+    bool Open(const std::string &path);
+    void Close();
+
+    size_t VertexCount() const { return header->vertexCount; }
+    size_t IndexCount() const { return header->indexCount; }
+    const Vertex *Vertices() const { return (const Vertex *)section(COOKED_VERTICES); }
+    const unsigned int *Indices() const { return (const unsigned int *)section(COOKED_INDICES); }
+    size_t MeshletCount() const { return header->meshletCount; }
+    const Meshlet *Meshlets() const { return (const Meshlet *)section(COOKED_MESHLETS); }
+    glm::vec3 BoundsMin() const { return glm::vec3(header->boundsMin[0], header->boundsMin[1], header->boundsMin[2]); }
+    glm::vec3 BoundsMax() const { return glm::vec3(header->boundsMax[0], header->boundsMax[1], header->boundsMax[2]); }
+    float BoundsRadius() const { return header->boundsRadius; }
+    size_t FileSize() const { return file.Size(); }
+private:
+    MappedFile              file;
+    const CookedMeshHeader *header;
+
+    const char *section(CookedSection index) const { return file.Data() + header->sections[index].offset; }
+};
+
+// cooks a mesh and its meshlets (BuildMeshlets, with the indices it reordered) into a file CookedMesh can map; prints an
+// error and returns false if it can't be written
+bool WriteCookedMesh(const std::string &path, const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount,
+                     const Meshlet *meshlets, size_t meshletCount);
+
+#endif
@@ -0,0 +1,125 @@
+// LAKY'S MAPPED FILE v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_mappedfile.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : data(NULL), size(0), file(INVALID_HANDLE_VALUE), mapping(NULL)
+{
+}
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    LARGE_INTEGER fileSize;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize))
+    {
+        std::cout << "ERROR::MAPPED_FILE: Could not open " << path << std::endl;
+        Close();
+        return false;
+    }
+    size = (size_t)fileSize.QuadPart;
+    // an empty file can't be mapped, it just has no data
+    if (size == 0)
+    {
+        data = "";
+        return true;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    data = mapping ? (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (data == NULL)
+    {
+        std::cout << "ERROR::MAPPED_FILE: Could not map " << path << std::endl;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data != NULL && size > 0)
+        UnmapViewOfFile(data);
+    if (mapping != NULL)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+    data = NULL;
+    size = 0;
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : data(NULL), size(0)
+{
+}
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0)
+    {
+        std::cout << "ERROR::MAPPED_FILE: Could not open " << path << std::endl;
+        if (fd >= 0)
+            close(fd);
+        return false;
+    }
+    size = (size_t)status.st_size;
+    if (size == 0)
+    {
+        close(fd);
+        data = "";
+        return true;
+    }
+    // the mapping keeps the file alive, the descriptor isn't needed any more
+    void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        std::cout << "ERROR::MAPPED_FILE: Could not map " << path << std::endl;
+        size = 0;
+        return false;
+    }
+    // parsers read front to back
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    data = (const char *)mapped;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data != NULL && size > 0)
+        munmap((void *)data, size);
+    data = NULL;
+    size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+
+// MappedFile maps a whole file read-only into memory (mmap, or a file
+// mapping on Windows), so parsers can read it in place: the OS pages it in
+// as it is touched and nothing is copied into a buffer first.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    // maps the file, closing whatever was mapped before; prints an error and returns false if that fails
+    bool Open(const std::string &path);
+    // unmaps the file
+    void Close();
+
+    const char *Data() const { return data; }
+    size_t Size() const { return size; }
+    bool IsOpen() const { return data != NULL; }
+private:
+    const char *data;
+    size_t      size;
+#ifdef _WIN32
+    void       *file;
+    void       *mapping;
+#endif
+};
+
+#endif
@@ -0,0 +1,192 @@
+// LAKY'S MESH ARENA v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_mesharena.h"
+
+#include <iostream>
+
+
+MeshArena::MeshArena()
+    : VBO(0), EBO(0), vertexCount(0), vertexCapacity(0), indexCount(0), indexCapacity(0)
+{
+}
+
+unsigned int MeshArena::Add(const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount)
+{
+    // bounding sphere around the box center, loose but cheap and good enough for culling
+    glm::vec3 min(0.0f), max(0.0f);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        min = i == 0 ? vertices[i].position : glm::min(min, vertices[i].position);
+        max = i == 0 ? vertices[i].position : glm::max(max, vertices[i].position);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (size_t i = 0; i < vertexCount; i++)
+        radius = glm::max(radius, glm::length(vertices[i].position - center));
+    return Add(vertices, vertexCount, indices, indexCount, min, max, radius);
+}
+
+unsigned int MeshArena::Add(const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount,
+                            const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float radius)
+{
+    reserveVertices(vertexCount);
+
+    // both buffers are only ever used as copy targets here, the VAOs drawing from the arena bind them themselves
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->VBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, this->vertexCount * sizeof(Vertex), vertexCount * sizeof(Vertex), vertices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    unsigned int firstIndex = appendIndices(indices, indexCount);
+
+    MeshRange range;
+    range.bounds = glm::vec4((boundsMin + boundsMax) * 0.5f, radius);
+    range.boundsMin = boundsMin;
+    range.boundsMax = boundsMax;
+    range.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    range.firstIndex = firstIndex;
+    range.indexCount = (unsigned int)indexCount;
+    range.baseVertex = (int)this->vertexCount;
+    range.vertexCount = (unsigned int)vertexCount;
+    meshes.push_back(range);
+
+    this->vertexCount += vertexCount;
+    return (unsigned int)meshes.size() - 1;
+}
+
+unsigned int MeshArena::AddLod(unsigned int mesh, const unsigned int *indices, size_t indexCount)
+{
+    // a coarser level never reaches past the full one, so its bounds still hold
+    MeshRange range = meshes[mesh];
+    range.firstIndex = appendIndices(indices, indexCount);
+    range.indexCount = (unsigned int)indexCount;
+    meshes.push_back(range);
+    return (unsigned int)meshes.size() - 1;
+}
+
+unsigned int MeshArena::AddMeshlet(unsigned int mesh, const Meshlet &meshlet)
+{
+    // no indices are added, the meshlet's triangles already sit together in the mesh's range
+    MeshRange range = meshes[mesh];
+    range.firstIndex += meshlet.firstIndex;
+    range.indexCount = meshlet.triangleCount * 3;
+    range.bounds = meshlet.sphere;
+    range.boundsMin = glm::vec3(meshlet.sphere) - meshlet.sphere.w;
+    range.boundsMax = glm::vec3(meshlet.sphere) + meshlet.sphere.w;
+    range.cone = meshlet.cone;
+    meshes.push_back(range);
+    return (unsigned int)meshes.size() - 1;
+}
+
+unsigned int MeshArena::Reserve(size_t vertexCount, size_t indexCount, Vertex *&vertices, unsigned int *&indices)
+{
+    reserveVertices(vertexCount);
+    reserveIndices(indexCount);
+
+    // the ranges are past everything the GPU could still be reading, so there's nothing to wait for
+    const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->VBO);
+    vertices = (Vertex *)glMapBufferRange(GL_COPY_WRITE_BUFFER, this->vertexCount * sizeof(Vertex), vertexCount * sizeof(Vertex), access);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->EBO);
+    indices = (unsigned int *)glMapBufferRange(GL_COPY_WRITE_BUFFER, this->indexCount * sizeof(unsigned int), indexCount * sizeof(unsigned int), access);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    MeshRange range;
+    range.bounds = glm::vec4(0.0f);
+    range.boundsMin = range.boundsMax = glm::vec3(0.0f);
+    range.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    range.firstIndex = (unsigned int)this->indexCount;
+    range.indexCount = (unsigned int)indexCount;
+    range.baseVertex = (int)this->vertexCount;
+    range.vertexCount = (unsigned int)vertexCount;
+    meshes.push_back(range);
+
+    this->vertexCount += vertexCount;
+    this->indexCount += indexCount;
+    return (unsigned int)meshes.size() - 1;
+}
+
+bool MeshArena::Commit(unsigned int mesh, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float radius)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->VBO);
+    bool intact = glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->EBO);
+    intact = glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE && intact;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    MeshRange &range = meshes[mesh];
+    range.bounds = glm::vec4((boundsMin + boundsMax) * 0.5f, radius);
+    range.boundsMin = boundsMin;
+    range.boundsMax = boundsMax;
+    if (!intact)
+    {
+        // the driver may drop mapped memory (e.g. on a display mode change), the data has to be written again
+        std::cout << "ERROR::MESH_ARENA: Mapped mesh data was lost" << std::endl;
+        range.indexCount = 0;
+    }
+    return intact;
+}
+
+void MeshArena::Destroy()
+{
+    glDeleteBuffers(1, &this->VBO);
+    glDeleteBuffers(1, &this->EBO);
+    this->VBO = this->EBO = 0;
+    meshes.clear();
+    vertexCount = vertexCapacity = indexCount = indexCapacity = 0;
+}
+
+
+unsigned int MeshArena::appendIndices(const unsigned int *indices, size_t indexCount)
+{
+    reserveIndices(indexCount);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->EBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, this->indexCount * sizeof(unsigned int), indexCount * sizeof(unsigned int), indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    unsigned int firstIndex = (unsigned int)this->indexCount;
+    this->indexCount += indexCount;
+    return firstIndex;
+}
+
+void MeshArena::reserveVertices(size_t count)
+{
+    if (this->vertexCount + count <= this->vertexCapacity)
+        return;
+    size_t capacity = this->vertexCapacity > 0 ? this->vertexCapacity : 1024;
+    while (capacity < this->vertexCount + count)
+        capacity *= 2;
+    grow(this->VBO, this->vertexCount * sizeof(Vertex), capacity * sizeof(Vertex));
+    this->vertexCapacity = capacity;
+}
+
+void MeshArena::reserveIndices(size_t count)
+{
+    if (this->indexCount + count <= this->indexCapacity)
+        return;
+    size_t capacity = this->indexCapacity > 0 ? this->indexCapacity : 4096;
+    while (capacity < this->indexCount + count)
+        capacity *= 2;
+    grow(this->EBO, this->indexCount * sizeof(unsigned int), capacity * sizeof(unsigned int));
+    this->indexCapacity = capacity;
+}
+
+void MeshArena::grow(unsigned int &buffer, size_t used, size_t newSize)
+{
+    unsigned int grown;
+    glGenBuffers(1, &grown);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+    glBufferData(GL_COPY_WRITE_BUFFER, newSize, NULL, GL_STATIC_DRAW);
+    if (buffer != 0)
+    {
+        if (used > 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, used);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    buffer = grown;
+}
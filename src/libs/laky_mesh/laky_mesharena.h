@@ -0,0 +1,82 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "laky_meshlets.h"
+#include "laky_vertex.h"
+
+
+// where a mesh lives inside the arena's buffers, in the terms glDrawElementsBaseVertex expects
+struct MeshRange
+{
+    unsigned int firstIndex;  // first index inside the shared index buffer
+    unsigned int indexCount;
+    int          baseVertex;  // added to every index of the mesh
+    unsigned int vertexCount;
+    glm::vec4    bounds;      // local bounding sphere: xyz = center, w = radius
+    glm::vec3    boundsMin;   // local bounding box
+    glm::vec3    boundsMax;
+    glm::vec4    cone;        // normal cone of a meshlet (axis, cutoff), cutoff 1 for whole meshes: never back-facing
+};
+
+// MeshArena packs the vertices and indices of many meshes into one
+// vertex buffer and one index buffer, so a single VAO can draw any of
+// them and different meshes can be merged into one multi-draw. Meshes
+// are appended and never freed individually; both buffers grow
+// geometrically, copying existing data on the GPU.
+class MeshArena
+{
+public:
+    MeshArena();
+    MeshArena(const MeshArena &) = delete;
+    MeshArena &operator=(const MeshArena &) = delete;
+    // appends a mesh and returns its index, indices are relative to the mesh's own vertices
+    unsigned int Add(const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount);
+    unsigned int Add(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) { return Add(vertices.data(), vertices.size(), indices.data(), indices.size()); }
+    // appends a mesh whose bounds are already known (box and sphere radius around the box center, e.g. from a CookedMesh),
+    // the vertices are only copied to the GPU and never read on the CPU
+    unsigned int Add(const Vertex *vertices, size_t vertexCount, const unsigned int *indices, size_t indexCount,
+                     const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float radius);
+    // appends another index list over an existing mesh's vertices (a level of detail) and returns it as a new mesh sharing the vertices and bounds
+    unsigned int AddLod(unsigned int mesh, const unsigned int *indices, size_t indexCount);
+    unsigned int AddLod(unsigned int mesh, const std::vector<unsigned int> &indices) { return AddLod(mesh, indices.data(), indices.size()); }
+    // returns a meshlet of an existing mesh as a mesh of its own (its range of the mesh's indices, with its own bounds and
+    // normal cone), so it can be submitted and culled separately; the mesh's indices must be ordered meshlet by meshlet
+    unsigned int AddMeshlet(unsigned int mesh, const Meshlet &meshlet);
+    // appends a mesh whose data is written straight into the buffers, e.g. by a MeshLoader: maps the mesh's vertex and
+    // index ranges for writing and returns it. Commit() unmaps them, nothing else may use the arena in between
+    unsigned int Reserve(size_t vertexCount, size_t indexCount, Vertex *&vertices, unsigned int *&indices);
+    // unmaps a Reserve()d mesh and records its bounds (box and sphere radius around the box center); false if the driver
+    // lost the mapped data, the mesh then draws nothing
+    bool Commit(unsigned int mesh, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float radius);
+    // location of a mesh inside the buffers
+    const MeshRange &Get(unsigned int mesh) const { return meshes[mesh]; }
+    // number of meshes in the arena
+    unsigned int Count() const { return (unsigned int)meshes.size(); }
+    // vertices and indices in use
+    size_t VertexCount() const { return vertexCount; }
+    size_t IndexCount() const { return indexCount; }
+    // deletes the GL buffers
+    void Destroy();
+
+    // shared buffers, they are replaced when the arena grows so don't cache the IDs across Add() calls
+    unsigned int VBO, EBO;
+private:
+    std::vector<MeshRange> meshes;
+    size_t vertexCount, vertexCapacity;
+    size_t indexCount, indexCapacity;
+    // appends indices to the index buffer, growing it when needed, and returns where they start
+    unsigned int appendIndices(const unsigned int *indices, size_t indexCount);
+    // makes room for more vertices or indices, doubling the capacity as often as needed
+    void reserveVertices(size_t count);
+    void reserveIndices(size_t count);
+    // reallocates a buffer with a larger size, keeping its first `used` bytes
+    static void grow(unsigned int &buffer, size_t used, size_t newSize);
+};
+
+#endif
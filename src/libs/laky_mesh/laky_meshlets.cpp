@@ -0,0 +1,176 @@
+// LAKY'S MESHLETS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+
+// how much a candidate triangle's normal turning away from the meshlet's cone weighs against one new vertex
+static const float CONE_WEIGHT = 2.0f;
+// and how much its distance from the meshlet's center (relative to the meshlet's size) does
+static const float DISTANCE_WEIGHT = 1.0f;
+
+
+// bounding sphere and normal cone of a finished meshlet
+static void finishMeshlet(const std::vector<glm::vec3> &positions, const std::vector<glm::vec3> &triangleNormals, const unsigned int *triangles,
+                          const std::vector<unsigned int> &vertices, Meshlet &meshlet)
+{
+    glm::vec3 min = positions[vertices[0]], max = min;
+    for (unsigned int vertex : vertices)
+    {
+        min = glm::min(min, positions[vertex]);
+        max = glm::max(max, positions[vertex]);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (unsigned int vertex : vertices)
+        radius = std::max(radius, glm::length(positions[vertex] - center));
+    meshlet.sphere = glm::vec4(center, radius);
+    meshlet.vertexCount = (unsigned int)vertices.size();
+
+    // the axis averages the triangles' normals, the cutoff follows from the one furthest off it; a cone wider than a
+    // half sphere has nothing to cull
+    glm::vec3 axis(0.0f);
+    for (unsigned int i = 0; i < meshlet.triangleCount; i++)
+        axis += triangleNormals[triangles[i]];
+    float length = glm::length(axis);
+    meshlet.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    if (length <= 0.0f)
+        return;
+    axis /= length;
+    float minDot = 1.0f;
+    for (unsigned int i = 0; i < meshlet.triangleCount; i++)
+    {
+        const glm::vec3 &normal = triangleNormals[triangles[i]];
+        if (normal != glm::vec3(0.0f))
+            minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+    if (minDot > 0.0f)
+        meshlet.cone = glm::vec4(axis, std::sqrt(1.0f - minDot * minDot));
+}
+
+void BuildMeshlets(const std::vector<glm::vec3> &positions, const unsigned int *indices, size_t indexCount,
+                   std::vector<unsigned int> &reordered, std::vector<Meshlet> &meshlets)
+{
+    size_t triangleCount = indexCount / 3, vertexCount = positions.size();
+    reordered.clear();
+    reordered.reserve(triangleCount * 3);
+    meshlets.clear();
+    if (triangleCount == 0)
+        return;
+
+    // unit normal per triangle (zero for degenerate ones, which then fit any cone)
+    std::vector<glm::vec3> triangleNormals(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        const glm::vec3 &a = positions[indices[t * 3]], &b = positions[indices[t * 3 + 1]], &c = positions[indices[t * 3 + 2]];
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        float length = glm::length(normal);
+        triangleNormals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+    }
+
+    // triangles around every vertex, as offsets into one list
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0), adjacency(triangleCount * 3);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+        adjacencyOffsets[indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; v++)
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+        adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+
+    // meshlet each vertex was last added to (+1, 0 = none), so membership is one lookup
+    std::vector<unsigned int> vertexMeshlet(vertexCount, 0);
+    std::vector<bool> used(triangleCount, false);
+    std::vector<unsigned int> meshletVertices, meshletTriangles;
+    meshletVertices.reserve(MESHLET_MAX_VERTICES);
+    meshletTriangles.reserve(MESHLET_MAX_TRIANGLES);
+    glm::vec3 normalSum(0.0f), positionSum(0.0f);
+    size_t seed = 0;
+
+    // vertices a triangle would add to the current meshlet, a vertex named twice counts once
+    auto newVertices = [&](size_t triangle) {
+        unsigned int current = (unsigned int)meshlets.size() + 1;
+        unsigned int a = indices[triangle * 3], b = indices[triangle * 3 + 1], c = indices[triangle * 3 + 2];
+        return (unsigned int)(vertexMeshlet[a] != current) + (unsigned int)(vertexMeshlet[b] != current && b != a)
+             + (unsigned int)(vertexMeshlet[c] != current && c != a && c != b);
+    };
+    auto finish = [&]() {
+        Meshlet meshlet;
+        meshlet.firstIndex = (unsigned int)reordered.size();
+        meshlet.triangleCount = (unsigned int)meshletTriangles.size();
+        meshlet.padding = 0;
+        finishMeshlet(positions, triangleNormals, meshletTriangles.data(), meshletVertices, meshlet);
+        for (unsigned int triangle : meshletTriangles)
+            reordered.insert(reordered.end(), indices + triangle * 3, indices + triangle * 3 + 3);
+        meshlets.push_back(meshlet);
+        meshletVertices.clear();
+        meshletTriangles.clear();
+        normalSum = positionSum = glm::vec3(0.0f);
+    };
+
+    for (;;)
+    {
+        // the best unused triangle touching the meshlet that still fits
+        size_t best = triangleCount;
+        float bestScore = 1e30f;
+        if (meshletTriangles.size() < MESHLET_MAX_TRIANGLES)
+        {
+            float sumLength = glm::length(normalSum);
+            glm::vec3 coneAxis = sumLength > 0.0f ? normalSum / sumLength : glm::vec3(0.0f);
+            glm::vec3 center = positionSum / (float)meshletVertices.size();
+            float extent = 0.0f;
+            for (unsigned int vertex : meshletVertices)
+                extent = std::max(extent, glm::length(positions[vertex] - center));
+            for (unsigned int vertex : meshletVertices)
+            {
+                for (unsigned int a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; a++)
+                {
+                    unsigned int triangle = adjacency[a];
+                    if (used[triangle])
+                        continue;
+                    unsigned int added = newVertices(triangle);
+                    if (meshletVertices.size() + added > MESHLET_MAX_VERTICES)
+                        continue;
+                    glm::vec3 centroid = (positions[indices[triangle * 3]] + positions[indices[triangle * 3 + 1]] + positions[indices[triangle * 3 + 2]]) / 3.0f;
+                    float score = added + CONE_WEIGHT * (1.0f - glm::dot(triangleNormals[triangle], coneAxis))
+                                + DISTANCE_WEIGHT * glm::length(centroid - center) / std::max(extent, 1e-20f);
+                    if (score < bestScore)
+                    {
+                        bestScore = score;
+                        best = triangle;
+                    }
+                }
+            }
+        }
+
+        if (best == triangleCount)
+        {
+            // nothing adjacent fits: close the meshlet and start the next one at the first unused triangle
+            if (!meshletTriangles.empty())
+                finish();
+            while (seed < triangleCount && used[seed])
+                seed++;
+            if (seed == triangleCount)
+                break;
+            best = seed;
+        }
+
+        used[best] = true;
+        meshletTriangles.push_back((unsigned int)best);
+        normalSum += triangleNormals[best];
+        unsigned int current = (unsigned int)meshlets.size() + 1;
+        for (int k = 0; k < 3; k++)
+        {
+            unsigned int vertex = indices[best * 3 + k];
+            if (vertexMeshlet[vertex] != current)
+            {
+                vertexMeshlet[vertex] = current;
+                meshletVertices.push_back(vertex);
+                positionSum += positions[vertex];
+            }
+        }
+    }
+}
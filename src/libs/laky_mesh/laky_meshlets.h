@@ -0,0 +1,50 @@
+#ifndef MESHLETS_H
+#define MESHLETS_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+
+const unsigned int MESHLET_MAX_VERTICES = 64;   // distinct vertices a meshlet may use
+const unsigned int MESHLET_MAX_TRIANGLES = 124;
+
+// a cluster of neighboring triangles of a mesh, culled as a whole
+struct Meshlet
+{
+    unsigned int firstIndex;    // into the mesh's index list, which BuildMeshlets orders meshlet by meshlet
+    unsigned int triangleCount;
+    unsigned int vertexCount;   // distinct vertices used
+    unsigned int padding;
+    glm::vec4    sphere;        // local bounding sphere: xyz = center, w = radius
+    glm::vec4    cone;          // normal cone: xyz = axis, w = cutoff (sine of the cone's half angle), 1 = can't be back-face culled
+};
+
+// Splits an indexed triangle mesh into meshlets of at most
+// MESHLET_MAX_VERTICES vertices and MESHLET_MAX_TRIANGLES triangles.
+// A meshlet grows from a seed triangle, always taking the adjacent triangle
+// that adds the fewest new vertices, stays closest to its center and bends
+// its normal cone the least, so meshlets come out compact (tight spheres)
+// and flat (narrow cones that can be back-face culled). `reordered` gets
+// the same triangles as `indices`, meshlet by meshlet, windings kept.
+void BuildMeshlets(const std::vector<glm::vec3> &positions, const unsigned int *indices, size_t indexCount,
+                   std::vector<unsigned int> &reordered, std::vector<Meshlet> &meshlets);
+
+// true if every triangle of a meshlet faces away from a camera at `cameraPosition`: the normal cone, apex moved back to
+// cover the bounding sphere, points away from it. Sphere and cone in the same (world) space, see TransformCone
+inline bool MeshletBackFacing(const glm::vec4 &sphere, const glm::vec4 &cone, const glm::vec3 &cameraPosition)
+{
+    glm::vec3 toCenter = glm::vec3(sphere) - cameraPosition;
+    return cone.w < 1.0f && glm::dot(toCenter, glm::vec3(cone)) >= cone.w * glm::length(toCenter) + sphere.w;
+}
+
+// rotates a normal cone into world space (exact for rotations and uniform scales)
+inline glm::vec4 TransformCone(const glm::mat4 &model, const glm::vec4 &cone)
+{
+    glm::vec3 axis = glm::mat3(model) * glm::vec3(cone);
+    float length = glm::length(axis);
+    return length > 0.0f ? glm::vec4(axis / length, cone.w) : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+#endif
@@ -0,0 +1,864 @@
+// LAKY'S MESH LOADER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_meshloader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "../laky_jobs/laky_jobs.h"
+
+// smallest piece of an OBJ file worth a job of its own
+static const size_t MIN_CHUNK_BYTES = 256 * 1024;
+// vertices or indices written per job
+static const size_t WRITE_GRAIN = 64 * 1024;
+// marks an OBJ corner attribute that wasn't given
+static const unsigned int NO_INDEX = ~0u;
+// deepest nesting the glTF JSON may have
+static const int JSON_MAX_DEPTH = 64;
+
+// glTF component types (the GL enum values)
+static const unsigned int GLTF_UNSIGNED_BYTE = 5121;
+static const unsigned int GLTF_UNSIGNED_SHORT = 5123;
+static const unsigned int GLTF_UNSIGNED_INT = 5125;
+static const unsigned int GLTF_FLOAT = 5126;
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// TOKENIZING
+//------------------------------------------------------------------------------
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline const char *skipSpaces(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    return p;
+}
+
+// start of the next line
+static inline const char *skipLine(const char *p, const char *end)
+{
+    const char *newline = (const char *)memchr(p, '\n', end - p);
+    return newline ? newline + 1 : end;
+}
+
+// parses a decimal number the way exporters write them (sign, digits, fraction, exponent), without strtod's locale
+// lookups; anything else reads as 0. Returns the position after the number
+static const char *parseFloat(const char *p, const char *end, float &value)
+{
+    static const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    p = skipSpaces(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+
+    // the first 19 significant digits fit a 64 bit integer exactly, the rest only shift the exponent
+    unsigned long long digits = 0;
+    int significant = 0, exponent = 0;
+    for (; p < end && isDigit(*p); p++)
+    {
+        if (significant < 19)
+        {
+            digits = digits * 10 + (*p - '0');
+            significant += digits != 0;
+        }
+        else
+            exponent++;
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && isDigit(*p); p++)
+        {
+            if (significant < 19)
+            {
+                digits = digits * 10 + (*p - '0');
+                significant += digits != 0;
+                exponent--;
+            }
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negativeExponent = *p++ == '-';
+        int written = 0;
+        for (; p < end && isDigit(*p); p++)
+            written = std::min(written * 10 + (*p - '0'), 10000);
+        exponent += negativeExponent ? -written : written;
+    }
+
+    double result = (double)digits;
+    int magnitude = exponent < 0 ? -exponent : exponent;
+    double scale = magnitude <= 22 ? powersOf10[magnitude] : std::pow(10.0, magnitude);
+    result = exponent < 0 ? result / scale : result * scale;
+    value = (float)(negative ? -result : result);
+    return p;
+}
+
+// parses a signed integer, 0 when there is none
+static const char *parseInteger(const char *p, const char *end, long long &value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    long long result = 0;
+    for (; p < end && isDigit(*p); p++)
+        result = result * 10 + (*p - '0');
+    value = negative ? -result : result;
+    return p;
+}
+
+// OBJ indices are 1-based, negative ones count back from the last element read so far; ~0u if out of range
+static inline unsigned int resolveObjIndex(long long index, size_t readSoFar, size_t total)
+{
+    long long resolved = index > 0 ? index - 1 : (long long)readSoFar + index;
+    return index != 0 && resolved >= 0 && resolved < (long long)total ? (unsigned int)resolved : NO_INDEX;
+}
+
+// a JSON value: objects and arrays know their child count (an object's children are its keys, every key has its value
+// as its one child) and all tokens are stored depth first, like jsmn does it
+struct JsonToken
+{
+    enum Type { OBJECT, ARRAY, STRING, PRIMITIVE } type;
+    unsigned int start, end; // character range, strings without their quotes
+    unsigned int size;
+};
+
+// splits JSON into tokens without allocating, returns the token count or -1 if the JSON is malformed or has more
+// than `capacity` tokens (one per two characters always suffices)
+static int tokenizeJson(const char *json, size_t length, JsonToken *tokens, size_t capacity)
+{
+    // containers still open and the key whose value comes next, innermost last
+    int stack[JSON_MAX_DEPTH];
+    int depth = 0;
+    size_t count = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        char c = json[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',')
+            continue;
+        if (c == ':')
+        {
+            // the key just read owns the next value
+            if (count == 0 || tokens[count - 1].type != JsonToken::STRING || depth == JSON_MAX_DEPTH)
+                return -1;
+            stack[depth++] = (int)count - 1;
+            continue;
+        }
+        if (c == '}' || c == ']')
+        {
+            JsonToken::Type type = c == '}' ? JsonToken::OBJECT : JsonToken::ARRAY;
+            if (depth == 0 || tokens[stack[depth - 1]].type != type)
+                return -1;
+            tokens[stack[--depth]].end = (unsigned int)i + 1;
+        }
+        else
+        {
+            if (count == capacity)
+                return -1;
+            JsonToken &token = tokens[count];
+            token.size = 0;
+            token.start = (unsigned int)i;
+            if (c == '{' || c == '[')
+            {
+                token.type = c == '{' ? JsonToken::OBJECT : JsonToken::ARRAY;
+                if (depth > 0)
+                    tokens[stack[depth - 1]].size++;
+                if (depth == JSON_MAX_DEPTH)
+                    return -1;
+                stack[depth++] = (int)count++;
+                continue;
+            }
+            if (c == '"')
+            {
+                size_t close = i + 1;
+                while (close < length && json[close] != '"')
+                    close += json[close] == '\\' ? 2 : 1;
+                if (close >= length)
+                    return -1;
+                token.type = JsonToken::STRING;
+                token.start = (unsigned int)i + 1;
+                token.end = (unsigned int)close;
+                i = close;
+            }
+            else
+            {
+                size_t stop = i;
+                while (stop < length && json[stop] != ',' && json[stop] != '}' && json[stop] != ']' && json[stop] != ' '
+                       && json[stop] != '\t' && json[stop] != '\n' && json[stop] != '\r' && json[stop] != ':')
+                    stop++;
+                token.type = JsonToken::PRIMITIVE;
+                token.end = (unsigned int)stop;
+                i = stop - 1;
+            }
+            if (depth > 0)
+                tokens[stack[depth - 1]].size++;
+            count++;
+        }
+        // a finished value hands its key back
+        if (depth > 0 && tokens[stack[depth - 1]].type == JsonToken::STRING)
+            depth--;
+    }
+    return depth == 0 ? (int)count : -1;
+}
+
+// index of the token after a value and everything inside it
+static int jsonSkip(const JsonToken *tokens, int token)
+{
+    unsigned int pending = tokens[token].size;
+    int next = token + 1;
+    while (pending > 0)
+        pending += tokens[next++].size - 1;
+    return next;
+}
+
+static bool jsonEquals(const char *json, const JsonToken &token, const char *text)
+{
+    size_t length = strlen(text);
+    return token.type == JsonToken::STRING && token.end - token.start == length && memcmp(json + token.start, text, length) == 0;
+}
+
+// value of a key in an object, -1 if the object or the key isn't there
+static int jsonFind(const char *json, const JsonToken *tokens, int object, const char *key)
+{
+    if (object < 0 || tokens[object].type != JsonToken::OBJECT)
+        return -1;
+    int token = object + 1;
+    for (unsigned int i = 0; i < tokens[object].size; i++)
+    {
+        if (jsonEquals(json, tokens[token], key))
+            return token + 1;
+        token = jsonSkip(tokens, token);
+    }
+    return -1;
+}
+
+// element of an array, -1 if out of range
+static int jsonElement(const JsonToken *tokens, int array, unsigned int index)
+{
+    if (array < 0 || tokens[array].type != JsonToken::ARRAY || index >= tokens[array].size)
+        return -1;
+    int token = array + 1;
+    for (unsigned int i = 0; i < index; i++)
+        token = jsonSkip(tokens, token);
+    return token;
+}
+
+static long long jsonInteger(const char *json, const JsonToken *tokens, int token, long long fallback)
+{
+    if (token < 0 || tokens[token].type != JsonToken::PRIMITIVE)
+        return fallback;
+    long long value;
+    parseInteger(json + tokens[token].start, json + tokens[token].end, value);
+    return value;
+}
+
+// OBJ
+//------------------------------------------------------------------------------
+
+// what one chunk of an OBJ file holds, and after the prefix sum where its elements go
+struct ObjChunk
+{
+    const char *begin, *end;
+    size_t positions, texCoords, normals, triangles;
+};
+
+// counts the elements of a chunk
+static void countObjChunk(ObjChunk &chunk)
+{
+    chunk.positions = chunk.texCoords = chunk.normals = chunk.triangles = 0;
+    for (const char *line = chunk.begin; line < chunk.end; line = skipLine(line, chunk.end))
+    {
+        const char *p = skipSpaces(line, chunk.end);
+        if (chunk.end - p < 2)
+            continue;
+        if (p[0] == 'v')
+        {
+            if (p[1] == ' ' || p[1] == '\t')
+                chunk.positions++;
+            else if (p[1] == 't')
+                chunk.texCoords++;
+            else if (p[1] == 'n')
+                chunk.normals++;
+        }
+        else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+        {
+            // one corner per word, a polygon becomes a fan
+            unsigned int cornerCount = 0;
+            for (p += 2; p < chunk.end && *p != '\n'; )
+            {
+                p = skipSpaces(p, chunk.end);
+                if (p == chunk.end || *p == '\n' || *p == '\r')
+                    break;
+                cornerCount++;
+                while (p < chunk.end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+                    p++;
+            }
+            if (cornerCount >= 3)
+                chunk.triangles += cornerCount - 2;
+        }
+    }
+}
+
+MeshLoader::MeshLoader()
+    : isGlb(false), vertexCount(0), indexCount(0), boundsMin(0.0f), boundsMax(0.0f), boundsRadius(0.0f), stats()
+{
+}
+
+bool MeshLoader::Open(const std::string &path)
+{
+    Close();
+    auto start = std::chrono::steady_clock::now();
+    if (!file.Open(path))
+        return false;
+    stats = MeshLoadStats();
+    stats.fileBytes = file.Size();
+
+    size_t dot = path.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    bool loaded;
+    if (extension == "obj")
+        loaded = openObj(path);
+    else if (extension == "glb")
+        loaded = openGlb(path);
+    else
+    {
+        std::cout << "ERROR::MESH_LOADER: Unsupported mesh format: " << path << std::endl;
+        loaded = false;
+    }
+    if (!loaded)
+    {
+        Close();
+        return false;
+    }
+    computeBounds();
+    stats.parseMs = millisecondsSince(start);
+    return true;
+}
+
+bool MeshLoader::openObj(const std::string &path)
+{
+    isGlb = false;
+    const char *data = file.Data(), *end = data + file.Size();
+
+    // chunks end after a newline, so no line is split between two of them
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(JobSystem::ThreadCount() * 4, file.Size() / MIN_CHUNK_BYTES));
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char *begin = data;
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        const char *split = i + 1 == chunkCount ? end : std::max(begin, data + file.Size() * (i + 1) / chunkCount);
+        chunks[i].begin = begin;
+        chunks[i].end = split == end ? end : skipLine(split, end);
+        begin = chunks[i].end;
+    }
+    stats.chunks = (unsigned int)chunkCount;
+
+    JobSystem::ParallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            countObjChunk(chunks[i]);
+    });
+    // prefix sums: every chunk parses into its own slice of the arrays
+    size_t totalPositions = 0, totalTexCoords = 0, totalNormals = 0, totalTriangles = 0;
+    for (ObjChunk &chunk : chunks)
+    {
+        size_t counts[4] = { chunk.positions, chunk.texCoords, chunk.normals, chunk.triangles };
+        chunk.positions = totalPositions;
+        chunk.texCoords = totalTexCoords;
+        chunk.normals = totalNormals;
+        chunk.triangles = totalTriangles;
+        totalPositions += counts[0];
+        totalTexCoords += counts[1];
+        totalNormals += counts[2];
+        totalTriangles += counts[3];
+    }
+    if (totalTriangles == 0)
+    {
+        std::cout << "ERROR::MESH_LOADER: No faces in " << path << std::endl;
+        return false;
+    }
+    positions.resize(totalPositions);
+    texCoords.resize(totalTexCoords);
+    normals.resize(totalNormals);
+    corners.resize(totalTriangles * 3);
+
+    std::atomic<bool> badIndex(false);
+    JobSystem::ParallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+        {
+            const ObjChunk &chunk = chunks[i];
+            size_t position = chunk.positions, texCoord = chunk.texCoords, normal = chunk.normals;
+            ObjCorner *corner = &corners[chunk.triangles * 3];
+            for (const char *line = chunk.begin; line < chunk.end; line = skipLine(line, chunk.end))
+            {
+                const char *p = skipSpaces(line, chunk.end);
+                if (chunk.end - p < 2)
+                    continue;
+                if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+                {
+                    glm::vec3 &value = positions[position++];
+                    p = parseFloat(p + 1, chunk.end, value.x);
+                    p = parseFloat(p, chunk.end, value.y);
+                    parseFloat(p, chunk.end, value.z);
+                }
+                else if (p[0] == 'v' && p[1] == 't')
+                {
+                    glm::vec2 &value = texCoords[texCoord++];
+                    p = parseFloat(p + 2, chunk.end, value.x);
+                    parseFloat(p, chunk.end, value.y);
+                }
+                else if (p[0] == 'v' && p[1] == 'n')
+                {
+                    glm::vec3 &value = normals[normal++];
+                    p = parseFloat(p + 2, chunk.end, value.x);
+                    p = parseFloat(p, chunk.end, value.y);
+                    parseFloat(p, chunk.end, value.z);
+                }
+                else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+                {
+                    // v, v/vt, v//vn or v/vt/vn per corner, fanned out from the first one
+                    ObjCorner firstCorner, previous;
+                    unsigned int cornerCount = 0;
+                    for (p += 2; ; cornerCount++)
+                    {
+                        p = skipSpaces(p, chunk.end);
+                        if (p == chunk.end || *p == '\n' || *p == '\r')
+                            break;
+                        long long index;
+                        ObjCorner current = { NO_INDEX, NO_INDEX, NO_INDEX };
+                        p = parseInteger(p, chunk.end, index);
+                        current.position = resolveObjIndex(index, position, totalPositions);
+                        if (p < chunk.end && *p == '/')
+                        {
+                            p++;
+                            if (p < chunk.end && *p != '/')
+                            {
+                                p = parseInteger(p, chunk.end, index);
+                                current.texCoord = resolveObjIndex(index, texCoord, totalTexCoords);
+                            }
+                            if (p < chunk.end && *p == '/')
+                            {
+                                p = parseInteger(p + 1, chunk.end, index);
+                                current.normal = resolveObjIndex(index, normal, totalNormals);
+                            }
+                        }
+                        while (p < chunk.end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+                            p++;
+                        if (current.position == NO_INDEX)
+                            badIndex = true;
+                        if (cornerCount == 0)
+                            firstCorner = current;
+                        else if (cornerCount >= 2)
+                        {
+                            *corner++ = firstCorner;
+                            *corner++ = previous;
+                            *corner++ = current;
+                        }
+                        previous = current;
+                    }
+                }
+            }
+        }
+    });
+    if (badIndex)
+    {
+        std::cout << "ERROR::MESH_LOADER: Face refers to a missing vertex in " << path << std::endl;
+        return false;
+    }
+
+    // without normals in the file every position gets the area weighted average of its faces' normals
+    if (normals.empty())
+    {
+        normals.assign(positions.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i < corners.size(); i += 3)
+        {
+            const glm::vec3 &a = positions[corners[i].position], &b = positions[corners[i + 1].position], &c = positions[corners[i + 2].position];
+            glm::vec3 faceNormal = glm::cross(b - a, c - a);
+            for (int k = 0; k < 3; k++)
+                normals[corners[i + k].position] += faceNormal;
+        }
+        JobSystem::ParallelFor(normals.size(), WRITE_GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                float length = glm::length(normals[i]);
+                normals[i] = length > 0.0f ? normals[i] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        });
+        for (ObjCorner &corner : corners)
+            corner.normal = corner.position;
+    }
+
+    // corners with the same position, texture coordinate and normal become one vertex; the candidates for a
+    // corner are chained per position, so the lookup only compares corners at the same spot
+    std::vector<unsigned int> firstAtPosition(positions.size(), NO_INDEX), nextAtPosition;
+    nextAtPosition.reserve(corners.size() / 4);
+    uniqueCorners.reserve(corners.size() / 4);
+    indices.resize(corners.size());
+    for (size_t i = 0; i < corners.size(); i++)
+    {
+        const ObjCorner &corner = corners[i];
+        unsigned int vertex = firstAtPosition[corner.position];
+        while (vertex != NO_INDEX && (uniqueCorners[vertex].texCoord != corner.texCoord || uniqueCorners[vertex].normal != corner.normal))
+            vertex = nextAtPosition[vertex];
+        if (vertex == NO_INDEX)
+        {
+            vertex = (unsigned int)uniqueCorners.size();
+            uniqueCorners.push_back(corner);
+            nextAtPosition.push_back(firstAtPosition[corner.position]);
+            firstAtPosition[corner.position] = vertex;
+        }
+        indices[i] = vertex;
+    }
+    std::vector<ObjCorner>().swap(corners);
+    vertexCount = uniqueCorners.size();
+    indexCount = indices.size();
+    return true;
+}
+
+// GLB
+//------------------------------------------------------------------------------
+
+static unsigned int componentSize(unsigned int componentType)
+{
+    switch (componentType)
+    {
+        case 5120: case GLTF_UNSIGNED_BYTE: return 1;
+        case 5122: case GLTF_UNSIGNED_SHORT: return 2;
+        case GLTF_UNSIGNED_INT: case GLTF_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+// reads a little-endian 32 bit value from anywhere
+static inline unsigned int readUint32(const char *p)
+{
+    unsigned int value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+bool MeshLoader::openGlb(const std::string &path)
+{
+    isGlb = true;
+    const char *data = file.Data();
+    size_t size = file.Size();
+    // 12 byte header, then the JSON chunk and the (optional) binary chunk, each with an 8 byte chunk header
+    if (size < 20 || memcmp(data, "glTF", 4) != 0 || readUint32(data + 4) != 2 || readUint32(data + 16) != 0x4E4F534A)
+    {
+        std::cout << "ERROR::MESH_LOADER: Not a glTF 2.0 binary: " << path << std::endl;
+        return false;
+    }
+    size_t jsonLength = readUint32(data + 12);
+    const char *json = data + 20;
+    const char *bin = NULL;
+    size_t binLength = 0;
+    size_t binHeader = 20 + ((jsonLength + 3) & ~(size_t)3);
+    if (20 + jsonLength > size)
+    {
+        std::cout << "ERROR::MESH_LOADER: Truncated glTF binary: " << path << std::endl;
+        return false;
+    }
+    if (binHeader + 8 <= size && readUint32(data + binHeader + 4) == 0x004E4942)
+    {
+        binLength = std::min<size_t>(readUint32(data + binHeader), size - binHeader - 8);
+        bin = data + binHeader + 8;
+    }
+
+    std::vector<JsonToken> tokens(jsonLength / 2 + 2);
+    int tokenCount = tokenizeJson(json, jsonLength, tokens.data(), tokens.size());
+    if (tokenCount <= 0 || tokens[0].type != JsonToken::OBJECT)
+    {
+        std::cout << "ERROR::MESH_LOADER: Malformed glTF JSON in " << path << std::endl;
+        return false;
+    }
+    int accessors = jsonFind(json, tokens.data(), 0, "accessors");
+    int bufferViews = jsonFind(json, tokens.data(), 0, "bufferViews");
+
+    // an accessor of the binary chunk, checked against its size; components = 0 takes whatever the accessor has
+    auto readAccessor = [&](int index, GlbAccessor &accessor) -> bool {
+        accessor.data = NULL;
+        accessor.count = 0;
+        int token = index >= 0 ? jsonElement(tokens.data(), accessors, (unsigned int)index) : -1;
+        long long viewIndex = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), token, "bufferView"), -1);
+        int view = viewIndex >= 0 && viewIndex <= 0xffffffffll ? jsonElement(tokens.data(), bufferViews, (unsigned int)viewIndex) : -1;
+        int type = jsonFind(json, tokens.data(), token, "type");
+        if (token < 0 || view < 0 || type < 0 || bin == NULL || jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), view, "buffer"), 0) != 0)
+            return false;
+        accessor.components = jsonEquals(json, tokens[type], "SCALAR") ? 1 : jsonEquals(json, tokens[type], "VEC2") ? 2
+                            : jsonEquals(json, tokens[type], "VEC3") ? 3 : jsonEquals(json, tokens[type], "VEC4") ? 4 : 0;
+        accessor.componentType = (unsigned int)jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), token, "componentType"), 0);
+        size_t elementSize = componentSize(accessor.componentType) * accessor.components;
+        long long count = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), token, "count"), 0);
+        long long accessorOffset = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), token, "byteOffset"), 0);
+        long long viewOffset = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), view, "byteOffset"), 0);
+        long long viewLength = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), view, "byteLength"), 0);
+        long long stride = jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), view, "byteStride"), (long long)elementSize);
+        if (elementSize == 0 || count <= 0 || accessorOffset < 0 || viewOffset < 0 || viewLength < 0 || stride < (long long)elementSize)
+            return false;
+
+        // the view has to lie in the binary chunk and the accessor in the view, compared so that nothing can wrap around
+        if ((unsigned long long)viewOffset > binLength || (unsigned long long)viewLength > binLength - viewOffset || accessorOffset > viewLength)
+            return false;
+        size_t available = (size_t)(viewLength - accessorOffset);
+        if (elementSize > available || (unsigned long long)(count - 1) > (available - elementSize) / (unsigned long long)stride)
+            return false;
+        accessor.count = (size_t)count;
+        accessor.stride = (size_t)stride;
+        accessor.data = bin + viewOffset + accessorOffset;
+        return true;
+    };
+
+    int meshes = jsonFind(json, tokens.data(), 0, "meshes");
+    unsigned int meshCount = meshes >= 0 ? tokens[meshes].size : 0;
+    vertexCount = indexCount = 0;
+    for (unsigned int m = 0; m < meshCount; m++)
+    {
+        int primitiveArray = jsonFind(json, tokens.data(), jsonElement(tokens.data(), meshes, m), "primitives");
+        unsigned int primitiveCount = primitiveArray >= 0 ? tokens[primitiveArray].size : 0;
+        for (unsigned int p = 0; p < primitiveCount; p++)
+        {
+            int primitive = jsonElement(tokens.data(), primitiveArray, p);
+            // triangle lists only, points and lines have no surface
+            if (jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), primitive, "mode"), 4) != 4)
+                continue;
+            int attributes = jsonFind(json, tokens.data(), primitive, "attributes");
+            int position = (int)jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), attributes, "POSITION"), -1);
+            int normal = (int)jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), attributes, "NORMAL"), -1);
+            int texCoord = (int)jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), attributes, "TEXCOORD_0"), -1);
+            int index = (int)jsonInteger(json, tokens.data(), jsonFind(json, tokens.data(), primitive, "indices"), -1);
+
+            GlbPrimitive loaded;
+            if (!readAccessor(position, loaded.position) || loaded.position.componentType != GLTF_FLOAT || loaded.position.components != 3)
+            {
+                std::cout << "ERROR::MESH_LOADER: Primitive " << p << " of mesh " << m << " has no usable positions in " << path << std::endl;
+                return false;
+            }
+            // the optional attributes are dropped when they come in a form we don't read
+            if (normal < 0 || !readAccessor(normal, loaded.normal) || loaded.normal.componentType != GLTF_FLOAT || loaded.normal.components != 3
+                || loaded.normal.count != loaded.position.count)
+                loaded.normal.data = NULL;
+            if (texCoord < 0 || !readAccessor(texCoord, loaded.texCoord) || loaded.texCoord.components != 2 || loaded.texCoord.count != loaded.position.count
+                || (loaded.texCoord.componentType != GLTF_FLOAT && loaded.texCoord.componentType != GLTF_UNSIGNED_BYTE && loaded.texCoord.componentType != GLTF_UNSIGNED_SHORT))
+                loaded.texCoord.data = NULL;
+            if (index >= 0)
+            {
+                if (!readAccessor(index, loaded.indices) || loaded.indices.components != 1 || loaded.indices.componentType == GLTF_FLOAT)
+                {
+                    std::cout << "ERROR::MESH_LOADER: Primitive " << p << " of mesh " << m << " has unreadable indices in " << path << std::endl;
+                    return false;
+                }
+            }
+            else
+            {
+                // unindexed: every three vertices are a triangle
+                loaded.indices.data = NULL;
+                loaded.indices.count = loaded.position.count;
+            }
+            loaded.firstVertex = vertexCount;
+            loaded.firstIndex = indexCount;
+            vertexCount += loaded.position.count;
+            indexCount += loaded.indices.count / 3 * 3;
+            primitives.push_back(loaded);
+        }
+    }
+    if (indexCount == 0)
+    {
+        std::cout << "ERROR::MESH_LOADER: No triangles in " << path << std::endl;
+        return false;
+    }
+
+    // primitives without normals get smooth ones, averaged over their faces
+    for (const GlbPrimitive &primitive : primitives)
+    {
+        if (primitive.normal.data != NULL)
+            continue;
+        if (normals.empty())
+            normals.assign(vertexCount, glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < primitive.indices.count; i += 3)
+        {
+            size_t corner[3];
+            glm::vec3 corners[3];
+            for (int k = 0; k < 3; k++)
+            {
+                const char *source = primitive.indices.data + (i + k) * primitive.indices.stride;
+                corner[k] = primitive.indices.data == NULL ? i + k
+                          : primitive.indices.componentType == GLTF_UNSIGNED_BYTE ? (size_t)*(const unsigned char *)source
+                          : primitive.indices.componentType == GLTF_UNSIGNED_SHORT ? (size_t)(unsigned char)source[0] | (size_t)(unsigned char)source[1] << 8
+                          : (size_t)readUint32(source);
+                corner[k] = std::min(corner[k], primitive.position.count - 1);
+                memcpy(&corners[k], primitive.position.data + corner[k] * primitive.position.stride, sizeof(glm::vec3));
+            }
+            glm::vec3 faceNormal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            for (int k = 0; k < 3; k++)
+                normals[primitive.firstVertex + corner[k]] += faceNormal;
+        }
+        for (size_t v = 0; v < primitive.position.count; v++)
+        {
+            glm::vec3 &normal = normals[primitive.firstVertex + v];
+            float length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+    stats.chunks = (unsigned int)primitives.size();
+    return true;
+}
+
+// WRITING
+//------------------------------------------------------------------------------
+
+void MeshLoader::Write(Vertex *vertices, unsigned int *indices)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (!isGlb)
+    {
+        JobSystem::ParallelFor(uniqueCorners.size(), WRITE_GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++)
+            {
+                const ObjCorner &corner = uniqueCorners[i];
+                Vertex vertex;
+                vertex.position = positions[corner.position];
+                vertex.normal = corner.normal != NO_INDEX ? normals[corner.normal] : glm::vec3(0.0f);
+                vertex.texCoords = corner.texCoord != NO_INDEX ? texCoords[corner.texCoord] : glm::vec2(0.0f);
+                vertices[i] = vertex;
+            }
+        });
+        JobSystem::ParallelFor(this->indices.size(), WRITE_GRAIN, [&](size_t first, size_t last) {
+            memcpy(indices + first, this->indices.data() + first, (last - first) * sizeof(unsigned int));
+        });
+    }
+    else
+    {
+        for (const GlbPrimitive &primitive : primitives)
+        {
+            JobSystem::ParallelFor(primitive.position.count, WRITE_GRAIN, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; i++)
+                {
+                    Vertex vertex;
+                    memcpy(&vertex.position, primitive.position.data + i * primitive.position.stride, sizeof(glm::vec3));
+                    if (primitive.normal.data != NULL)
+                        memcpy(&vertex.normal, primitive.normal.data + i * primitive.normal.stride, sizeof(glm::vec3));
+                    else
+                        vertex.normal = normals[primitive.firstVertex + i];
+                    vertex.texCoords = glm::vec2(0.0f);
+                    if (primitive.texCoord.data != NULL)
+                    {
+                        const char *texCoord = primitive.texCoord.data + i * primitive.texCoord.stride;
+                        if (primitive.texCoord.componentType == GLTF_FLOAT)
+                            memcpy(&vertex.texCoords, texCoord, sizeof(glm::vec2));
+                        else if (primitive.texCoord.componentType == GLTF_UNSIGNED_BYTE)
+                            vertex.texCoords = glm::vec2((unsigned char)texCoord[0], (unsigned char)texCoord[1]) / 255.0f;
+                        else
+                        {
+                            unsigned short uv[2];
+                            memcpy(uv, texCoord, sizeof(uv));
+                            vertex.texCoords = glm::vec2(uv[0], uv[1]) / 65535.0f;
+                        }
+                    }
+                    // glTF puts the texture origin at the top left, the textures here are loaded flipped for GL
+                    vertex.texCoords.y = 1.0f - vertex.texCoords.y;
+                    vertices[primitive.firstVertex + i] = vertex;
+                }
+            });
+            size_t triangleIndices = primitive.indices.count / 3 * 3;
+            unsigned int base = (unsigned int)primitive.firstVertex, last = (unsigned int)primitive.position.count - 1;
+            JobSystem::ParallelFor(triangleIndices, WRITE_GRAIN, [&](size_t first, size_t end) {
+                unsigned int *target = indices + primitive.firstIndex;
+                const GlbAccessor &source = primitive.indices;
+                for (size_t i = first; i < end; i++)
+                {
+                    unsigned int index;
+                    if (source.data == NULL)
+                        index = (unsigned int)i;
+                    else if (source.componentType == GLTF_UNSIGNED_BYTE)
+                        index = *(const unsigned char *)(source.data + i * source.stride);
+                    else if (source.componentType == GLTF_UNSIGNED_SHORT)
+                    {
+                        unsigned short value;
+                        memcpy(&value, source.data + i * source.stride, sizeof(value));
+                        index = value;
+                    }
+                    else
+                        index = readUint32(source.data + i * source.stride);
+                    // a broken index must not read outside the primitive's vertices
+                    target[i] = base + std::min(index, last);
+                }
+            });
+        }
+    }
+    stats.writeMs = millisecondsSince(start);
+}
+
+void MeshLoader::Close()
+{
+    file.Close();
+    vertexCount = indexCount = 0;
+    positions.clear();
+    positions.shrink_to_fit();
+    normals.clear();
+    normals.shrink_to_fit();
+    texCoords.clear();
+    texCoords.shrink_to_fit();
+    corners.clear();
+    corners.shrink_to_fit();
+    uniqueCorners.clear();
+    uniqueCorners.shrink_to_fit();
+    indices.clear();
+    indices.shrink_to_fit();
+    primitives.clear();
+}
+
+void MeshLoader::computeBounds()
+{
+    boundsMin = glm::vec3(FLT_MAX);
+    boundsMax = glm::vec3(-FLT_MAX);
+    boundsRadius = 0.0f;
+    if (!isGlb)
+    {
+        for (const glm::vec3 &position : positions)
+        {
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        for (const glm::vec3 &position : positions)
+            boundsRadius = std::max(boundsRadius, glm::length(position - center));
+        return;
+    }
+    glm::vec3 position;
+    for (const GlbPrimitive &primitive : primitives)
+    {
+        for (size_t i = 0; i < primitive.position.count; i++)
+        {
+            memcpy(&position, primitive.position.data + i * primitive.position.stride, sizeof(glm::vec3));
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+    }
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    for (const GlbPrimitive &primitive : primitives)
+    {
+        for (size_t i = 0; i < primitive.position.count; i++)
+        {
+            memcpy(&position, primitive.position.data + i * primitive.position.stride, sizeof(glm::vec3));
+            boundsRadius = std::max(boundsRadius, glm::length(position - center));
+        }
+    }
+}
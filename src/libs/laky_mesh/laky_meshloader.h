@@ -0,0 +1,94 @@
+#ifndef MESH_LOADER_H
+#define MESH_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "laky_mappedfile.h"
+#include "laky_vertex.h"
+
+
+// timings of the last MeshLoader::Open() / Write()
+struct MeshLoadStats
+{
+    size_t       fileBytes;
+    unsigned int chunks;  // pieces the file was parsed in, one job each
+    double       parseMs; // mapping, tokenizing and building the vertex list
+    double       writeMs; // writing the vertices and indices out
+};
+
+// MeshLoader reads Wavefront OBJ and binary glTF 2.0 (.glb) meshes. The file
+// is memory mapped and tokenized in place by hand-written number parsers
+// that never allocate. OBJ files are split at line boundaries into chunks
+// that are counted and then parsed in parallel on the JobSystem, each chunk
+// writing straight into its slice of arrays sized by the counting pass;
+// face corners (position/texcoord/normal triplets) are then merged into
+// unique vertices. A .glb's binary chunk already holds the vertex data, so
+// only the JSON chunk is parsed and the accessors are read in place.
+// Write() interleaves everything straight into the destination (mapped
+// buffer ranges from MeshArena::Reserve), with no copy of the vertices in
+// between. All primitives of all meshes in a glTF end up in one mesh, node
+// transforms are not applied; OBJ groups and materials are ignored.
+class MeshLoader
+{
+public:
+    MeshLoader();
+    // maps and parses a .obj or .glb file (by extension), prints an error and returns false if it can't be read
+    bool Open(const std::string &path);
+    // size of the mesh, for reserving the destination
+    size_t VertexCount() const { return vertexCount; }
+    size_t IndexCount() const { return indexCount; }
+    // local bounding box, and the radius of the bounding sphere around its center
+    const glm::vec3 &BoundsMin() const { return boundsMin; }
+    const glm::vec3 &BoundsMax() const { return boundsMax; }
+    float BoundsRadius() const { return boundsRadius; }
+    // writes the vertices and the indices (relative to the first vertex) of the opened mesh, in parallel
+    void Write(Vertex *vertices, unsigned int *indices);
+    // unmaps the file and frees the parse state
+    void Close();
+    const MeshLoadStats &Stats() const { return stats; }
+private:
+    // an OBJ face corner: position, texture coordinate and normal index, ~0u = not given
+    struct ObjCorner
+    {
+        unsigned int position, texCoord, normal;
+    };
+    // a glTF accessor read in place from the binary chunk
+    struct GlbAccessor
+    {
+        const char  *data;          // NULL = absent
+        size_t       stride;
+        size_t       count;
+        unsigned int componentType; // GL enum values, as glTF uses them
+        unsigned int components;
+    };
+    struct GlbPrimitive
+    {
+        GlbAccessor  position, normal, texCoord, indices;
+        size_t       firstVertex, firstIndex;
+    };
+
+    MappedFile   file;
+    bool         isGlb;
+    size_t       vertexCount, indexCount;
+    glm::vec3    boundsMin, boundsMax;
+    float        boundsRadius;
+    MeshLoadStats stats;
+
+    // OBJ attribute streams, corners of the triangulated faces and the unique corners that become vertices
+    std::vector<glm::vec3>    positions, normals;
+    std::vector<glm::vec2>    texCoords;
+    std::vector<ObjCorner>    corners, uniqueCorners;
+    std::vector<unsigned int> indices;
+    std::vector<GlbPrimitive> primitives;
+
+    bool openObj(const std::string &path);
+    bool openGlb(const std::string &path);
+    // fills in the bounds from positions[] (OBJ) or the POSITION accessors (glb)
+    void computeBounds();
+};
+
+#endif
@@ -0,0 +1,309 @@
+// LAKY'S OCCLUSION CULLER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_occlusion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LAKY_OCCLUSION_SSE
+#include <emmintrin.h>
+#endif
+
+#include "../laky_jobs/laky_jobs.h"
+
+// elapsed milliseconds since `start`
+static double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+OcclusionCuller::OcclusionCuller(unsigned int width, unsigned int height)
+    : width((width + 3) & ~3u), height(height), viewProjection(1.0f), lastVertexCount(0), lastIndexCount(0)
+{
+    this->tilesX = (this->width + TILE_WIDTH - 1) / TILE_WIDTH;
+    this->tilesY = (this->height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+
+    // the pyramid halves (rounding up) until a single texel covers the screen
+    unsigned int levelWidth = this->width, levelHeight = this->height;
+    for (;;)
+    {
+        levels.push_back(std::vector<float>((size_t)levelWidth * levelHeight, 1.0f));
+        levelWidths.push_back(levelWidth);
+        levelHeights.push_back(levelHeight);
+        if (levelWidth == 1 && levelHeight == 1)
+            break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+    stats = OcclusionStats();
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4 &viewProjection)
+{
+    this->viewProjection = viewProjection;
+    // last frame's arrays went with its arena, the new ones start as large as those were
+    FrameVector<glm::vec4>().swap(clipVertices);
+    FrameVector<unsigned int>().swap(clipIndices);
+    clipVertices.reserve(lastVertexCount);
+    clipIndices.reserve(lastIndexCount);
+    stats = OcclusionStats();
+}
+
+void OcclusionCuller::AddOccluder(const glm::vec3 *positions, size_t vertexCount, const unsigned int *indices, size_t indexCount, const glm::mat4 &model)
+{
+    glm::mat4 modelViewProjection = viewProjection * model;
+    unsigned int base = (unsigned int)clipVertices.size();
+    for (size_t i = 0; i < vertexCount; i++)
+        clipVertices.push_back(modelViewProjection * glm::vec4(positions[i], 1.0f));
+    for (size_t i = 0; i < indexCount; i++)
+        clipIndices.push_back(base + indices[i]);
+    stats.occluderTriangles += (unsigned int)(indexCount / 3);
+}
+
+void OcclusionCuller::Rasterize()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    lastVertexCount = clipVertices.size();
+    lastIndexCount = clipIndices.size();
+    setupTriangles();
+    stats.transformMs = millisecondsSince(start);
+
+    // tiles never overlap, so they can be cleared and rasterized on any thread without locking
+    start = std::chrono::steady_clock::now();
+    JobSystem::ParallelFor(tilesX * tilesY, 1, [this](size_t begin, size_t end) {
+        for (size_t tile = begin; tile < end; tile++)
+            rasterizeTile((unsigned int)tile);
+    });
+    stats.rasterMs = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned int level = 1; level < levels.size(); level++)
+        buildLevel(level);
+    stats.hizMs = millisecondsSince(start);
+}
+
+bool OcclusionCuller::IsVisible(const glm::vec3 &boxMin, const glm::vec3 &boxMax, const glm::mat4 &model) const
+{
+    glm::mat4 modelViewProjection = viewProjection * model;
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, minDepth = 1e30f;
+    for (int corner = 0; corner < 8; corner++)
+    {
+        glm::vec3 position((corner & 1) ? boxMax.x : boxMin.x, (corner & 2) ? boxMax.y : boxMin.y, (corner & 4) ? boxMax.z : boxMin.z);
+        glm::vec4 clip = modelViewProjection * glm::vec4(position, 1.0f);
+        // crossing the near plane, the projected rectangle would be meaningless
+        if (clip.w <= 1e-5f || clip.z < -clip.w)
+            return true;
+
+        float x = (clip.x / clip.w * 0.5f + 0.5f) * width;
+        float y = (clip.y / clip.w * 0.5f + 0.5f) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minDepth = std::min(minDepth, clip.z / clip.w * 0.5f + 0.5f);
+    }
+
+    // off screen boxes are the frustum culler's business
+    if (maxX < 0.0f || maxY < 0.0f || minX >= (float)width || minY >= (float)height)
+        return true;
+
+    // occluders only cover pixels whose centers they contain, so grow the rectangle by a pixel to
+    // make sure a partially covered pixel at the occluder's silhouette gets looked at as well
+    int x0 = std::max((int)std::floor(minX) - 1, 0), x1 = std::min((int)std::floor(maxX) + 1, (int)width - 1);
+    int y0 = std::max((int)std::floor(minY) - 1, 0), y1 = std::min((int)std::floor(maxY) + 1, (int)height - 1);
+
+    // coarsest level where the rectangle still touches at most 2x2 texels
+    unsigned int level = 0;
+    while (level + 1 < levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        level++;
+
+    const std::vector<float> &depth = levels[level];
+    unsigned int levelWidth = levelWidths[level];
+    for (int y = y0 >> level; y <= (y1 >> level); y++)
+    {
+        for (int x = x0 >> level; x <= (x1 >> level); x++)
+        {
+            if (depth[(size_t)y * levelWidth + x] >= minDepth)
+                return true;
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::setupTriangles()
+{
+    FrameVector<Triangle>().swap(triangles);
+    triangles.reserve(clipIndices.size() / 3);
+
+    for (size_t i = 0; i + 2 < clipIndices.size(); i += 3)
+    {
+        const glm::vec4 *clip[3] = { &clipVertices[clipIndices[i]], &clipVertices[clipIndices[i + 1]], &clipVertices[clipIndices[i + 2]] };
+
+        // no clipping: occluders crossing the near plane are dropped (that only means less occlusion), fully outside ones are skipped
+        bool crossesNear = false;
+        int outside[4] = { 0, 0, 0, 0 };
+        for (int v = 0; v < 3; v++)
+        {
+            const glm::vec4 &c = *clip[v];
+            crossesNear = crossesNear || c.w <= 1e-5f || c.z < -c.w;
+            outside[0] += c.x < -c.w;
+            outside[1] += c.x > c.w;
+            outside[2] += c.y < -c.w;
+            outside[3] += c.y > c.w;
+        }
+        if (crossesNear || outside[0] == 3 || outside[1] == 3 || outside[2] == 3 || outside[3] == 3)
+            continue;
+
+        float x[3], y[3], z[3];
+        for (int v = 0; v < 3; v++)
+        {
+            float inverseW = 1.0f / clip[v]->w;
+            x[v] = (clip[v]->x * inverseW * 0.5f + 0.5f) * width;
+            y[v] = (clip[v]->y * inverseW * 0.5f + 0.5f) * height;
+            z[v] = clip[v]->z * inverseW * 0.5f + 0.5f;
+        }
+
+        float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        if (std::fabs(area) < 1e-8f)
+            continue;
+
+        Triangle triangle;
+        // both windings are rasterized, occluders don't have to be closed or consistently wound
+        float sign = area > 0.0f ? 1.0f : -1.0f;
+        for (int e = 0; e < 3; e++)
+        {
+            int a = e, b = (e + 1) % 3;
+            triangle.edgeA[e] = sign * (y[a] - y[b]);
+            triangle.edgeB[e] = sign * (x[b] - x[a]);
+            triangle.edgeC[e] = sign * (x[a] * y[b] - y[a] * x[b]);
+        }
+        triangle.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+        triangle.depthB = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+        triangle.depthC = z[0] - triangle.depthA * x[0] - triangle.depthB * y[0];
+
+        triangle.minX = std::max((int)std::floor(std::min(x[0], std::min(x[1], x[2]))), 0);
+        triangle.maxX = std::min((int)std::floor(std::max(x[0], std::max(x[1], x[2]))), (int)width - 1);
+        triangle.minY = std::max((int)std::floor(std::min(y[0], std::min(y[1], y[2]))), 0);
+        triangle.maxY = std::min((int)std::floor(std::max(y[0], std::max(y[1], y[2]))), (int)height - 1);
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+            continue;
+
+        triangles.push_back(triangle);
+    }
+    stats.rasterTriangles = (unsigned int)triangles.size();
+
+    // count the triangles overlapping every tile, then fill the tiles' ranges of one shared list in triangle order
+    FrameVector<unsigned int>(tilesX * tilesY + 1, 0).swap(binOffsets);
+    for (const Triangle &triangle : triangles)
+    {
+        for (int tileY = triangle.minY / (int)TILE_HEIGHT; tileY <= triangle.maxY / (int)TILE_HEIGHT; tileY++)
+        {
+            for (int tileX = triangle.minX / (int)TILE_WIDTH; tileX <= triangle.maxX / (int)TILE_WIDTH; tileX++)
+                binOffsets[tileY * tilesX + tileX + 1]++;
+        }
+    }
+    for (unsigned int tile = 0; tile < tilesX * tilesY; tile++)
+        binOffsets[tile + 1] += binOffsets[tile];
+    FrameVector<unsigned int>(binOffsets.back()).swap(binTriangles);
+    FrameVector<unsigned int> cursor(binOffsets.begin(), binOffsets.end() - 1);
+    for (unsigned int index = 0; index < triangles.size(); index++)
+    {
+        const Triangle &triangle = triangles[index];
+        for (int tileY = triangle.minY / (int)TILE_HEIGHT; tileY <= triangle.maxY / (int)TILE_HEIGHT; tileY++)
+        {
+            for (int tileX = triangle.minX / (int)TILE_WIDTH; tileX <= triangle.maxX / (int)TILE_WIDTH; tileX++)
+                binTriangles[cursor[tileY * tilesX + tileX]++] = index;
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTile(unsigned int tile)
+{
+    int tileX0 = (int)((tile % tilesX) * TILE_WIDTH);
+    int tileY0 = (int)((tile / tilesX) * TILE_HEIGHT);
+    int tileX1 = std::min(tileX0 + (int)TILE_WIDTH, (int)width) - 1;
+    int tileY1 = std::min(tileY0 + (int)TILE_HEIGHT, (int)height) - 1;
+    std::vector<float> &depth = levels[0];
+
+    for (int y = tileY0; y <= tileY1; y++)
+        std::fill(depth.begin() + (size_t)y * width + tileX0, depth.begin() + (size_t)y * width + tileX1 + 1, 1.0f);
+
+    for (unsigned int bin = binOffsets[tile]; bin < binOffsets[tile + 1]; bin++)
+    {
+        const Triangle &triangle = triangles[binTriangles[bin]];
+        // start on a 4 pixel boundary, tiles are multiples of 4 wide so a block never leaves the tile
+        int x0 = std::max(triangle.minX, tileX0) & ~3;
+        int x1 = std::min(triangle.maxX, tileX1);
+        int y0 = std::max(triangle.minY, tileY0);
+        int y1 = std::min(triangle.maxY, tileY1);
+
+        for (int y = y0; y <= y1; y++)
+        {
+            float centerY = y + 0.5f;
+            float *row = &depth[(size_t)y * width];
+#ifdef LAKY_OCCLUSION_SSE
+            __m128 edgeRow0 = _mm_set1_ps(triangle.edgeB[0] * centerY + triangle.edgeC[0]);
+            __m128 edgeRow1 = _mm_set1_ps(triangle.edgeB[1] * centerY + triangle.edgeC[1]);
+            __m128 edgeRow2 = _mm_set1_ps(triangle.edgeB[2] * centerY + triangle.edgeC[2]);
+            __m128 depthRow = _mm_set1_ps(triangle.depthB * centerY + triangle.depthC);
+            __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+            __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+            __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+            __m128 depthA = _mm_set1_ps(triangle.depthA);
+            __m128 zero = _mm_setzero_ps();
+            for (int x = x0; x <= x1; x += 4)
+            {
+                __m128 centerX = _mm_add_ps(_mm_set1_ps((float)x), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, centerX), edgeRow0);
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, centerX), edgeRow1);
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, centerX), edgeRow2);
+                __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0)
+                    continue;
+
+                __m128 z = _mm_add_ps(_mm_mul_ps(depthA, centerX), depthRow);
+                __m128 old = _mm_loadu_ps(row + x);
+                __m128 nearest = _mm_min_ps(old, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+            }
+#else
+            for (int x = x0; x <= x1; x++)
+            {
+                float centerX = x + 0.5f;
+                bool inside = true;
+                for (int e = 0; e < 3; e++)
+                    inside = inside && triangle.edgeA[e] * centerX + triangle.edgeB[e] * centerY + triangle.edgeC[e] >= 0.0f;
+                if (!inside)
+                    continue;
+                float z = triangle.depthA * centerX + triangle.depthB * centerY + triangle.depthC;
+                row[x] = std::min(row[x], z);
+            }
+#endif
+        }
+    }
+}
+
+void OcclusionCuller::buildLevel(unsigned int level)
+{
+    const std::vector<float> &source = levels[level - 1];
+    std::vector<float> &target = levels[level];
+    unsigned int sourceWidth = levelWidths[level - 1], sourceHeight = levelHeights[level - 1];
+    unsigned int targetWidth = levelWidths[level], targetHeight = levelHeights[level];
+
+    for (unsigned int y = 0; y < targetHeight; y++)
+    {
+        unsigned int y0 = y * 2, y1 = std::min(y * 2 + 1, sourceHeight - 1);
+        for (unsigned int x = 0; x < targetWidth; x++)
+        {
+            unsigned int x0 = x * 2, x1 = std::min(x * 2 + 1, sourceWidth - 1);
+            float farthest = std::max(std::max(source[(size_t)y0 * sourceWidth + x0], source[(size_t)y0 * sourceWidth + x1]),
+                                      std::max(source[(size_t)y1 * sourceWidth + x0], source[(size_t)y1 * sourceWidth + x1]));
+            target[(size_t)y * targetWidth + x] = farthest;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../laky_memory/laky_framearena.h"
+
+
+// timings and counts of the last OcclusionCuller frame
+struct OcclusionStats
+{
+    unsigned int occluderTriangles;  // triangles handed to AddOccluder
+    unsigned int rasterTriangles;    // triangles that survived clipping and got binned
+    double       transformMs;        // transform, setup and binning
+    double       rasterMs;           // tile rasterization (all threads)
+    double       hizMs;              // building the Hi-Z pyramid
+};
+
+// OcclusionCuller is a CPU-only software depth rasterizer for occlusion
+// culling. Designated occluders are rasterized into a small depth buffer
+// (SSE, four pixels at a time, tiles spread across the JobSystem), which
+// is then reduced into a Hi-Z pyramid where every texel holds the
+// farthest depth below it. An object is hidden if the nearest point of its
+// bounding box is behind the pyramid in every texel its screen rectangle
+// covers. Everything errs towards "visible": triangles crossing the near
+// plane are dropped from the occluders, boxes crossing it are never culled.
+// The occluders and bins of a frame live in the FrameArena, so BeginFrame,
+// AddOccluder and Rasterize have to run within one frame.
+class OcclusionCuller
+{
+public:
+    // width is rounded up to a multiple of 4 (one SSE register of pixels)
+    OcclusionCuller(unsigned int width = 256, unsigned int height = 128);
+    // clears the depth buffer and occluders for a new view
+    void BeginFrame(const glm::mat4 &viewProjection);
+    // adds an occluder mesh (local-space positions, triangle list) with its model matrix
+    void AddOccluder(const glm::vec3 *positions, size_t vertexCount, const unsigned int *indices, size_t indexCount, const glm::mat4 &model);
+    // rasterizes all occluders and builds the Hi-Z pyramid, call before any visibility test
+    void Rasterize();
+    // tests a local-space box under a model matrix against the pyramid, false if it is certainly hidden
+    bool IsVisible(const glm::vec3 &boxMin, const glm::vec3 &boxMax, const glm::mat4 &model) const;
+    // same for a world-space box
+    bool IsVisible(const glm::vec3 &boxMin, const glm::vec3 &boxMax) const { return IsVisible(boxMin, boxMax, glm::mat4(1.0f)); }
+    const OcclusionStats &Stats() const { return stats; }
+    unsigned int Width() const { return width; }
+    unsigned int Height() const { return height; }
+    // depth of a pyramid level (0 = full resolution), rows bottom to top, 0 = near plane, 1 = far plane
+    const std::vector<float> &Level(unsigned int level) const { return levels[level]; }
+    unsigned int LevelCount() const { return (unsigned int)levels.size(); }
+private:
+    static const unsigned int TILE_WIDTH = 64;
+    static const unsigned int TILE_HEIGHT = 32;
+
+    // a screen-space triangle ready for rasterization
+    struct Triangle
+    {
+        float edgeA[3], edgeB[3], edgeC[3]; // edge functions A*x + B*y + C, >= 0 inside
+        float depthA, depthB, depthC;       // depth plane A*x + B*y + C
+        int   minX, minY, maxX, maxY;       // pixel bounds, inclusive
+    };
+
+    unsigned int width, height;
+    unsigned int tilesX, tilesY;
+    glm::mat4 viewProjection;
+    FrameVector<glm::vec4>              clipVertices;  // occluder vertices of the current frame, in clip space
+    FrameVector<unsigned int>           clipIndices;
+    FrameVector<Triangle>               triangles;
+    FrameVector<unsigned int>           binOffsets;    // where each tile's triangles start in binTriangles, one extra at the end
+    FrameVector<unsigned int>           binTriangles;  // triangle indices grouped by tile
+    size_t lastVertexCount, lastIndexCount;            // occluder sizes of the last frame, reserved up front for the next
+    std::vector<std::vector<float> >    levels;        // Hi-Z pyramid, levels[0] is the depth buffer
+    std::vector<unsigned int>           levelWidths, levelHeights;
+    OcclusionStats stats;
+
+    // turns clip-space triangles into edge/depth equations and sorts them into tile bins (counting sort, no growing lists)
+    void setupTriangles();
+    // rasterizes the bin of one tile into levels[0]
+    void rasterizeTile(unsigned int tile);
+    // reduces level - 1 into level, every texel keeps the farthest of its 2x2 children
+    void buildLevel(unsigned int level);
+};
+
+#endif
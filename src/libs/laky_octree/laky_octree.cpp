@@ -0,0 +1,259 @@
+// LAKY'S LOOSE OCTREE v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_octree.h"
+
+// deepest subdivision, cell coordinates have to fit into 10 bits
+static const unsigned int MAX_SUPPORTED_DEPTH = 10;
+// a node has at most 8 children per level, the traversal stack never holds more than this
+static const unsigned int STACK_SIZE = 8 * (MAX_SUPPORTED_DEPTH + 1);
+
+
+LooseOctree::LooseOctree(const glm::vec3 &center, float halfSize, unsigned int maxDepth)
+    : rootCenter(center), rootHalfSize(halfSize), maxDepth(maxDepth < MAX_SUPPORTED_DEPTH ? maxDepth : MAX_SUPPORTED_DEPTH), stats()
+{
+    allocateNode(NO_NODE, rootCenter, rootHalfSize);
+    stats = OctreeStats();
+}
+
+OctreeHandle LooseOctree::Insert(const glm::vec3 &center, float radius, uint32_t userData)
+{
+    Object object;
+    object.center = center;
+    object.radius = radius;
+    object.userData = userData;
+    object.node = NO_NODE;
+    object.slot = 0;
+    object.cell = cellOf(center, radius);
+    OctreeHandle handle = objects.Insert(object);
+    link(handle, objects.Get(handle));
+    return handle;
+}
+
+void LooseOctree::Update(OctreeHandle handle, const glm::vec3 &center, float radius)
+{
+    Object *object = objects.TryGet(handle);
+    if (!object)
+        return;
+
+    stats.updates++;
+    object->center = center;
+    object->radius = radius;
+    uint64_t cell = cellOf(center, radius);
+    if (cell == object->cell)
+        return;
+
+    // left its cell (or grew/shrank out of its level), move it to the node it belongs to now
+    unlink(*object);
+    object->cell = cell;
+    link(handle, *object);
+    stats.relocations++;
+}
+
+void LooseOctree::Remove(OctreeHandle handle)
+{
+    Object *object = objects.TryGet(handle);
+    if (!object)
+        return;
+    unlink(*object);
+    objects.Erase(handle);
+}
+
+void LooseOctree::Clear()
+{
+    objects.Clear();
+    // every node but the root goes back to the pool, lists keep their capacity
+    freeNodes.clear();
+    for (size_t i = nodes.size() - 1; i > 0; i--)
+    {
+        nodes[i].objects.clear();
+        freeNodes.push_back((uint32_t)i);
+    }
+    Node &root = nodes[0];
+    root.objects.clear();
+    for (int i = 0; i < 8; i++)
+        root.children[i] = NO_NODE;
+    root.childCount = 0;
+}
+
+void LooseOctree::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &result) const
+{
+    // nodes pass down the planes they straddle, below a node that is completely inside nothing gets tested
+    struct Entry
+    {
+        uint32_t     node;
+        unsigned int planeMask;
+    };
+    Entry stack[STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = Entry{ 0, Frustum::ALL_PLANES };
+
+    while (stackSize > 0)
+    {
+        Entry entry = stack[--stackSize];
+        const Node &node = nodes[entry.node];
+        // the root also holds whatever is outside of it, so it is never skipped
+        unsigned int mask = entry.planeMask;
+        glm::vec3 looseExtent(node.halfSize * 2.0f);
+        if (entry.node != 0 && !frustum.IntersectsAABB(node.center - looseExtent, node.center + looseExtent, mask))
+            continue;
+
+        for (OctreeHandle handle : node.objects)
+        {
+            const Object &object = objects.Get(handle);
+            if (frustum.IntersectsSphere(object.center, object.radius, mask))
+                result.push_back(object.userData);
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            if (node.children[i] != NO_NODE)
+                stack[stackSize++] = Entry{ node.children[i], mask };
+        }
+    }
+}
+
+void LooseOctree::QuerySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &result) const
+{
+    uint32_t stack[STACK_SIZE];
+    unsigned int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        uint32_t index = stack[--stackSize];
+        const Node &node = nodes[index];
+        if (index != 0)
+        {
+            // distance from the query center to the node's loose bounds
+            glm::vec3 looseExtent(node.halfSize * 2.0f);
+            glm::vec3 offset = center - glm::clamp(center, node.center - looseExtent, node.center + looseExtent);
+            if (glm::dot(offset, offset) > radius * radius)
+                continue;
+        }
+
+        for (OctreeHandle handle : node.objects)
+        {
+            const Object &object = objects.Get(handle);
+            glm::vec3 offset = object.center - center;
+            float reach = object.radius + radius;
+            if (glm::dot(offset, offset) <= reach * reach)
+                result.push_back(object.userData);
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            if (node.children[i] != NO_NODE)
+                stack[stackSize++] = node.children[i];
+        }
+    }
+}
+
+
+uint64_t LooseOctree::cellOf(const glm::vec3 &center, float radius) const
+{
+    // the deepest level whose cells are still as big as the sphere, the loose bounds then always contain it
+    unsigned int depth = 0;
+    float halfSize = rootHalfSize;
+    while (depth < maxDepth && halfSize * 0.5f >= radius)
+    {
+        halfSize *= 0.5f;
+        depth++;
+    }
+
+    // cell coordinates at that depth, anything outside the root cell stays in the root
+    glm::vec3 local = (center - rootCenter + glm::vec3(rootHalfSize)) / (2.0f * halfSize);
+    const float cells = (float)(1u << depth);
+    if (!(local.x >= 0.0f && local.y >= 0.0f && local.z >= 0.0f && local.x < cells && local.y < cells && local.z < cells))
+        return 0;
+    uint64_t x = (uint64_t)local.x, y = (uint64_t)local.y, z = (uint64_t)local.z;
+    return (uint64_t)depth << 30 | x << 20 | y << 10 | z;
+}
+
+uint32_t LooseOctree::nodeOf(uint64_t cell)
+{
+    unsigned int depth = (unsigned int)(cell >> 30);
+    uint32_t x = (uint32_t)(cell >> 20) & 0x3FF, y = (uint32_t)(cell >> 10) & 0x3FF, z = (uint32_t)cell & 0x3FF;
+
+    // the bits of the cell coordinates, from the top, pick the child on every level
+    uint32_t index = 0;
+    for (unsigned int level = 1; level <= depth; level++)
+    {
+        unsigned int shift = depth - level;
+        unsigned int octant = ((x >> shift) & 1) | ((y >> shift) & 1) << 1 | ((z >> shift) & 1) << 2;
+        uint32_t child = nodes[index].children[octant];
+        if (child == NO_NODE)
+        {
+            float childHalfSize = nodes[index].halfSize * 0.5f;
+            glm::vec3 childCenter = nodes[index].center + glm::vec3(octant & 1 ? childHalfSize : -childHalfSize,
+                                                                    octant & 2 ? childHalfSize : -childHalfSize,
+                                                                    octant & 4 ? childHalfSize : -childHalfSize);
+            // may grow the pool, so no references into nodes are held across this
+            child = allocateNode(index, childCenter, childHalfSize);
+            nodes[index].children[octant] = child;
+            nodes[index].childCount++;
+        }
+        index = child;
+    }
+    return index;
+}
+
+uint32_t LooseOctree::allocateNode(uint32_t parent, const glm::vec3 &center, float halfSize)
+{
+    uint32_t index;
+    if (!freeNodes.empty())
+    {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else
+    {
+        index = (uint32_t)nodes.size();
+        nodes.push_back(Node());
+    }
+
+    Node &node = nodes[index];
+    node.center = center;
+    node.halfSize = halfSize;
+    node.parent = parent;
+    for (int i = 0; i < 8; i++)
+        node.children[i] = NO_NODE;
+    node.childCount = 0;
+    node.objects.clear();
+    stats.nodesCreated++;
+    return index;
+}
+
+void LooseOctree::link(OctreeHandle handle, Object &object)
+{
+    object.node = nodeOf(object.cell);
+    std::vector<OctreeHandle> &list = nodes[object.node].objects;
+    object.slot = (uint32_t)list.size();
+    list.push_back(handle);
+}
+
+void LooseOctree::unlink(Object &object)
+{
+    // swap-remove, the object that took the slot needs to know its new position
+    std::vector<OctreeHandle> &list = nodes[object.node].objects;
+    OctreeHandle moved = list.back();
+    list[object.slot] = moved;
+    objects.Get(moved).slot = object.slot;
+    list.pop_back();
+
+    // empty leaves go back to the pool, which may empty their parent in turn
+    uint32_t index = object.node;
+    while (index != 0 && nodes[index].objects.empty() && nodes[index].childCount == 0)
+    {
+        uint32_t parent = nodes[index].parent;
+        for (int i = 0; i < 8; i++)
+        {
+            if (nodes[parent].children[i] == index)
+                nodes[parent].children[i] = NO_NODE;
+        }
+        nodes[parent].childCount--;
+        freeNodes.push_back(index);
+        stats.nodesFreed++;
+        index = parent;
+    }
+    object.node = NO_NODE;
+}
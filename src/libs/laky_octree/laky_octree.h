@@ -0,0 +1,102 @@
+#ifndef LOOSE_OCTREE_H
+#define LOOSE_OCTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../laky_slotmap.h"
+#include "../laky_frustum.h"
+
+
+// handle type returned by LooseOctree::Insert
+struct OctreeObjectTag {};
+typedef Handle<OctreeObjectTag> OctreeHandle;
+
+// counters since the last LooseOctree::ResetStats
+struct OctreeStats
+{
+    size_t updates;      // Update calls
+    size_t relocations;  // updates that moved the object to another node
+    size_t nodesCreated; // nodes taken from the pool
+    size_t nodesFreed;   // empty nodes handed back to the pool
+};
+
+// LooseOctree sorts bounding spheres of moving objects into a loose octree,
+// whose nodes accept anything centred inside their cell as long as it is no
+// bigger than the cell (their bounds are twice the cell size). That makes an
+// object's node a direct function of its position and radius: no searching
+// on insert, and an Update that stays inside the same cell costs nothing
+// beyond storing the new sphere. Moving to another cell is a swap-remove from
+// one node's list and a walk of at most maxDepth levels down to the new one.
+// Nodes come from a pool and go back to it as soon as they and their children
+// run empty. Objects outside the root cell simply live in the root.
+class LooseOctree
+{
+public:
+    // a cube of 2 * halfSize around center, subdivided at most maxDepth times (capped at 10)
+    LooseOctree(const glm::vec3 &center = glm::vec3(0.0f), float halfSize = 64.0f, unsigned int maxDepth = 8);
+
+    // adds a bounding sphere, userData is what the queries report
+    OctreeHandle Insert(const glm::vec3 &center, float radius, uint32_t userData);
+    // moves an object
+    void         Update(OctreeHandle handle, const glm::vec3 &center, float radius);
+    void         Remove(OctreeHandle handle);
+    void         Clear();
+    bool         Contains(OctreeHandle handle) const { return objects.Contains(handle); }
+
+    // appends the userData of every object whose sphere intersects the frustum
+    void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &result) const;
+    // appends the userData of every object whose sphere touches the query sphere (e.g. a point light's range)
+    void QuerySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &result) const;
+
+    size_t ObjectCount() const { return objects.Size(); }
+    // nodes in the tree, and nodes allocated in total (in the tree or waiting in the pool)
+    size_t NodeCount() const { return nodes.size() - freeNodes.size(); }
+    size_t PoolSize() const { return nodes.size(); }
+    const OctreeStats &Stats() const { return stats; }
+    void ResetStats() { stats = OctreeStats(); }
+private:
+    static const uint32_t NO_NODE = 0xFFFFFFFF;
+
+    struct Object
+    {
+        glm::vec3 center;
+        float     radius;
+        uint32_t  userData;
+        uint32_t  node;     // node whose list holds the object
+        uint32_t  slot;     // position in that list
+        uint64_t  cell;     // packed depth and cell coordinates, see cellOf
+    };
+
+    struct Node
+    {
+        glm::vec3                 center;      // center of the cell, the loose bounds are center +- 2 * halfSize
+        float                     halfSize;
+        uint32_t                  parent;
+        uint32_t                  children[8]; // NO_NODE where there is no child
+        uint32_t                  childCount;
+        std::vector<OctreeHandle> objects;     // kept when the node goes back to the pool, so its capacity is reused
+    };
+
+    glm::vec3                             rootCenter;
+    float                                 rootHalfSize;
+    unsigned int                          maxDepth;
+    SlotMap<Object, OctreeObjectTag>      objects;
+    std::vector<Node>                     nodes;       // node 0 is always the root
+    std::vector<uint32_t>                 freeNodes;
+    OctreeStats                           stats;
+
+    // depth and cell coordinates the sphere belongs to, packed as depth << 30 | x << 20 | y << 10 | z
+    uint64_t cellOf(const glm::vec3 &center, float radius) const;
+    // walks down to the node of a packed cell, creating missing nodes on the way
+    uint32_t nodeOf(uint64_t cell);
+    uint32_t allocateNode(uint32_t parent, const glm::vec3 &center, float halfSize);
+    void     link(OctreeHandle handle, Object &object);
+    // takes an object out of its node's list, releasing nodes that become empty
+    void     unlink(Object &object);
+};
+
+#endif
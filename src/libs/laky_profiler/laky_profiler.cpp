@@ -0,0 +1,113 @@
+// LAKY'S PROFILER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_profiler.h"
+
+
+void TimingStats::Add(double ms)
+{
+    if (samples == 0 || ms < min)
+        min = ms;
+    if (samples == 0 || ms > max)
+        max = ms;
+    total += ms;
+    samples++;
+}
+
+GpuTimer::GpuTimer()
+    : head(0), pending(0), active(false)
+{
+    glGenQueries(QUERY_COUNT, this->queries);
+}
+
+void GpuTimer::Begin()
+{
+    // every query is still in flight, skip this sample rather than wait for the GPU
+    this->active = this->pending < QUERY_COUNT;
+    if (this->active)
+        glBeginQuery(GL_TIME_ELAPSED, this->queries[this->head]);
+}
+
+void GpuTimer::End()
+{
+    if (!this->active)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    this->head = (this->head + 1) % QUERY_COUNT;
+    this->pending++;
+    this->active = false;
+}
+
+void GpuTimer::Collect()
+{
+    while (this->pending > 0)
+    {
+        // queries finish in order, so stop at the first one that isn't ready yet
+        unsigned int oldest = (this->head + QUERY_COUNT - this->pending) % QUERY_COUNT;
+        GLint available = 0;
+        glGetQueryObjectiv(this->queries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(this->queries[oldest], GL_QUERY_RESULT, &elapsed);
+        this->stats.Add(elapsed / 1000000.0);
+        this->pending--;
+    }
+}
+
+void GpuTimer::Destroy()
+{
+    glDeleteQueries(QUERY_COUNT, this->queries);
+    this->pending = 0;
+}
+
+FragmentCounter::FragmentCounter()
+    : head(0), pending(0), active(false)
+{
+    glGenQueries(QUERY_COUNT, this->queries);
+}
+
+void FragmentCounter::Begin()
+{
+    // every query is still in flight, skip this sample rather than wait for the GPU
+    this->active = this->pending < QUERY_COUNT;
+    if (this->active)
+        glBeginQuery(GL_SAMPLES_PASSED, this->queries[this->head]);
+}
+
+void FragmentCounter::End()
+{
+    if (!this->active)
+        return;
+
+    glEndQuery(GL_SAMPLES_PASSED);
+    this->head = (this->head + 1) % QUERY_COUNT;
+    this->pending++;
+    this->active = false;
+}
+
+void FragmentCounter::Collect()
+{
+    while (this->pending > 0)
+    {
+        unsigned int oldest = (this->head + QUERY_COUNT - this->pending) % QUERY_COUNT;
+        GLint available = 0;
+        glGetQueryObjectiv(this->queries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        GLuint64 samples = 0;
+        glGetQueryObjectui64v(this->queries[oldest], GL_QUERY_RESULT, &samples);
+        this->stats.Add((double)samples);
+        this->pending--;
+    }
+}
+
+void FragmentCounter::Destroy()
+{
+    glDeleteQueries(QUERY_COUNT, this->queries);
+    this->pending = 0;
+}
@@ -0,0 +1,94 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+
+#include <glad/glad.h>
+
+
+// running statistics of timing samples, in milliseconds (FragmentCounter reuses it for fragment counts)
+struct TimingStats
+{
+    double       total = 0.0;
+    double       min = 0.0;
+    double       max = 0.0;
+    unsigned int samples = 0;
+
+    void   Add(double ms);
+    double Average() const { return samples > 0 ? total / samples : 0.0; }
+    void   Reset() { *this = TimingStats(); }
+};
+
+// GpuTimer measures how long the GPU spends on the commands issued between
+// Begin() and End() with GL_TIME_ELAPSED queries. Results are read back a
+// few frames later from a small ring of queries, so timing never stalls
+// the pipeline; a frame is skipped if every query is still in flight.
+// Timers must not be nested (only one GL_TIME_ELAPSED query can be active).
+class GpuTimer
+{
+public:
+    GpuTimer();
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+    // starts timing, must be paired with End()
+    void Begin();
+    void End();
+    // adds every finished query to the stats without waiting, call once per frame
+    void Collect();
+    const TimingStats &Stats() const { return stats; }
+    void Reset() { stats.Reset(); }
+    // deletes the GL queries
+    void Destroy();
+private:
+    static const unsigned int QUERY_COUNT = 4;
+    unsigned int queries[QUERY_COUNT];
+    unsigned int head;    // next query to issue
+    unsigned int pending; // issued queries whose result hasn't been read yet
+    bool         active;  // Begin() issued a query
+    TimingStats  stats;
+};
+
+// FragmentCounter counts the samples that pass the depth and stencil tests
+// between Begin() and End() with GL_SAMPLES_PASSED queries, read back
+// through the same kind of ring as GpuTimer so it never stalls either.
+// Those are the fragments that got shaded and written, so divided by the
+// number of pixels they measure overdraw. Can run alongside a GpuTimer,
+// but counters must not be nested.
+class FragmentCounter
+{
+public:
+    FragmentCounter();
+    FragmentCounter(const FragmentCounter &) = delete;
+    FragmentCounter &operator=(const FragmentCounter &) = delete;
+    // starts counting, must be paired with End()
+    void Begin();
+    void End();
+    // adds every finished query to the stats without waiting, call once per frame
+    void Collect();
+    const TimingStats &Stats() const { return stats; }
+    void Reset() { stats.Reset(); }
+    // deletes the GL queries
+    void Destroy();
+private:
+    static const unsigned int QUERY_COUNT = 4;
+    unsigned int queries[QUERY_COUNT];
+    unsigned int head;    // next query to issue
+    unsigned int pending; // issued queries whose result hasn't been read yet
+    bool         active;  // Begin() issued a query
+    TimingStats  stats;
+};
+
+// CpuTimer measures wall time between Begin() and End() on the calling thread
+class CpuTimer
+{
+public:
+    void Begin() { start = std::chrono::steady_clock::now(); }
+    void End() { stats.Add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()); }
+    const TimingStats &Stats() const { return stats; }
+    void Reset() { stats.Reset(); }
+private:
+    std::chrono::steady_clock::time_point start;
+    TimingStats stats;
+};
+
+#endif
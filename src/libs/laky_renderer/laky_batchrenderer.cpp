@@ -0,0 +1,201 @@
+// LAKY'S BATCH RENDERER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_batchrenderer.h"
+
+#include <cstddef>
+
+// vertex buffer binding points of the batch VAO
+enum BatchBufferBinding
+{
+    VERTEX_BUFFER_BINDING = 0,
+    INSTANCE_BUFFER_BINDING = 1,
+    VISIBLE_BUFFER_BINDING = 2
+};
+
+
+BatchRenderer::BatchRenderer(MeshArena &arena, StreamBuffer *stream)
+    : InstanceOffset(0), CommandOffset(0), BoundsOffset(0), ConeOffset(0), arena(arena), stream(stream),
+      instanceCapacity(0), commandCapacity(0), boundsCapacity(0), conesCapacity(0), lastQueued(0)
+{
+    // created either way, a frame that doesn't fit into the stream falls back to them
+    glGenBuffers(1, &ownInstanceBuffer);
+    glGenBuffers(1, &ownCommandBuffer);
+    glGenBuffers(1, &ownBoundsBuffer);
+    glGenBuffers(1, &ownConeBuffer);
+    this->InstanceBuffer = ownInstanceBuffer;
+    this->CommandBuffer = ownCommandBuffer;
+    this->BoundsBuffer = ownBoundsBuffer;
+    this->ConeBuffer = ownConeBuffer;
+    glGenVertexArrays(1, &this->VAO);
+    glBindVertexArray(this->VAO);
+
+    // the format is fixed, buffers are attached when drawing since the arena may have grown in between
+    glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+    glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
+    glVertexAttribFormat(2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoords));
+    for (unsigned int attribute = 0; attribute < 3; attribute++)
+    {
+        glVertexAttribBinding(attribute, VERTEX_BUFFER_BINDING);
+        glEnableVertexAttribArray(attribute);
+    }
+
+    // per-instance model matrix (locations 3-6) and material index (location 7)
+    for (unsigned int column = 0; column < 4; column++)
+    {
+        glVertexAttribFormat(3 + column, 4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, model) + column * sizeof(glm::vec4));
+        glVertexAttribBinding(3 + column, INSTANCE_BUFFER_BINDING);
+        glEnableVertexAttribArray(3 + column);
+    }
+    glVertexAttribIFormat(7, 1, GL_UNSIGNED_INT, offsetof(InstanceData, materialIndex));
+    glVertexAttribBinding(7, INSTANCE_BUFFER_BINDING);
+    glEnableVertexAttribArray(7);
+    glVertexBindingDivisor(INSTANCE_BUFFER_BINDING, 1);
+
+    // index of the instance in InstanceBuffer (location 8), only fed by DrawIndirect()
+    glVertexAttribIFormat(8, 1, GL_UNSIGNED_INT, 0);
+    glVertexAttribBinding(8, VISIBLE_BUFFER_BINDING);
+    glVertexBindingDivisor(VISIBLE_BUFFER_BINDING, 1);
+
+    glBindVertexArray(0);
+}
+
+void BatchRenderer::Submit(unsigned int mesh, const InstanceData &instance)
+{
+    // a fresh queue in this frame's arena, sized so it doesn't have to grow (and leave old arrays behind) again
+    if (queued.capacity() == 0)
+        queued.reserve(lastQueued > 0 ? lastQueued : 64);
+    QueuedInstance queuedInstance;
+    queuedInstance.mesh = mesh;
+    queuedInstance.instance = instance;
+    queued.push_back(queuedInstance);
+}
+
+void BatchRenderer::Build()
+{
+    // counting sort by mesh: count instances per mesh, then hand out contiguous slices
+    FrameVector<unsigned int> meshOffsets(arena.Count(), 0);
+    FrameVector<unsigned int> meshDraws(arena.Count(), 0); // command index per mesh
+    for (const QueuedInstance &queuedInstance : queued)
+        meshOffsets[queuedInstance.mesh]++;
+
+    commands.clear();
+    drawBounds.clear();
+    drawCones.clear();
+    unsigned int baseInstance = 0;
+    for (unsigned int mesh = 0; mesh < arena.Count(); mesh++)
+    {
+        unsigned int count = meshOffsets[mesh];
+        meshOffsets[mesh] = baseInstance;
+        if (count == 0)
+            continue;
+
+        const MeshRange &range = arena.Get(mesh);
+        DrawElementsIndirectCommand command;
+        command.count = range.indexCount;
+        command.instanceCount = count;
+        command.firstIndex = range.firstIndex;
+        command.baseVertex = range.baseVertex;
+        command.baseInstance = baseInstance;
+        meshDraws[mesh] = (unsigned int)commands.size();
+        commands.push_back(command);
+        drawBounds.push_back(range.bounds);
+        drawCones.push_back(range.cone);
+        baseInstance += count;
+    }
+
+    instances.resize(queued.size());
+    for (const QueuedInstance &queuedInstance : queued)
+    {
+        InstanceData &instance = instances[meshOffsets[queuedInstance.mesh]++];
+        instance = queuedInstance.instance;
+        instance.drawIndex = meshDraws[queuedInstance.mesh];
+    }
+    // dropped rather than cleared, its memory goes back with the frame
+    lastQueued = queued.size();
+    FrameVector<QueuedInstance>().swap(queued);
+
+    this->InstanceOffset = place(ownInstanceBuffer, GL_ARRAY_BUFFER, instanceCapacity, instances.data(), instances.size() * sizeof(InstanceData), this->InstanceBuffer);
+    this->CommandOffset = place(ownCommandBuffer, GL_DRAW_INDIRECT_BUFFER, commandCapacity, commands.data(), commands.size() * sizeof(DrawElementsIndirectCommand), this->CommandBuffer);
+    this->BoundsOffset = place(ownBoundsBuffer, GL_SHADER_STORAGE_BUFFER, boundsCapacity, drawBounds.data(), drawBounds.size() * sizeof(glm::vec4), this->BoundsBuffer);
+    this->ConeOffset = place(ownConeBuffer, GL_SHADER_STORAGE_BUFFER, conesCapacity, drawCones.data(), drawCones.size() * sizeof(glm::vec4), this->ConeBuffer);
+}
+
+void BatchRenderer::Draw() const
+{
+    if (commands.empty())
+        return;
+
+    glBindVertexArray(this->VAO);
+    glBindVertexBuffer(VERTEX_BUFFER_BINDING, arena.VBO, 0, sizeof(Vertex));
+    glBindVertexBuffer(INSTANCE_BUFFER_BINDING, this->InstanceBuffer, this->InstanceOffset, sizeof(InstanceData));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.EBO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->CommandBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)this->CommandOffset, (GLsizei)commands.size(), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void BatchRenderer::DrawIndirect(unsigned int commandBuffer, unsigned int visibleBuffer) const
+{
+    if (commands.empty())
+        return;
+
+    // the per-instance attributes stay attached too, shaders reading the visible index simply ignore them
+    glBindVertexArray(this->VAO);
+    glBindVertexBuffer(VERTEX_BUFFER_BINDING, arena.VBO, 0, sizeof(Vertex));
+    glBindVertexBuffer(INSTANCE_BUFFER_BINDING, this->InstanceBuffer, this->InstanceOffset, sizeof(InstanceData));
+    glBindVertexBuffer(VISIBLE_BUFFER_BINDING, visibleBuffer, 0, sizeof(unsigned int));
+    glEnableVertexAttribArray(8);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.EBO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)0, (GLsizei)commands.size(), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glDisableVertexAttribArray(8);
+    glBindVertexArray(0);
+}
+
+void BatchRenderer::Destroy()
+{
+    // the stream belongs to whoever passed it in
+    glDeleteVertexArrays(1, &this->VAO);
+    glDeleteBuffers(1, &ownInstanceBuffer);
+    glDeleteBuffers(1, &ownCommandBuffer);
+    glDeleteBuffers(1, &ownBoundsBuffer);
+    glDeleteBuffers(1, &ownConeBuffer);
+    this->VAO = this->InstanceBuffer = this->CommandBuffer = this->BoundsBuffer = this->ConeBuffer = 0;
+    ownInstanceBuffer = ownCommandBuffer = ownBoundsBuffer = ownConeBuffer = 0;
+    instanceCapacity = commandCapacity = boundsCapacity = conesCapacity = 0;
+}
+
+GLintptr BatchRenderer::place(unsigned int ownBuffer, GLenum target, size_t &capacity, const void *data, size_t size, unsigned int &buffer)
+{
+    // storage alignment suits every use: vertex attributes, indirect commands and the culler's storage bindings
+    if (stream != NULL && size > 0)
+    {
+        StreamAllocation allocation = stream->Upload(data, size, stream->StorageAlignment());
+        if (allocation.data != NULL)
+        {
+            buffer = stream->ID;
+            return allocation.offset;
+        }
+    }
+    upload(ownBuffer, target, capacity, data, size);
+    buffer = ownBuffer;
+    return 0;
+}
+
+void BatchRenderer::upload(unsigned int buffer, GLenum target, size_t &capacity, const void *data, size_t size)
+{
+    if (size == 0)
+        return;
+
+    glBindBuffer(target, buffer);
+    if (size > capacity)
+        capacity = size * 2;
+    // orphan the old storage so the driver doesn't wait for last frame's draw to finish reading it
+    glBufferData(target, capacity, NULL, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, size, data);
+    glBindBuffer(target, 0);
+}
@@ -0,0 +1,110 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "../laky_memory/laky_framearena.h"
+#include "../laky_mesh/laky_mesharena.h"
+#include "laky_streambuffer.h"
+
+
+// per-instance data read by the INSTANCING shaders (attribute locations 3-7).
+// Padded to a multiple of 16 bytes so the same buffer can be read as std430 by
+// compute shaders (see cull.comp and GPU_CULLING in material.vert)
+struct InstanceData
+{
+    glm::mat4    model;
+    unsigned int materialIndex; // index into the MaterialTable
+    unsigned int drawIndex;     // indirect command the instance belongs to, filled in by BatchRenderer::Build
+    float        lodFade;       // dithered level of detail cross-fade, 0 = opaque (see LOD_FADE in material.vert)
+    unsigned int padding;
+};
+
+// layout of one glMultiDrawElementsIndirect command, fixed by the GL spec
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
+// BatchRenderer draws any number of instances of any meshes stored in a
+// MeshArena with a single glMultiDrawElementsIndirect. Submitted instances
+// are grouped by mesh on the CPU, every mesh in use becomes one indirect
+// command whose baseInstance points at its slice of the instance buffer.
+// Build() uploads the commands once per frame, Draw() can then be issued
+// for as many passes as needed with whatever shader is bound. A GPU culling
+// pass can replace the command buffer with its own compacted one, see
+// DrawIndirect(). Given a StreamBuffer, Build() writes straight into the
+// frame's region of it instead of orphaning buffers of its own, so the
+// batch must then be rebuilt every frame it is drawn in. The queue and the
+// grouping scratch live in the FrameArena, so Submit and Build must happen
+// within the same frame.
+class BatchRenderer
+{
+public:
+    // without a stream the batch keeps its data in buffers of its own, for batches built once and drawn for many frames
+    explicit BatchRenderer(MeshArena &arena, StreamBuffer *stream = NULL);
+    BatchRenderer(const BatchRenderer &) = delete;
+    BatchRenderer &operator=(const BatchRenderer &) = delete;
+    // queues one instance of a mesh for the next Build()
+    void Submit(unsigned int mesh, const InstanceData &instance);
+    // groups the queued instances by mesh, uploads instances and commands and clears the queue
+    void Build();
+    // issues the whole batch as one multi-draw call
+    void Draw() const;
+    // issues the batch with externally written commands (same layout and order as CommandBuffer, starting at 0). Every
+    // instance then reads its index into InstanceBuffer from `visibleBuffer` (attribute location 8)
+    void DrawIndirect(unsigned int commandBuffer, unsigned int visibleBuffer) const;
+    // CPU copies of what the last Build() uploaded
+    const std::vector<DrawElementsIndirectCommand> &Commands() const { return commands; }
+    const std::vector<InstanceData> &Instances() const { return instances; }
+    const std::vector<glm::vec4> &DrawBounds() const { return drawBounds; }
+    const std::vector<glm::vec4> &DrawCones() const { return drawCones; }
+    // indirect commands and instances of the last Build()
+    unsigned int DrawCount() const { return (unsigned int)commands.size(); }
+    unsigned int InstanceCount() const { return (unsigned int)instances.size(); }
+    StreamBuffer *Stream() const { return stream; }
+    // deletes the GL objects
+    void Destroy();
+
+    // where the last Build() put its data: the StreamBuffer, or the batch's own buffers if there is none or it was full
+    unsigned int VAO;
+    unsigned int InstanceBuffer; // InstanceData, grouped by mesh
+    unsigned int CommandBuffer;  // DrawElementsIndirectCommand, one per mesh in use
+    unsigned int BoundsBuffer;   // vec4 local bounding sphere per command
+    unsigned int ConeBuffer;     // vec4 local normal cone per command (see MeshRange::cone)
+    GLintptr InstanceOffset, CommandOffset, BoundsOffset, ConeOffset; // byte offsets of the data in those buffers
+private:
+    struct QueuedInstance
+    {
+        unsigned int mesh;
+        InstanceData instance;
+    };
+
+    MeshArena &arena;
+    StreamBuffer *stream;
+    // the batch's own buffers, used without a stream
+    unsigned int ownInstanceBuffer, ownCommandBuffer, ownBoundsBuffer, ownConeBuffer;
+    FrameVector<QueuedInstance>              queued;      // since the last Build(), in the FrameArena
+    std::vector<InstanceData>                instances;
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<glm::vec4>                   drawBounds;
+    std::vector<glm::vec4>                   drawCones;
+    size_t instanceCapacity; // bytes allocated for ownInstanceBuffer
+    size_t commandCapacity;  // bytes allocated for ownCommandBuffer
+    size_t boundsCapacity;   // bytes allocated for ownBoundsBuffer
+    size_t conesCapacity;    // bytes allocated for ownConeBuffer
+    size_t lastQueued;       // instances of the last Build(), the next queue reserves that many up front
+    // writes one array of the frame into the stream, or uploads it to `ownBuffer`; sets `buffer` to where it went, returns the offset
+    GLintptr place(unsigned int ownBuffer, GLenum target, size_t &capacity, const void *data, size_t size, unsigned int &buffer);
+    // orphans and refills a buffer, growing it when the data doesn't fit
+    static void upload(unsigned int buffer, GLenum target, size_t &capacity, const void *data, size_t size);
+};
+
+#endif
@@ -0,0 +1,100 @@
+// LAKY'S CLUSTERED LIGHTS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_clusteredlights.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+// bound in place of an empty array, storage ranges can't be empty
+const size_t MIN_BINDING_BYTES = 16;
+
+
+ClusteredLights::ClusteredLights(StreamBuffer *stream)
+    : LightOffset(0), ClusterOffset(0), IndexOffset(0), stream(stream), lightCapacity(0), indexCapacity(0),
+      lightBytes(MIN_BINDING_BYTES), indexBytes(MIN_BINDING_BYTES)
+{
+    glGenBuffers(1, &ownLightBuffer);
+    glGenBuffers(1, &ownClusterBuffer);
+    glGenBuffers(1, &ownIndexBuffer);
+    this->LightBuffer = ownLightBuffer;
+    this->ClusterBuffer = ownClusterBuffer;
+    this->IndexBuffer = ownIndexBuffer;
+
+    // the cluster table always has the same size
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ownClusterBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, LightGrid::CLUSTER_COUNT * sizeof(LightCluster), NULL, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void ClusteredLights::Update(const PointLight *lights, size_t count, const glm::mat4 &view, float fovY, float aspect, float near, float far, unsigned int width, unsigned int height)
+{
+    grid.Build(lights, count, view, fovY, aspect, near, far);
+
+    params.Set(params.Get().scale, glm::vec4((float)LightGrid::CLUSTERS_X / width, (float)LightGrid::CLUSTERS_Y / height, 0.0f, 0.0f));
+    params.Set(params.Get().depth, glm::vec4(near, far, grid.SliceScale(), grid.SliceBias()));
+    params.Set(params.Get().count, glm::uvec4(LightGrid::CLUSTERS_X, LightGrid::CLUSTERS_Y, LightGrid::CLUSTERS_Z, 0));
+
+    // every frame brings new positions and lists: they go into this frame's region of the stream, or into orphaned
+    // storage, so the driver never waits for the last frame's draws
+    size_t clusterCapacity = LightGrid::CLUSTER_COUNT * sizeof(LightCluster);
+    lightBytes = std::max(count * sizeof(PointLight), MIN_BINDING_BYTES);
+    indexBytes = std::max(grid.Indices().size() * sizeof(uint32_t), MIN_BINDING_BYTES);
+    this->LightOffset = place(ownLightBuffer, lightCapacity, lights, count * sizeof(PointLight), this->LightBuffer);
+    this->ClusterOffset = place(ownClusterBuffer, clusterCapacity, grid.Clusters().data(), clusterCapacity, this->ClusterBuffer);
+    this->IndexOffset = place(ownIndexBuffer, indexCapacity, grid.Indices().data(), grid.Indices().size() * sizeof(uint32_t), this->IndexBuffer);
+}
+
+void ClusteredLights::Bind()
+{
+    params.Bind(CLUSTER_BLOCK_BINDING);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CLUSTER_LIGHTS_BINDING, this->LightBuffer, this->LightOffset, lightBytes);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CLUSTER_GRID_BINDING, this->ClusterBuffer, this->ClusterOffset, LightGrid::CLUSTER_COUNT * sizeof(LightCluster));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CLUSTER_INDICES_BINDING, this->IndexBuffer, this->IndexOffset, indexBytes);
+}
+
+void ClusteredLights::Destroy()
+{
+    glDeleteBuffers(1, &ownLightBuffer);
+    glDeleteBuffers(1, &ownClusterBuffer);
+    glDeleteBuffers(1, &ownIndexBuffer);
+    this->LightBuffer = this->ClusterBuffer = this->IndexBuffer = 0;
+    ownLightBuffer = ownClusterBuffer = ownIndexBuffer = 0;
+    lightCapacity = indexCapacity = 0;
+    params.Destroy();
+}
+
+
+GLintptr ClusteredLights::place(unsigned int ownBuffer, size_t &capacity, const void *data, size_t bytes, unsigned int &buffer)
+{
+    if (stream != NULL)
+    {
+        // padded like the own buffers, so the range Bind uses is always inside the allocation
+        StreamAllocation allocation = stream->Allocate(std::max(bytes, MIN_BINDING_BYTES), stream->StorageAlignment());
+        if (allocation.data != NULL)
+        {
+            if (bytes > 0)
+                memcpy(allocation.data, data, bytes);
+            buffer = stream->ID;
+            return allocation.offset;
+        }
+    }
+    upload(ownBuffer, capacity, data, bytes);
+    buffer = ownBuffer;
+    return 0;
+}
+
+
+void ClusteredLights::upload(unsigned int buffer, size_t &capacity, const void *data, size_t bytes)
+{
+    // an empty buffer can't be bound as storage, keep at least a little
+    if (bytes > capacity || capacity == 0)
+        capacity = bytes > 0 ? bytes * 2 : 256;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, NULL, GL_STREAM_DRAW);
+    if (bytes > 0)
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bytes, data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
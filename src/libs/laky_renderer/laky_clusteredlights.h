@@ -0,0 +1,72 @@
+#ifndef CLUSTERED_LIGHTS_H
+#define CLUSTERED_LIGHTS_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "../laky_lights/laky_lightgrid.h"
+#include "../laky_material/laky_uniformbuffer.h"
+#include "laky_streambuffer.h"
+
+
+// shader storage binding points read by include/clustered_lights.glsl,
+// chosen to stay clear of MATERIAL_TABLE_BINDING and the CullStorageBinding ones
+enum ClusterStorageBinding
+{
+    CLUSTER_LIGHTS_BINDING = 5,
+    CLUSTER_GRID_BINDING = 6,
+    CLUSTER_INDICES_BINDING = 7
+};
+
+// std140 layout of the ClusterBlock uniform block in include/clustered_lights.glsl
+struct ClusterParams
+{
+    glm::vec4  scale;  // xy = clusters per pixel
+    glm::vec4  depth;  // x = near, y = far, z = slice scale, w = slice bias (see LightGrid::SliceScale)
+    glm::uvec4 count;  // xyz = clusters along each axis
+};
+
+// ClusteredLights feeds a LightGrid to the CLUSTERED_LIGHTS variant of the
+// material shader. Every Update bins the lights for the current view and
+// streams the lights, the cluster table and the index lists into shader
+// storage buffers (ranges of a StreamBuffer if given one, else buffers of
+// its own orphaned every frame and grown geometrically like the
+// MaterialTable), so thousands of moving point lights cost the fragment
+// shader only the handful that can reach its cluster.
+class ClusteredLights
+{
+public:
+    explicit ClusteredLights(StreamBuffer *stream = NULL);
+    ClusteredLights(const ClusteredLights &) = delete;
+    ClusteredLights &operator=(const ClusteredLights &) = delete;
+    // bins the lights for a perspective view (fovY in radians) and uploads the result, width and height are the viewport in pixels
+    void Update(const PointLight *lights, size_t count, const glm::mat4 &view, float fovY, float aspect, float near, float far, unsigned int width, unsigned int height);
+    // binds the buffers and the ClusterBlock for drawing
+    void Bind();
+    const LightGrid &Grid() const { return grid; }
+    // deletes the GL buffers
+    void Destroy();
+
+    // where the last Update put its data: the StreamBuffer, or the own buffers if there is none or it was full
+    unsigned int LightBuffer;   // PointLights, as given to Update
+    unsigned int ClusterBuffer; // LightCluster per cluster
+    unsigned int IndexBuffer;   // light indices grouped by cluster
+    GLintptr LightOffset, ClusterOffset, IndexOffset; // byte offsets of the data in those buffers
+private:
+    LightGrid                    grid;
+    UniformBuffer<ClusterParams> params;
+    StreamBuffer *stream;
+    unsigned int ownLightBuffer, ownClusterBuffer, ownIndexBuffer;
+    size_t lightCapacity;  // bytes allocated for ownLightBuffer
+    size_t indexCapacity;  // bytes allocated for ownIndexBuffer
+    size_t lightBytes, indexBytes; // bound by Bind, never 0
+
+    // writes one array of the frame into the stream, or uploads it to `ownBuffer`; sets `buffer` to where it went, returns the offset
+    GLintptr place(unsigned int ownBuffer, size_t &capacity, const void *data, size_t bytes, unsigned int &buffer);
+    // orphans a buffer (growing it if needed) and uploads `bytes` of data
+    static void upload(unsigned int buffer, size_t &capacity, const void *data, size_t bytes);
+};
+
+#endif
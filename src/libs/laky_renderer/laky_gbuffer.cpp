@@ -0,0 +1,108 @@
+// LAKY'S G-BUFFER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_gbuffer.h"
+
+#include <iostream>
+
+// creates a screen-sized texture without filtering, the lighting pass reads it with texelFetch
+static unsigned int createTarget(GLenum internalFormat, unsigned int width, unsigned int height)
+{
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
+
+
+GBuffer::GBuffer(unsigned int width, unsigned int height)
+    : width(width), height(height)
+{
+    glGenFramebuffers(1, &this->FBO);
+    glGenVertexArrays(1, &this->emptyVAO);
+    createAttachments();
+}
+
+void GBuffer::Resize(unsigned int width, unsigned int height)
+{
+    // a minimized window reports 0 x 0
+    if ((width == this->width && height == this->height) || width == 0 || height == 0)
+        return;
+    this->width = width;
+    this->height = height;
+    deleteAttachments();
+    createAttachments();
+}
+
+void GBuffer::BeginGeometryPass()
+{
+    const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const float clearDepth = 1.0f;
+    glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+    for (int i = 0; i < 3; i++)
+        glClearBufferfv(GL_COLOR, i, clearColor);
+    glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+}
+
+void GBuffer::Resolve()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, this->AlbedoTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, this->SpecularTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, this->NormalTexture);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, this->DepthTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    // the triangle itself sits at depth 0, the shader writes the stored depth instead
+    glDepthFunc(GL_ALWAYS);
+    glBindVertexArray(this->emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glDepthFunc(GL_LESS);
+}
+
+void GBuffer::Destroy()
+{
+    deleteAttachments();
+    glDeleteFramebuffers(1, &this->FBO);
+    glDeleteVertexArrays(1, &this->emptyVAO);
+    this->FBO = this->emptyVAO = 0;
+}
+
+
+void GBuffer::createAttachments()
+{
+    this->AlbedoTexture = createTarget(GL_RGBA8, width, height);
+    this->SpecularTexture = createTarget(GL_RGBA8, width, height);
+    this->NormalTexture = createTarget(GL_RG16_SNORM, width, height);
+    this->DepthTexture = createTarget(GL_DEPTH_COMPONENT32F, width, height);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->AlbedoTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, this->SpecularTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, this->NormalTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, this->DepthTexture, 0);
+    const GLenum drawBuffers[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+    glDrawBuffers(3, drawBuffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ERROR::GBUFFER: Framebuffer is not complete (" << width << "x" << height << ")" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void GBuffer::deleteAttachments()
+{
+    unsigned int textures[4] = { this->AlbedoTexture, this->SpecularTexture, this->NormalTexture, this->DepthTexture };
+    glDeleteTextures(4, textures);
+    this->AlbedoTexture = this->SpecularTexture = this->NormalTexture = this->DepthTexture = 0;
+}
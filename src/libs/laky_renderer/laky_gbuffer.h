@@ -0,0 +1,45 @@
+#ifndef GBUFFER_H
+#define GBUFFER_H
+
+#include <glad/glad.h>
+
+
+// GBuffer is the render target of the deferred path's geometry pass. Per
+// pixel it keeps 16 bytes: diffuse color and ambient scale (RGBA8), specular
+// color and shininess (RGBA8), an octahedral normal (RG16 snorm) and a 32
+// bit float depth the lighting pass reconstructs the position from. Every
+// pixel is then shaded exactly once by a full-screen pass, however many
+// surfaces were drawn over it (see gbuffer.frag and deferred.frag).
+class GBuffer
+{
+public:
+    GBuffer(unsigned int width, unsigned int height);
+    GBuffer(const GBuffer &) = delete;
+    GBuffer &operator=(const GBuffer &) = delete;
+    // reallocates the attachments if the size changed
+    void Resize(unsigned int width, unsigned int height);
+    // binds and clears the framebuffer for the geometry pass
+    void BeginGeometryPass();
+    // binds the attachments to texture units 0-3 and draws a full-screen triangle with the bound lighting
+    // shader into the default framebuffer, writing the G-buffer depth so later forward passes test against the scene
+    void Resolve();
+    unsigned int Width() const { return width; }
+    unsigned int Height() const { return height; }
+    // bytes of G-buffer memory per pixel
+    static unsigned int BytesPerPixel() { return 16; }
+    // deletes the framebuffer and its attachments
+    void Destroy();
+
+    unsigned int FBO;
+    unsigned int AlbedoTexture;   // rgb = diffuse color, a = ambient tint relative to the diffuse one
+    unsigned int SpecularTexture; // rgb = specular color, a = shininess / 255
+    unsigned int NormalTexture;   // octahedral world-space normal
+    unsigned int DepthTexture;
+private:
+    unsigned int width, height;
+    unsigned int emptyVAO; // core profile draws need a VAO, the full-screen triangle has no attributes
+    void createAttachments();
+    void deleteAttachments();
+};
+
+#endif
@@ -0,0 +1,176 @@
+// LAKY'S GPU CULLER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_gpuculler.h"
+
+#include <algorithm>
+#include <iostream>
+
+// instances this close to a plane may be classified differently by GPU and CPU float math, Verify() ignores them
+const float CULL_TOLERANCE = 1e-4f;
+
+
+GpuCuller::GpuCuller()
+    : commandCapacity(0), visibleCapacity(0)
+{
+    glGenBuffers(1, &this->CommandBuffer);
+    glGenBuffers(1, &this->VisibleBuffer);
+    this->shader = ResourceManager::LoadComputeShader("assets/shaders/cull.comp", "gpu_cull");
+}
+
+void GpuCuller::Run(const BatchRenderer &batch, const Frustum &frustum, const glm::vec3 &cameraPosition)
+{
+    const std::vector<DrawElementsIndirectCommand> &commands = batch.Commands();
+    unsigned int instanceCount = batch.InstanceCount();
+    if (commands.empty())
+        return;
+
+    // the shader only increments instanceCount, so every frame starts from the batch's commands with zero instances
+    size_t commandBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+    StreamAllocation reset = { NULL, 0, 0 };
+    if (batch.Stream() != NULL)
+        reset = batch.Stream()->Allocate(commandBytes, sizeof(GLuint));
+    if (reset.data != NULL)
+    {
+        // written straight into the stream and copied on the GPU; the buffer is only reallocated when it grows
+        DrawElementsIndirectCommand *resetCommands = (DrawElementsIndirectCommand *)reset.data;
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            resetCommands[i] = commands[i];
+            resetCommands[i].instanceCount = 0;
+        }
+        if (commandBytes > commandCapacity)
+        {
+            commandCapacity = commandBytes * 2;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->CommandBuffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, commandCapacity, NULL, GL_DYNAMIC_COPY);
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, batch.Stream()->ID);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->CommandBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, reset.offset, 0, commandBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    else
+    {
+        resetCommands = commands;
+        for (DrawElementsIndirectCommand &command : resetCommands)
+            command.instanceCount = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->CommandBuffer);
+        if (commandBytes > commandCapacity)
+            commandCapacity = commandBytes * 2;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, commandCapacity, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commandBytes, resetCommands.data());
+    }
+
+    // the visible list is fully written by the shader, it only has to be large enough
+    size_t visibleBytes = instanceCount * sizeof(unsigned int);
+    if (visibleBytes > visibleCapacity)
+    {
+        visibleCapacity = visibleBytes * 2;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->VisibleBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, visibleCapacity, NULL, GL_DYNAMIC_COPY);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    Shader &cull = ResourceManager::GetShader(this->shader);
+    cull.use();
+    cull.setVec4fArray("frustumPlanes", frustum.Planes, 6);
+    cull.setUInt("instanceCount", instanceCount);
+    cull.setVec3f("cameraPosition", cameraPosition);
+    // the batch's arrays may sit anywhere in its stream, bind exactly their ranges
+    size_t drawBytes = commands.size() * sizeof(glm::vec4);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CULL_INSTANCES_BINDING, batch.InstanceBuffer, batch.InstanceOffset, instanceCount * sizeof(InstanceData));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CULL_BOUNDS_BINDING, batch.BoundsBuffer, batch.BoundsOffset, drawBytes);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_COMMANDS_BINDING, this->CommandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_VISIBLE_BINDING, this->VisibleBuffer);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CULL_CONES_BINDING, batch.ConeBuffer, batch.ConeOffset, drawBytes);
+    glDispatchCompute((instanceCount + 63) / 64, 1, 1);
+
+    // the draw reads the commands as indirect arguments and the visible list as a vertex attribute
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+bool GpuCuller::Verify(const BatchRenderer &batch, const Frustum &frustum, const glm::vec3 &cameraPosition) const
+{
+    const std::vector<DrawElementsIndirectCommand> &commands = batch.Commands();
+    const std::vector<InstanceData> &instances = batch.Instances();
+    const std::vector<glm::vec4> &bounds = batch.DrawBounds();
+    const std::vector<glm::vec4> &cones = batch.DrawCones();
+    if (commands.empty())
+        return true;
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    FrameVector<DrawElementsIndirectCommand> culled(commands.size());
+    FrameVector<unsigned int> visible(instances.size());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->CommandBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, culled.size() * sizeof(DrawElementsIndirectCommand), culled.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->VisibleBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, visible.size() * sizeof(unsigned int), visible.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    bool match = true;
+    unsigned int gpuVisible = 0, cpuVisible = 0, borderline = 0;
+    FrameVector<unsigned int> gpuSet, cpuSet;
+    for (size_t draw = 0; draw < commands.size(); draw++)
+    {
+        const DrawElementsIndirectCommand &command = commands[draw];
+        if (culled[draw].instanceCount > command.instanceCount || culled[draw].baseInstance != command.baseInstance)
+        {
+            std::cout << "ERROR::GPU_CULLER: Draw " << draw << " came back with " << culled[draw].instanceCount << " of " << command.instanceCount << " instances" << std::endl;
+            return false;
+        }
+
+        // atomics make the order within a draw arbitrary, compare sorted sets
+        gpuSet.assign(visible.begin() + command.baseInstance, visible.begin() + command.baseInstance + culled[draw].instanceCount);
+        std::sort(gpuSet.begin(), gpuSet.end());
+        cpuSet.clear();
+        for (unsigned int index = command.baseInstance; index < command.baseInstance + command.instanceCount; index++)
+        {
+            glm::vec4 sphere = TransformSphere(instances[index].model, bounds[draw]);
+            float closest = 1e30f;
+            for (int i = 0; i < 6; i++)
+                closest = glm::min(closest, glm::dot(glm::vec3(frustum.Planes[i]), glm::vec3(sphere)) + frustum.Planes[i].w + sphere.w);
+            // a back-facing meshlet counts as being on the far side of one more plane
+            glm::vec4 cone = TransformCone(instances[index].model, cones[draw]);
+            if (cone.w < 1.0f)
+            {
+                glm::vec3 toCenter = glm::vec3(sphere) - cameraPosition;
+                closest = glm::min(closest, cone.w * glm::length(toCenter) + sphere.w - glm::dot(toCenter, glm::vec3(cone)));
+            }
+
+            bool inGpuSet = std::binary_search(gpuSet.begin(), gpuSet.end(), index);
+            if (glm::abs(closest) <= CULL_TOLERANCE * glm::max(1.0f, sphere.w))
+            {
+                // too close to call, accept whatever the GPU decided
+                borderline++;
+                if (inGpuSet)
+                    cpuSet.push_back(index);
+                continue;
+            }
+            if (closest >= 0.0f)
+                cpuSet.push_back(index);
+        }
+
+        gpuVisible += (unsigned int)gpuSet.size();
+        cpuVisible += (unsigned int)cpuSet.size();
+        if (gpuSet != cpuSet)
+        {
+            std::cout << "ERROR::GPU_CULLER: Draw " << draw << " has " << gpuSet.size() << " visible instances on the GPU, " << cpuSet.size() << " on the CPU" << std::endl;
+            match = false;
+        }
+    }
+
+    std::cout << "GPU culling check: " << gpuVisible << " of " << instances.size() << " instances visible (CPU reference " << cpuVisible << ", "
+              << borderline << " on a plane), " << (match ? "match" : "MISMATCH") << std::endl;
+    return match;
+}
+
+void GpuCuller::Destroy()
+{
+    glDeleteBuffers(1, &this->CommandBuffer);
+    glDeleteBuffers(1, &this->VisibleBuffer);
+    this->CommandBuffer = this->VisibleBuffer = 0;
+    commandCapacity = visibleCapacity = 0;
+}
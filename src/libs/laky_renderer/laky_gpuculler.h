@@ -0,0 +1,57 @@
+#ifndef GPU_CULLER_H
+#define GPU_CULLER_H
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "../laky_frustum.h"
+#include "../laky_resmanager.h"
+#include "laky_batchrenderer.h"
+
+
+// shader storage binding points used by cull.comp (and GPU_CULLING in material.vert),
+// chosen to stay clear of MATERIAL_TABLE_BINDING and the ClusterStorageBinding points
+enum CullStorageBinding
+{
+    CULL_INSTANCES_BINDING = 1,
+    CULL_BOUNDS_BINDING = 2,
+    CULL_COMMANDS_BINDING = 3,
+    CULL_VISIBLE_BINDING = 4,
+    CULL_CONES_BINDING = 8
+};
+
+// GpuCuller frustum-culls the instances of a BatchRenderer in a compute
+// shader. Every surviving instance is counted into its draw command with
+// an atomic add and its index is appended to that command's slice of the
+// visible list, so the result can be drawn straight away with
+// BatchRenderer::DrawIndirect without the CPU ever seeing it. Draws of
+// meshlets (MeshArena::AddMeshlet) are also dropped when their normal cone
+// faces away from the camera. With a streamed batch the zeroed commands
+// are written into its StreamBuffer and copied over on the GPU. Only needs GL 4.3 compute shaders (runs
+// under Mesa's llvmpipe).
+class GpuCuller
+{
+public:
+    GpuCuller();
+    GpuCuller(const GpuCuller &) = delete;
+    GpuCuller &operator=(const GpuCuller &) = delete;
+    // culls the instances of the batch's last Build() against the frustum, and meshlets facing away from the camera
+    void Run(const BatchRenderer &batch, const Frustum &frustum, const glm::vec3 &cameraPosition);
+    // draws the instances that survived the last Run()
+    void Draw(const BatchRenderer &batch) const { batch.DrawIndirect(this->CommandBuffer, this->VisibleBuffer); }
+    // reads the last Run() back (stalls the pipeline) and compares it with a CPU reference, returns true if they agree
+    bool Verify(const BatchRenderer &batch, const Frustum &frustum, const glm::vec3 &cameraPosition) const;
+    // deletes the GL buffers
+    void Destroy();
+
+    unsigned int CommandBuffer; // compacted DrawElementsIndirectCommands
+    unsigned int VisibleBuffer; // InstanceBuffer index per visible instance, grouped by command
+private:
+    ShaderHandle shader;
+    std::vector<DrawElementsIndirectCommand> resetCommands; // the batch's commands with instanceCount = 0, without a stream
+    size_t commandCapacity; // bytes allocated for CommandBuffer
+    size_t visibleCapacity; // bytes allocated for VisibleBuffer
+};
+
+#endif
@@ -0,0 +1,168 @@
+// LAKY'S SHADOW MAPS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_shadowmaps.h"
+
+#include <iostream>
+
+// how far behind a cascade's slice (towards the light) casters still throw shadows into it
+const float CASTER_RANGE = 20.0f;
+// near plane of the cube faces, anything closer to the point light casts no shadow
+const float CUBE_NEAR = 0.05f;
+
+// creates a depth texture, shadowMap ones compare against a reference (the shaders sample them as sampler*Shadow)
+static unsigned int createDepthTexture(GLenum target, unsigned int resolution, unsigned int layers, bool shadowMap)
+{
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(target, texture);
+    if (target == GL_TEXTURE_2D_ARRAY)
+        glTexStorage3D(target, 1, GL_DEPTH_COMPONENT32F, resolution, resolution, layers);
+    else
+        glTexStorage2D(target, 1, GL_DEPTH_COMPONENT32F, resolution, resolution);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, shadowMap ? GL_LINEAR : GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, shadowMap ? GL_LINEAR : GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    if (shadowMap)
+    {
+        glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    }
+    glBindTexture(target, 0);
+    return texture;
+}
+
+
+ShadowMaps::ShadowMaps(unsigned int cascadeCount, unsigned int cascadeResolution, unsigned int cubeResolution)
+    : cascadeResolution(cascadeResolution), cubeResolution(cubeResolution), cascades(cascadeCount, cascadeResolution, CASTER_RANGE),
+      cache(cascades.Count() + 6), caching(true)
+{
+    this->CascadeTexture = createDepthTexture(GL_TEXTURE_2D_ARRAY, cascadeResolution, cascades.Count(), true);
+    this->StaticCascadeTexture = createDepthTexture(GL_TEXTURE_2D_ARRAY, cascadeResolution, cascades.Count(), false);
+    this->CubeTexture = createDepthTexture(GL_TEXTURE_CUBE_MAP, cubeResolution, 6, true);
+    this->StaticCubeTexture = createDepthTexture(GL_TEXTURE_CUBE_MAP, cubeResolution, 6, false);
+
+    // depth only, one layer or face attached at a time
+    glGenFramebuffers(1, &this->FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->CascadeTexture, 0, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ERROR::SHADOW_MAPS: Framebuffer is not complete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    params.Set(params.Get().shadowLights, glm::ivec4(-1, -1, (int)cascades.Count(), 0));
+}
+
+void ShadowMaps::Update(const glm::mat4 &cameraView, const glm::vec3 &cameraForward, float fovY, float aspect, float near, float shadowDistance,
+                        const glm::vec3 &lightDirection, int lightIndex, const glm::vec3 &pointPosition, float pointRange, int pointIndex)
+{
+    cascades.Update(cameraView, fovY, aspect, near, shadowDistance, lightDirection);
+    glm::vec4 splits(0.0f), texels(0.0f);
+    for (unsigned int i = 0; i < cascades.Count(); i++)
+    {
+        const ShadowCascade &cascade = cascades.Cascade(i);
+        cache.SetView(i, cascade.view, cascade.projection);
+        params.Set(params.Get().cascadeMatrices[i], cascade.projection * cascade.view);
+        splits[i] = cascade.splitFar;
+        texels[i] = cascade.texelSize;
+    }
+    params.Set(params.Get().cascadeSplits, splits);
+    params.Set(params.Get().cascadeTexels, texels);
+    params.Set(params.Get().cameraForward, glm::vec4(cameraForward, 0.0f));
+
+    glm::mat4 faceViews[6], faceProjection;
+    CubeShadowViews(pointPosition, CUBE_NEAR, pointRange, faceViews, faceProjection);
+    for (unsigned int face = 0; face < 6; face++)
+        cache.SetView(cascades.Count() + face, faceViews[face], faceProjection);
+    // a 90 degree face spans 2 units one unit away from the light
+    params.Set(params.Get().cubeShadowPosition, glm::vec4(pointPosition, pointRange));
+    params.Set(params.Get().cubeShadowParams, glm::vec4(CUBE_NEAR, 2.0f / cubeResolution, 0.0f, 0.0f));
+    params.Set(params.Get().shadowLights, glm::ivec4(lightIndex, pointIndex, (int)cascades.Count(), 0));
+}
+
+void ShadowMaps::Render(const BatchRenderer &staticCasters, const BatchRenderer &dynamicCasters, Shader &depthShader)
+{
+    cache.BeginFrame();
+    if (!caching)
+        cache.InvalidateAll();
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+    // slope scaled bias against acne, the shaders add a normal offset on top
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+    depthShader.use();
+    for (unsigned int view = 0; view < cache.ViewCount(); view++)
+    {
+        if (!cache.NeedsUpdate(view))
+            continue;
+
+        depthShader.setMat4("projection", cache.Projection(view));
+        depthShader.setMat4("view", cache.View(view));
+        if (cache.NeedsStatic(view))
+        {
+            attach(view, true);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            staticCasters.Draw();
+        }
+        copyStatic(view);
+        attach(view, false);
+        dynamicCasters.Draw();
+        cache.MarkRendered(view);
+    }
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void ShadowMaps::Bind()
+{
+    params.Bind(SHADOW_BLOCK_BINDING);
+    glActiveTexture(GL_TEXTURE0 + SHADOW_CASCADE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, this->CascadeTexture);
+    glActiveTexture(GL_TEXTURE0 + SHADOW_CUBE_UNIT);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, this->CubeTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ShadowMaps::Destroy()
+{
+    unsigned int textures[4] = { this->CascadeTexture, this->StaticCascadeTexture, this->CubeTexture, this->StaticCubeTexture };
+    glDeleteTextures(4, textures);
+    glDeleteFramebuffers(1, &this->FBO);
+    this->CascadeTexture = this->StaticCascadeTexture = this->CubeTexture = this->StaticCubeTexture = this->FBO = 0;
+    params.Destroy();
+}
+
+
+void ShadowMaps::attach(unsigned int view, bool staticLayer)
+{
+    if (view < cascades.Count())
+    {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, staticLayer ? this->StaticCascadeTexture : this->CascadeTexture, 0, view);
+        glViewport(0, 0, cascadeResolution, cascadeResolution);
+    }
+    else
+    {
+        unsigned int face = view - cascades.Count();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, staticLayer ? this->StaticCubeTexture : this->CubeTexture, 0);
+        glViewport(0, 0, cubeResolution, cubeResolution);
+    }
+}
+
+void ShadowMaps::copyStatic(unsigned int view)
+{
+    // cube faces are addressed like array layers
+    bool cube = view >= cascades.Count();
+    GLenum target = cube ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D_ARRAY;
+    unsigned int layer = cube ? view - cascades.Count() : view;
+    unsigned int resolution = cube ? cubeResolution : cascadeResolution;
+    glCopyImageSubData(cube ? this->StaticCubeTexture : this->StaticCascadeTexture, target, 0, 0, 0, layer,
+                       cube ? this->CubeTexture : this->CascadeTexture, target, 0, 0, 0, layer, resolution, resolution, 1);
+}
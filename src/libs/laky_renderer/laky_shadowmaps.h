@@ -0,0 +1,81 @@
+#ifndef SHADOW_MAPS_H
+#define SHADOW_MAPS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "../laky_shadows/laky_shadowcache.h"
+#include "../laky_material/laky_uniformbuffer.h"
+#include "../laky_shader/laky_shader.h"
+#include "laky_batchrenderer.h"
+
+
+// texture units of the shadow maps, clear of the material maps and the G-buffer (see include/shadows.glsl)
+enum ShadowTextureUnit
+{
+    SHADOW_CASCADE_UNIT = 8,
+    SHADOW_CUBE_UNIT = 9
+};
+
+// std140 layout of the ShadowBlock uniform block in include/shadows.glsl
+struct ShadowParams
+{
+    glm::mat4  cascadeMatrices[ShadowCascades::MAX_CASCADES]; // world to light clip space of each cascade
+    glm::vec4  cascadeSplits;      // view depth where each cascade ends
+    glm::vec4  cascadeTexels;      // world size of a texel in each cascade
+    glm::vec4  cameraForward;      // view depth is measured along it
+    glm::vec4  cubeShadowPosition; // xyz = point light position, w = far plane of the cube faces
+    glm::vec4  cubeShadowParams;   // x = near plane of the cube faces, y = world size of a texel one unit away
+    glm::ivec4 shadowLights;       // x = LightBlock index of the cascaded light, y = of the cube mapped one (-1 = none), z = cascade count
+};
+
+// ShadowMaps renders cascaded shadow maps for one directional light and a
+// cube shadow map for one point light. Both live in depth textures with
+// hardware comparison (GL_LINEAR filtering gives 2x2 PCF); next to each
+// sits a copy holding only the static casters. The ShadowCache picks the
+// views (cascades, then the six cube faces) that have to be redrawn: a
+// view whose transform changed redraws its static copy, and any view out
+// of date gets the static copy blitted in with glCopyImageSubData and the
+// dynamic casters drawn on top. Everything else keeps last frame's depth.
+class ShadowMaps
+{
+public:
+    ShadowMaps(unsigned int cascadeCount, unsigned int cascadeResolution, unsigned int cubeResolution);
+    ShadowMaps(const ShadowMaps &) = delete;
+    ShadowMaps &operator=(const ShadowMaps &) = delete;
+    // places the cascades for a perspective camera (fovY in radians) and a light shining along lightDirection,
+    // and the cube faces around pointPosition; lightIndex / pointIndex are the lights' LightBlock slots (-1 = none)
+    void Update(const glm::mat4 &cameraView, const glm::vec3 &cameraForward, float fovY, float aspect, float near, float shadowDistance,
+                const glm::vec3 &lightDirection, int lightIndex, const glm::vec3 &pointPosition, float pointRange, int pointIndex);
+    // a caster changed, call with its bounds before and after (forwarded to the ShadowCache)
+    void Invalidate(const glm::vec3 &min, const glm::vec3 &max, bool isStatic) { cache.Invalidate(min, max, isStatic); }
+    // redraw everything every frame, for comparison with the cache
+    void SetCaching(bool enabled) { caching = enabled; }
+    // brings the out-of-date views up to date with a DEPTH_ONLY shader (projection and view uniforms), restores framebuffer 0 and the viewport
+    void Render(const BatchRenderer &staticCasters, const BatchRenderer &dynamicCasters, Shader &depthShader);
+    // binds the shadow maps and the ShadowBlock for drawing
+    void Bind();
+    const ShadowCache &Cache() const { return cache; }
+    const ShadowCascades &Cascades() const { return cascades; }
+    // deletes the textures, the framebuffer and the uniform buffer
+    void Destroy();
+
+    unsigned int CascadeTexture;       // GL_TEXTURE_2D_ARRAY, one layer per cascade
+    unsigned int CubeTexture;          // GL_TEXTURE_CUBE_MAP
+    unsigned int StaticCascadeTexture; // static casters only
+    unsigned int StaticCubeTexture;
+private:
+    unsigned int  cascadeResolution, cubeResolution;
+    unsigned int  FBO;
+    ShadowCascades cascades;
+    ShadowCache   cache;
+    bool          caching;
+    UniformBuffer<ShadowParams> params;
+
+    // attaches a cascade layer or cube face of a texture to the framebuffer and sets the viewport
+    void attach(unsigned int view, bool staticLayer);
+    // copies a view's static layer into its shadow map
+    void copyStatic(unsigned int view);
+};
+
+#endif
@@ -0,0 +1,121 @@
+// LAKY'S STREAM BUFFER v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_streambuffer.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// regions start on this boundary, which covers every binding alignment drivers ask for
+const size_t REGION_ALIGNMENT = 256;
+// longest single wait on a fence before checking again, in nanoseconds
+const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+
+StreamBuffer::StreamBuffer(size_t frameSize)
+    : mapped(NULL), region(0), used(0)
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformAlignment = alignment > 0 ? (size_t)alignment : REGION_ALIGNMENT;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    storageAlignment = alignment > 0 ? (size_t)alignment : REGION_ALIGNMENT;
+    this->frameSize = (frameSize + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+    memset(&stats, 0, sizeof(stats));
+    for (unsigned int i = 0; i < FRAME_COUNT; i++)
+        fences[i] = NULL;
+
+    // immutable storage, mapped once: the CPU writes while the GPU reads other regions, coherent so no flushes are needed
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &this->ID);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->ID);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, this->frameSize * FRAME_COUNT, NULL, flags);
+    mapped = (char *)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, this->frameSize * FRAME_COUNT, flags);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (mapped == NULL)
+        std::cout << "ERROR::STREAM_BUFFER: Could not map " << this->frameSize * FRAME_COUNT << " bytes persistently, streaming is off" << std::endl;
+}
+
+void StreamBuffer::BeginFrame()
+{
+    region = (region + 1) % FRAME_COUNT;
+    used = 0;
+    if (fences[region] == NULL)
+        return;
+
+    // usually signaled long ago; if not, the CPU is three frames ahead and has to wait anyway
+    GLenum result = glClientWaitSync(fences[region], 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        auto start = std::chrono::steady_clock::now();
+        do
+            result = glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+        while (result == GL_TIMEOUT_EXPIRED);
+        stats.waits++;
+        stats.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    glDeleteSync(fences[region]);
+    fences[region] = NULL;
+}
+
+void StreamBuffer::EndFrame()
+{
+    if (fences[region] != NULL)
+        glDeleteSync(fences[region]);
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    stats.usedBytes = used;
+    if (used > stats.peakBytes)
+        stats.peakBytes = used;
+}
+
+StreamAllocation StreamBuffer::Allocate(size_t size, size_t alignment)
+{
+    StreamAllocation allocation;
+    allocation.data = NULL;
+    allocation.offset = 0;
+    allocation.size = size;
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (mapped == NULL || start + size > frameSize)
+    {
+        // the caller falls back to uploading the usual way, FrameSize() is too small for the scene
+        if (stats.overflows++ == 0 && mapped != NULL)
+            std::cout << "ERROR::STREAM_BUFFER: A frame needs more than " << frameSize << " bytes, the rest is uploaded without streaming" << std::endl;
+        return allocation;
+    }
+    used = start + size;
+    allocation.offset = (GLintptr)(region * frameSize + start);
+    allocation.data = mapped + allocation.offset;
+    return allocation;
+}
+
+StreamAllocation StreamBuffer::Upload(const void *data, size_t size, size_t alignment)
+{
+    StreamAllocation allocation = Allocate(size, alignment);
+    if (allocation.data != NULL && size > 0)
+        memcpy(allocation.data, data, size);
+    return allocation;
+}
+
+void StreamBuffer::Destroy()
+{
+    for (unsigned int i = 0; i < FRAME_COUNT; i++)
+    {
+        if (fences[i] != NULL)
+        {
+            glClientWaitSync(fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+            glDeleteSync(fences[i]);
+            fences[i] = NULL;
+        }
+    }
+    if (mapped != NULL)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->ID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        mapped = NULL;
+    }
+    glDeleteBuffers(1, &this->ID);
+    this->ID = 0;
+}
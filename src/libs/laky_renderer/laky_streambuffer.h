@@ -0,0 +1,72 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+
+// a piece of a StreamBuffer, valid until the end of the frame it was allocated in
+struct StreamAllocation
+{
+    void    *data;   // where to write, NULL if the frame's region was full
+    GLintptr offset; // of the data inside StreamBuffer::ID, for binding ranges and indirect draws
+    size_t   size;
+};
+
+// per-frame numbers of a StreamBuffer
+struct StreamStats
+{
+    size_t       usedBytes;   // allocated in the last finished frame
+    size_t       peakBytes;   // most a frame ever allocated
+    unsigned int overflows;   // allocations that didn't fit so far (the caller fell back to its own buffer)
+    unsigned int waits;       // frames that had to wait for the GPU to release their region so far
+    double       waitMs;      // time spent waiting in total
+};
+
+// StreamBuffer is a bump allocator for data that lives for one frame:
+// instances, draw commands, light lists. One buffer is created with
+// glBufferStorage and stays mapped (persistent and coherent) for its whole
+// life, split into three regions used by consecutive frames in turn. A
+// fence after each frame's commands guards its region, so BeginFrame only
+// waits if the GPU is still three frames behind; writes go straight into
+// memory the GPU reads, with no glBufferData or glBufferSubData the
+// driver could stall on or would have to copy. Allocations are aligned,
+// so one buffer can serve vertex, indirect, uniform and storage bindings.
+class StreamBuffer
+{
+public:
+    static const unsigned int FRAME_COUNT = 3;
+
+    // frameSize = bytes each frame may allocate
+    explicit StreamBuffer(size_t frameSize);
+    StreamBuffer(const StreamBuffer &) = delete;
+    StreamBuffer &operator=(const StreamBuffer &) = delete;
+    // moves on to the next region, waiting until the GPU is done with the frame that used it last
+    void BeginFrame();
+    // fences the frame's region, call after its last command that reads from the buffer
+    void EndFrame();
+    // bump allocates from the frame's region, `alignment` must be a power of two; data is NULL if it doesn't fit
+    StreamAllocation Allocate(size_t size, size_t alignment);
+    // allocates and copies `data` in
+    StreamAllocation Upload(const void *data, size_t size, size_t alignment);
+    // offset alignments the GL wants for binding ranges as uniform and as shader storage buffers
+    size_t UniformAlignment() const { return uniformAlignment; }
+    size_t StorageAlignment() const { return storageAlignment; }
+    size_t FrameSize() const { return frameSize; }
+    const StreamStats &Stats() const { return stats; }
+    // unmaps and deletes the buffer, waiting for the GPU first
+    void Destroy();
+
+    unsigned int ID;
+private:
+    char        *mapped;
+    size_t       frameSize;
+    size_t       uniformAlignment, storageAlignment;
+    unsigned int region;   // region of the current frame
+    size_t       used;     // bytes allocated in it so far
+    GLsync       fences[FRAME_COUNT];
+    StreamStats  stats;
+};
+
+#endif
@@ -1,129 +1,679 @@
-// LAKY'S RESOURCE MANAGER v1.0.0
-// 2024.11.01.
-//==============================================================================
-
-#include "laky_resmanager.h"
-
-#include <iostream>
-#include <sstream>
-#include <fstream>
-
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
-// Instantiate static variables
-std::map<std::string, Texture2D>    ResourceManager::Textures;
-std::map<std::string, Shader>       ResourceManager::Shaders;
-
-
-Shader ResourceManager::LoadShader(const char *vShaderFile, const char *fShaderFile, std::string name)
-{
-    Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile);
-    return Shaders[name];
-}
-
-Shader ResourceManager::GetShader(std::string name)
-{
-    return Shaders[name];
-}
-
-Texture2D ResourceManager::LoadTexture(const char *file, bool alpha, std::string name)
-{
-    Textures[name] = loadTextureFromFile(file, alpha);
-    return Textures[name];
-}
-
-Texture2D ResourceManager::GetTexture(std::string name)
-{
-    return Textures[name];
-}
-
-void ResourceManager::Clear()
-{
-    // (properly) delete all shaders	
-    for (auto iter : Shaders)
-        glDeleteProgram(iter.second.ID);
-    // (properly) delete all textures
-    for (auto iter : Textures)
-        glDeleteTextures(1, &iter.second.ID);
-}
-
-Shader ResourceManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile)
-{
-    // 1. retrieve the vertex/fragment source code from filePath
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
-    try
-    {
-        // open files
-        std::ifstream vertexShaderFile(vShaderFile);
-        std::ifstream fragmentShaderFile(fShaderFile);
-        
-        if (!vertexShaderFile.is_open()) {
-            std::cout << "Failed to open vertex shader file: " << vShaderFile << std::endl;
-            throw std::runtime_error("Vertex shader file not found");
-        }
-        if (!fragmentShaderFile.is_open()) {
-            std::cout << "Failed to open fragment shader file: " << fShaderFile << std::endl;
-            throw std::runtime_error("Fragment shader file not found");
-        }
-
-        std::stringstream vShaderStream, fShaderStream;
-        // read file's buffer contents into streams
-        vShaderStream << vertexShaderFile.rdbuf();
-        fShaderStream << fragmentShaderFile.rdbuf();
-        
-        // close file handlers
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
-        
-        // convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-        
-        // Debug print
-        std::cout << "Loaded vertex shader:\n" << vertexCode << std::endl;
-        std::cout << "Loaded fragment shader:\n" << fragmentCode << std::endl;
-    }
-    catch (std::exception& e)
-    {
-        std::cout << "ERROR::SHADER: Failed to read shader files: " << e.what() << std::endl;
-    }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-    
-    // 2. now create shader object from source code
-    Shader shader;
-    shader.compile(vShaderCode, fShaderCode);
-    return shader;
-}
-
-Texture2D ResourceManager::loadTextureFromFile(const char *file, bool alpha)
-{
-    Texture2D texture;
-    
-    
-    // load image
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
-    
-    if (data == NULL) {
-        std::cout << "Failed to load texture: " << file << std::endl;
-        std::cout << "STB Reason: " << stbi_failure_reason() << std::endl;
-        return texture;
-    }
-
-    // Set format based on number of channels
-    if (nrChannels == 4 || alpha) {
-        texture.internal_format = GL_RGBA;
-        texture.image_format = GL_RGBA;
-    } else if (nrChannels == 3) {
-        texture.internal_format = GL_RGB;
-        texture.image_format = GL_RGB;
-    }
-
-    texture.Generate(width, height, data);
-    stbi_image_free(data);
-    return texture;
+// LAKY'S RESOURCE MANAGER v1.0.0
+// 2024.11.01.
+//==============================================================================
+
+#include "laky_resmanager.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+
+#include "laky_glext.h"
+#include "laky_shader/laky_preprocessor.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+// Instantiate static variables
+SlotMap<Texture2D, TextureTag>                     ResourceManager::Textures;
+SlotMap<Shader, ShaderTag>                         ResourceManager::Shaders;
+std::vector<TextureArray>                          ResourceManager::TextureArrays;
+std::unordered_map<std::string, ShaderHandle>      ResourceManager::shaderNames;
+std::unordered_map<std::string, TextureHandle>     ResourceManager::textureNames;
+std::vector<ResourceManager::ShaderRecord>         ResourceManager::shaderRecords;
+std::vector<ResourceManager::TextureRecord>        ResourceManager::textureRecords;
+std::vector<ResourceManager::LayerRecord>          ResourceManager::layerRecords;
+std::unordered_map<std::string, size_t>            ResourceManager::layerNames;
+std::vector<std::vector<unsigned int>>             ResourceManager::freeLayers;
+unsigned int                                       ResourceManager::layerVersion = 0;
+size_t                                             ResourceManager::textureBytes = 0;
+size_t                                             ResourceManager::textureBudget = 0;
+unsigned long long                                 ResourceManager::currentFrame = 0;
+unsigned int                                       ResourceManager::evictionCount = 0;
+size_t                                             ResourceManager::evictedBytes = 0;
+
+// layers a new texture array is created with, it doubles whenever it runs full
+const unsigned int INITIAL_ARRAY_LAYERS = 8;
+
+ShaderHandle ResourceManager::LoadShader(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines)
+{
+    return loadShader(vShaderFile, fShaderFile, name, defines, false);
+}
+
+ShaderHandle ResourceManager::LoadShaderAsync(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines)
+{
+    return loadShader(vShaderFile, fShaderFile, name, defines, true);
+}
+
+bool ResourceManager::IsShaderReady(ShaderHandle handle)
+{
+    return Shaders.Get(handle).isReady();
+}
+
+void ResourceManager::FinishShaders()
+{
+    for (size_t i = 0; i < Shaders.Size(); i++)
+    {
+        ShaderHandle handle = Shaders.HandleAt(i);
+        if (Shaders.Get(handle).isPending())
+            finishShader(handle);
+    }
+}
+
+ShaderHandle ResourceManager::loadShader(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines, bool async)
+{
+    Shader shader;
+    loadShaderFromFile(vShaderFile, fShaderFile, defines, shader, async);
+
+    ShaderHandle handle = storeShader(shader, name);
+    shaderRecords[handle.index].vertexPath = vShaderFile;
+    shaderRecords[handle.index].fragmentPath = fShaderFile;
+    shaderRecords[handle.index].computePath.clear();
+    shaderRecords[handle.index].defines = defines;
+    return handle;
+}
+
+ShaderHandle ResourceManager::LoadComputeShader(const char *cShaderFile, const std::string &name, const std::vector<std::string> &defines)
+{
+    Shader shader;
+    loadComputeFromFile(cShaderFile, defines, shader);
+
+    ShaderHandle handle = storeShader(shader, name);
+    shaderRecords[handle.index].vertexPath.clear();
+    shaderRecords[handle.index].fragmentPath.clear();
+    shaderRecords[handle.index].computePath = cShaderFile;
+    shaderRecords[handle.index].defines = defines;
+    return handle;
+}
+
+ShaderHandle ResourceManager::storeShader(const Shader &shader, const std::string &name)
+{
+    // reloading under a known name swaps the program in place so existing handles stay valid
+    ShaderHandle handle;
+    auto found = shaderNames.find(name);
+    if (found != shaderNames.end() && Shaders.Contains(found->second))
+    {
+        handle = found->second;
+        Shader &existing = Shaders.Get(handle);
+        existing.destroy();
+        existing = shader;
+        // a hot reload of the old program would overwrite the new one
+        shaderRecords[handle.index].reloaded.destroy();
+    }
+    else
+    {
+        handle = Shaders.Insert(shader);
+        shaderNames[name] = handle;
+        if (shaderRecords.size() <= handle.index)
+            shaderRecords.resize(handle.index + 1);
+    }
+    return handle;
+}
+
+Shader &ResourceManager::GetShader(ShaderHandle handle)
+{
+    Shader &shader = Shaders.Get(handle);
+    // the first use of an asynchronously loaded program is where we finally look at its status
+    if (shader.isPending())
+        finishShader(handle);
+    return shader;
+}
+
+ShaderHandle ResourceManager::FindShader(const std::string &name)
+{
+    auto found = shaderNames.find(name);
+    if (found == shaderNames.end() || !Shaders.Contains(found->second))
+    {
+        std::cout << "ERROR::RESOURCE_MANAGER: Unknown shader: " << name << std::endl;
+        return ShaderHandle();
+    }
+    return found->second;
+}
+
+TextureHandle ResourceManager::LoadTexture(const char *file, bool alpha, const std::string &name)
+{
+    Texture2D texture = loadTextureFromFile(file, alpha);
+    size_t bytes = texture.ByteSize();
+
+    auto found = textureNames.find(name);
+    if (found != textureNames.end() && Textures.Contains(found->second))
+    {
+        // replace in place, the old texture's bytes no longer count against the budget
+        TextureRecord &record = textureRecords[found->second.index];
+        Texture2D &existing = Textures.Get(found->second);
+        if (record.resident)
+        {
+            std::cout << "WARNING::RESOURCE_MANAGER: Replacing resident texture " << name << ", its bindless handle is no longer valid" << std::endl;
+            MakeTextureNonResident(found->second);
+        }
+        glDeleteTextures(1, &existing.ID);
+        textureBytes -= record.bytes;
+        // counts as used this frame, which also keeps the eviction below away from this slot
+        record.lastUsedFrame = currentFrame;
+        enforceTextureBudget(bytes);
+
+        Textures.Get(found->second) = texture;
+        record.path = file;
+        record.alpha = alpha;
+        record.bytes = bytes;
+        textureBytes += bytes;
+        return found->second;
+    }
+
+    enforceTextureBudget(bytes);
+
+    TextureHandle handle = Textures.Insert(texture);
+    if (textureRecords.size() <= handle.index)
+        textureRecords.resize(handle.index + 1);
+    TextureRecord &record = textureRecords[handle.index];
+    record.name = name;
+    record.path = file;
+    record.alpha = alpha;
+    record.bytes = bytes;
+    record.refCount = 0;
+    record.lastUsedFrame = currentFrame;
+    textureBytes += bytes;
+    textureNames[name] = handle;
+    return handle;
+}
+
+Texture2D &ResourceManager::GetTexture(TextureHandle handle)
+{
+    textureRecords[handle.index].lastUsedFrame = currentFrame;
+    return Textures.Get(handle);
+}
+
+TextureHandle ResourceManager::FindTexture(const std::string &name)
+{
+    auto found = textureNames.find(name);
+    if (found == textureNames.end() || !Textures.Contains(found->second))
+    {
+        std::cout << "ERROR::RESOURCE_MANAGER: Unknown texture: " << name << std::endl;
+        return TextureHandle();
+    }
+    return found->second;
+}
+
+TextureLayer ResourceManager::LoadTextureLayer(const char *file, const std::string &name)
+{
+    // always decode to RGBA so every same-size image can share an array
+    int width, height, nrChannels;
+    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 4);
+    if (data == NULL) {
+        std::cout << "Failed to load texture: " << file << std::endl;
+        std::cout << "STB Reason: " << stbi_failure_reason() << std::endl;
+        return TextureLayer();
+    }
+
+    TextureLayer location;
+    auto found = layerNames.find(name);
+    if (found != layerNames.end())
+    {
+        // reloading a name keeps its layer if the size still matches
+        location = layerRecords[found->second].location;
+        TextureArray &array = TextureArrays[location.array];
+        if (array.width == (unsigned int)width && array.height == (unsigned int)height)
+        {
+            array.SetLayer(location.layer, data);
+            layerRecords[found->second].path = file;
+            layerVersion++;
+            stbi_image_free(data);
+            return location;
+        }
+        // otherwise the image moves to an array of its new size and the old layer is free for the next image of the old one
+        freeLayers[location.array].push_back(location.layer);
+        location = TextureLayer();
+    }
+
+    for (size_t i = 0; i < TextureArrays.size() && !location.IsValid(); i++)
+    {
+        if (TextureArrays[i].width == (unsigned int)width && TextureArrays[i].height == (unsigned int)height)
+            location.array = (unsigned int)i;
+    }
+    if (!location.IsValid())
+    {
+        enforceTextureBudget((size_t)width * height * 4 * INITIAL_ARRAY_LAYERS);
+        TextureArrays.push_back(TextureArray());
+        TextureArrays.back().Generate(width, height, INITIAL_ARRAY_LAYERS);
+        freeLayers.push_back(std::vector<unsigned int>());
+        textureBytes += TextureArrays.back().ByteSize();
+        location.array = (unsigned int)TextureArrays.size() - 1;
+    }
+    location.layer = allocateLayer(location.array, data);
+    stbi_image_free(data);
+
+    LayerRecord record;
+    record.path = file;
+    record.location = location;
+    layerVersion++;
+    if (found != layerNames.end())
+        layerRecords[found->second] = record;
+    else
+    {
+        layerNames[name] = layerRecords.size();
+        layerRecords.push_back(record);
+    }
+    return location;
+}
+
+TextureLayer ResourceManager::FindTextureLayer(const std::string &name)
+{
+    auto found = layerNames.find(name);
+    if (found == layerNames.end())
+    {
+        std::cout << "ERROR::RESOURCE_MANAGER: Unknown texture layer: " << name << std::endl;
+        return TextureLayer();
+    }
+    return layerRecords[found->second].location;
+}
+
+TextureArray &ResourceManager::GetTextureArray(unsigned int array)
+{
+    return TextureArrays[array];
+}
+
+std::vector<std::string> ResourceManager::GetTextureLayerFiles()
+{
+    std::vector<std::string> files;
+    for (const LayerRecord &record : layerRecords)
+        files.push_back(record.path);
+    return files;
+}
+
+bool ResourceManager::IsTextureLoaded(TextureHandle handle)
+{
+    return Textures.Contains(handle);
+}
+
+void ResourceManager::UnloadTexture(TextureHandle handle)
+{
+    if (!Textures.Contains(handle))
+        return;
+
+    MakeTextureNonResident(handle);
+    TextureRecord &record = textureRecords[handle.index];
+    glDeleteTextures(1, &Textures.Get(handle).ID);
+    textureNames.erase(record.name);
+    textureBytes -= record.bytes;
+    Textures.Erase(handle);
+    record = TextureRecord();
+}
+
+void ResourceManager::AcquireTexture(TextureHandle handle)
+{
+    if (Textures.Contains(handle))
+        textureRecords[handle.index].refCount++;
+}
+
+void ResourceManager::ReleaseTexture(TextureHandle handle)
+{
+    // the texture may already be gone if Clear() ran while references were still alive
+    if (Textures.Contains(handle) && textureRecords[handle.index].refCount > 0)
+        textureRecords[handle.index].refCount--;
+}
+
+GLuint64 ResourceManager::MakeTextureResident(TextureHandle handle)
+{
+    if (!Textures.Contains(handle) || !GLExtensions::BindlessTexture)
+        return 0;
+
+    TextureRecord &record = textureRecords[handle.index];
+    GLuint64 bindless = Textures.Get(handle).GetHandle();
+    if (!record.resident)
+    {
+        GLExtensions::MakeTextureHandleResident(bindless);
+        record.resident = true;
+    }
+    return bindless;
+}
+
+void ResourceManager::MakeTextureNonResident(TextureHandle handle)
+{
+    if (!Textures.Contains(handle) || !textureRecords[handle.index].resident)
+        return;
+
+    GLExtensions::MakeTextureHandleNonResident(Textures.Get(handle).handle);
+    textureRecords[handle.index].resident = false;
+}
+
+void ResourceManager::SetTextureBudget(size_t bytes)
+{
+    textureBudget = bytes;
+    enforceTextureBudget(0);
+}
+
+void ResourceManager::BeginFrame()
+{
+    currentFrame++;
+}
+
+void ResourceManager::ReloadShaderFile(const std::string &path)
+{
+    // only programs whose sources (transitively) include the file need recompiling
+    std::vector<std::string> affected = ShaderPreprocessor::Invalidate(path);
+    if (affected.empty())
+        return;
+
+    for (size_t i = 0; i < Shaders.Size(); i++)
+    {
+        ShaderHandle handle = Shaders.HandleAt(i);
+        ShaderRecord &record = shaderRecords[handle.index];
+        if (std::find(affected.begin(), affected.end(), record.vertexPath) == affected.end() &&
+            std::find(affected.begin(), affected.end(), record.fragmentPath) == affected.end() &&
+            std::find(affected.begin(), affected.end(), record.computePath) == affected.end())
+            continue;
+
+        // only submit here, compiling all variants of a shader at once would stall the frame; a reload still in flight is outdated
+        record.reloaded.destroy();
+        Shader shader;
+        bool loaded = record.computePath.empty() ? loadShaderFromFile(record.vertexPath.c_str(), record.fragmentPath.c_str(), record.defines, shader, true)
+                                                 : loadComputeFromFile(record.computePath.c_str(), record.defines, shader, true);
+        if (!loaded)
+        {
+            std::cout << "ERROR::RESOURCE_MANAGER: Reload of " << path << " failed, keeping the previous program" << std::endl;
+            shader.destroy();
+            continue;
+        }
+        record.reloaded = shader;
+        record.reloadPath = path;
+    }
+}
+
+void ResourceManager::FinishShaderReloads()
+{
+    for (size_t i = 0; i < Shaders.Size(); i++)
+    {
+        ShaderHandle handle = Shaders.HandleAt(i);
+        ShaderRecord &record = shaderRecords[handle.index];
+        if (record.reloaded.ID == 0 || !record.reloaded.isReady())
+            continue;
+
+        if (!record.reloaded.finish())
+        {
+            if (record.computePath.empty())
+                std::cout << "Shader source strings:\n" << ShaderPreprocessor::DescribeSources(record.vertexPath) << ShaderPreprocessor::DescribeSources(record.fragmentPath) << std::endl;
+            else
+                std::cout << "Shader source strings:\n" << ShaderPreprocessor::DescribeSources(record.computePath) << std::endl;
+            std::cout << "ERROR::RESOURCE_MANAGER: Reload of " << record.reloadPath << " failed, keeping the previous program" << std::endl;
+            record.reloaded.destroy();
+            continue;
+        }
+
+        Shader &existing = Shaders.Get(handle);
+        existing.destroy();
+        existing = record.reloaded;
+        record.reloaded = Shader();
+        std::cout << "Reloaded shader program using " << record.reloadPath << std::endl;
+    }
+}
+
+void ResourceManager::ReloadTextureFile(const std::string &path, int width, int height, int nrChannels, unsigned char *data, const unsigned char *rgba)
+{
+    for (size_t i = 0; i < Textures.Size(); i++)
+    {
+        TextureHandle handle = Textures.HandleAt(i);
+        TextureRecord &record = textureRecords[handle.index];
+        if (record.path != path)
+            continue;
+
+        // re-specify the existing texture object so bound IDs and handles stay the same
+        Texture2D &texture = Textures.Get(handle);
+        if (texture.handle != 0)
+        {
+            // a texture with a bindless handle is immutable apart from its pixels
+            Texture2D format = texture;
+            setTextureFormat(format, nrChannels, record.alpha);
+            if (texture.width != (unsigned int)width || texture.height != (unsigned int)height || format.image_format != texture.image_format)
+            {
+                std::cout << "ERROR::RESOURCE_MANAGER: Reloaded " << path << " no longer matches its bindless texture, restart to pick it up" << std::endl;
+                continue;
+            }
+            texture.Update(data);
+            std::cout << "Reloaded texture " << path << std::endl;
+            continue;
+        }
+        setTextureFormat(texture, nrChannels, record.alpha);
+        texture.Generate(width, height, data);
+
+        textureBytes -= record.bytes;
+        record.bytes = texture.ByteSize();
+        textureBytes += record.bytes;
+        std::cout << "Reloaded texture " << path << std::endl;
+    }
+
+    // pooled layers are RGBA8 and can't change size here: unlike LoadTextureLayer there is no caller to hand a moved location to
+    for (const LayerRecord &record : layerRecords)
+    {
+        if (record.path != path)
+            continue;
+
+        TextureArray &array = TextureArrays[record.location.array];
+        if (array.width != (unsigned int)width || array.height != (unsigned int)height)
+        {
+            std::cout << "ERROR::RESOURCE_MANAGER: Reloaded " << path << " no longer matches its texture array size, restart to pick it up" << std::endl;
+            continue;
+        }
+        if (rgba == NULL)
+        {
+            std::cout << "ERROR::RESOURCE_MANAGER: Reloaded " << path << " was decoded before it became a texture layer, save it again" << std::endl;
+            continue;
+        }
+        array.SetLayer(record.location.layer, rgba);
+        std::cout << "Reloaded texture layer " << path << std::endl;
+    }
+}
+
+size_t ResourceManager::GetTextureBytes(TextureHandle handle)
+{
+    return Textures.Contains(handle) ? textureRecords[handle.index].bytes : 0;
+}
+
+ResourceStats ResourceManager::GetStats()
+{
+    ResourceStats stats;
+    stats.shaderCount = Shaders.Size();
+    stats.textureCount = Textures.Size();
+    stats.textureBytes = textureBytes;
+    stats.textureBudget = textureBudget;
+    stats.referencedBytes = 0;
+    stats.residentCount = 0;
+    stats.residentBytes = 0;
+    for (size_t i = 0; i < Textures.Size(); i++)
+    {
+        const TextureRecord &record = textureRecords[Textures.HandleAt(i).index];
+        if (record.refCount > 0)
+            stats.referencedBytes += record.bytes;
+        if (record.resident)
+        {
+            stats.residentCount++;
+            stats.residentBytes += record.bytes;
+        }
+    }
+    stats.arrayCount = TextureArrays.size();
+    stats.arrayBytes = 0;
+    for (const TextureArray &array : TextureArrays)
+        stats.arrayBytes += array.ByteSize();
+    stats.evictions = evictionCount;
+    stats.evictedBytes = evictedBytes;
+    return stats;
+}
+
+void ResourceManager::Clear()
+{
+    // (properly) delete all shaders	
+    for (Shader &shader : Shaders)
+        shader.destroy();
+    for (ShaderRecord &record : shaderRecords)
+        record.reloaded.destroy();
+    // (properly) delete all textures
+    for (size_t i = 0; i < Textures.Size(); i++)
+        MakeTextureNonResident(Textures.HandleAt(i));
+    for (const Texture2D &texture : Textures)
+        glDeleteTextures(1, &texture.ID);
+    for (TextureArray &array : TextureArrays)
+        array.Destroy();
+
+    Shaders.Clear();
+    Textures.Clear();
+    shaderNames.clear();
+    textureNames.clear();
+    ShaderPreprocessor::Clear();
+    shaderRecords.clear();
+    textureRecords.clear();
+    TextureArrays.clear();
+    layerRecords.clear();
+    layerNames.clear();
+    freeLayers.clear();
+    layerVersion++;
+    textureBytes = 0;
+}
+
+void ResourceManager::enforceTextureBudget(size_t incoming)
+{
+    if (textureBudget == 0)
+        return;
+
+    while (textureBytes + incoming > textureBudget)
+    {
+        // find the least recently used texture nobody holds a reference to (and that isn't resident or in use this frame)
+        TextureHandle victim;
+        unsigned long long oldest = currentFrame;
+        for (size_t i = 0; i < Textures.Size(); i++)
+        {
+            TextureHandle handle = Textures.HandleAt(i);
+            const TextureRecord &record = textureRecords[handle.index];
+            if (record.refCount == 0 && !record.resident && record.lastUsedFrame < oldest)
+            {
+                oldest = record.lastUsedFrame;
+                victim = handle;
+            }
+        }
+
+        if (!victim.IsValid())
+        {
+            std::cout << "WARNING::RESOURCE_MANAGER: Texture budget of " << textureBudget << " bytes exceeded, nothing left to evict" << std::endl;
+            return;
+        }
+
+        evictionCount++;
+        evictedBytes += textureRecords[victim.index].bytes;
+        UnloadTexture(victim);
+    }
+}
+
+unsigned int ResourceManager::allocateLayer(unsigned int array, const unsigned char *data)
+{
+    TextureArray &pool = TextureArrays[array];
+    std::vector<unsigned int> &free = freeLayers[array];
+    if (!free.empty())
+    {
+        unsigned int layer = free.back();
+        free.pop_back();
+        pool.SetLayer(layer, data);
+        return layer;
+    }
+
+    // a full array doubles, which costs its current size again
+    if (pool.layers == pool.capacity)
+    {
+        enforceTextureBudget(pool.ByteSize());
+        textureBytes += pool.ByteSize();
+    }
+    return pool.AddLayer(data);
+}
+
+bool ResourceManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const std::vector<std::string> &defines, Shader &shader, bool async)
+{
+    // 1. retrieve the vertex/fragment source code from filePath, resolving #includes
+    std::string vertexCode;
+    std::string fragmentCode;
+    if (!ShaderPreprocessor::Process(vShaderFile, defines, vertexCode) ||
+        !ShaderPreprocessor::Process(fShaderFile, defines, fragmentCode))
+    {
+        std::cout << "ERROR::SHADER: Failed to read shader files: " << vShaderFile << ", " << fShaderFile << std::endl;
+        return false;
+    }
+
+    const char *vShaderCode = vertexCode.c_str();
+    const char *fShaderCode = fragmentCode.c_str();
+    
+    // 2. now create shader object from source code
+    if (async)
+    {
+        shader.submit(vShaderCode, fShaderCode);
+        return true;
+    }
+    if (!shader.compile(vShaderCode, fShaderCode))
+    {
+        // error locations are reported as source_string(line), list which file is which
+        std::cout << "Shader source strings:\n" << ShaderPreprocessor::DescribeSources(vShaderFile) << ShaderPreprocessor::DescribeSources(fShaderFile) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ResourceManager::loadComputeFromFile(const char *cShaderFile, const std::vector<std::string> &defines, Shader &shader, bool async)
+{
+    std::string computeCode;
+    if (!ShaderPreprocessor::Process(cShaderFile, defines, computeCode))
+    {
+        std::cout << "ERROR::SHADER: Failed to read shader file: " << cShaderFile << std::endl;
+        return false;
+    }
+
+    if (async)
+    {
+        shader.submitCompute(computeCode.c_str());
+        return true;
+    }
+    if (!shader.compileCompute(computeCode.c_str()))
+    {
+        std::cout << "Shader source strings:\n" << ShaderPreprocessor::DescribeSources(cShaderFile) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ResourceManager::finishShader(ShaderHandle handle)
+{
+    if (!Shaders.Get(handle).finish())
+    {
+        const ShaderRecord &record = shaderRecords[handle.index];
+        std::cout << "Shader source strings:\n" << ShaderPreprocessor::DescribeSources(record.vertexPath) << ShaderPreprocessor::DescribeSources(record.fragmentPath) << std::endl;
+    }
+}
+
+Texture2D ResourceManager::loadTextureFromFile(const char *file, bool alpha)
+{
+    Texture2D texture;
+    
+    
+    // load image
+    int width, height, nrChannels;
+    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
+    
+    if (data == NULL) {
+        std::cout << "Failed to load texture: " << file << std::endl;
+        std::cout << "STB Reason: " << stbi_failure_reason() << std::endl;
+        return texture;
+    }
+
+    setTextureFormat(texture, nrChannels, alpha);
+
+    texture.Generate(width, height, data);
+    stbi_image_free(data);
+    return texture;
+}
+
+void ResourceManager::setTextureFormat(Texture2D &texture, int nrChannels, bool alpha)
+{
+    // Set format based on number of channels
+    if (nrChannels == 4 || alpha) {
+        texture.internal_format = GL_RGBA;
+        texture.image_format = GL_RGBA;
+    } else if (nrChannels == 3) {
+        texture.internal_format = GL_RGB;
+        texture.image_format = GL_RGB;
+    }
 }
\ No newline at end of file
@@ -1,43 +1,212 @@
-#ifndef RESOURCE_MANAGER_H
-#define RESOURCE_MANAGER_H
-
-#include <map>
-#include <string>
-
-#include <glad/glad.h>
-
-#include "laky_shader/laky_shader.h"
-#include "laky_texture/laky_texture.h"
-
-
-// A static singleton ResourceManager class that hosts several
-// functions to load Textures and Shaders. Each loaded texture
-// and/or shader is also stored for future reference by string
-// handles. All functions and resources are static and no 
-// public constructor is defined.
-class ResourceManager
-{
-public:
-    // resource storage
-    static std::map<std::string, Shader>    Shaders;
-    static std::map<std::string, Texture2D> Textures;
-    // loads (and generates) a shader program from file loading vertex, fragment (and geometry) shader's source code. If gShaderFile is not nullptr, it also loads a geometry shader
-    static Shader    LoadShader(const char *vShaderFile, const char *fShaderFile, std::string name);
-    // retrieves a stored sader
-    static Shader    GetShader(std::string name);
-    // loads (and generates) a texture from file
-    static Texture2D LoadTexture(const char *file, bool alpha, std::string name);
-    // retrieves a stored texture
-    static Texture2D GetTexture(std::string name);
-    // properly de-allocates all loaded resources
-    static void      Clear();
-private:
-    // private constructor, that is we do not want any actual resource manager objects. Its members and functions should be publicly available (static).
-    ResourceManager() { }
-    // loads and generates a shader from file
-    static Shader    loadShaderFromFile(const char *vShaderFile, const char *fShaderFile);
-    // loads a single texture from file
-    static Texture2D loadTextureFromFile(const char *file, bool alpha);
-};
-
+#ifndef RESOURCE_MANAGER_H
+#define RESOURCE_MANAGER_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "laky_slotmap.h"
+#include "laky_shader/laky_shader.h"
+#include "laky_texture/laky_texture.h"
+#include "laky_texture/laky_texturearray.h"
+
+
+// handle types returned by the ResourceManager
+struct ShaderTag {};
+struct TextureTag {};
+typedef Handle<ShaderTag>  ShaderHandle;
+typedef Handle<TextureTag> TextureHandle;
+
+// a texture stored as one layer of the ResourceManager's texture arrays
+struct TextureLayer
+{
+    unsigned int array = 0xFFFFFFFF; // index into ResourceManager::TextureArrays
+    unsigned int layer = 0;          // layer inside that array
+
+    bool IsValid() const { return array != 0xFFFFFFFF; }
+};
+
+// memory accounting reported by ResourceManager::GetStats
+struct ResourceStats
+{
+    size_t       shaderCount;
+    size_t       textureCount;
+    size_t       textureBytes;      // sum of Texture2D::ByteSize over all resident textures plus arrayBytes
+    size_t       textureBudget;     // 0 means unlimited
+    size_t       referencedBytes;   // bytes held by textures with a live TextureRef
+    size_t       arrayCount;        // texture arrays in the layer pool
+    size_t       arrayBytes;        // storage allocated by the texture arrays
+    size_t       residentCount;     // textures with a resident bindless handle
+    size_t       residentBytes;     // bytes held by those textures (never evicted)
+    unsigned int evictions;         // textures evicted since startup
+    size_t       evictedBytes;      // bytes released by evictions since startup
+};
+
+// A static singleton ResourceManager class that hosts several
+// functions to load Textures and Shaders. Each loaded texture
+// and/or shader is stored contiguously in a slot map and referred
+// to by a small typed handle; names are only interned once at load
+// time so the render loop never touches strings. All functions and
+// resources are static and no public constructor is defined.
+class ResourceManager
+{
+public:
+    // resource storage
+    static SlotMap<Shader, ShaderTag>     Shaders;
+    static SlotMap<Texture2D, TextureTag> Textures;
+    static std::vector<TextureArray>      TextureArrays;
+    // loads (and generates) a shader program from file loading vertex and fragment shader's source code, with optional #defines injected into both stages. Loading under an existing name replaces the old program and keeps its handle
+    static ShaderHandle  LoadShader(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines = std::vector<std::string>());
+    // like LoadShader, but only submits the program to the driver: compile status is checked when the program is first retrieved, so many programs compile in parallel while loading continues
+    static ShaderHandle  LoadShaderAsync(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines = std::vector<std::string>());
+    // loads (and generates) a compute program from file, with optional #defines. Loading under an existing name replaces the old program and keeps its handle
+    static ShaderHandle  LoadComputeShader(const char *cShaderFile, const std::string &name, const std::vector<std::string> &defines = std::vector<std::string>());
+    // true once an asynchronously loaded program can be retrieved without waiting on the driver
+    static bool          IsShaderReady(ShaderHandle handle);
+    // waits for every asynchronously loaded program and reports its errors
+    static void          FinishShaders();
+    // retrieves a stored shader, the handle must be valid (O(1), no allocation; finishes a pending program first)
+    static Shader       &GetShader(ShaderHandle handle);
+    // looks up a shader handle by name, returns an invalid handle if nothing was loaded under that name
+    static ShaderHandle  FindShader(const std::string &name);
+    // loads (and generates) a texture from file. Loading under an existing name replaces the old texture and keeps its handle
+    static TextureHandle LoadTexture(const char *file, bool alpha, const std::string &name);
+    // retrieves a stored texture, the handle must be valid (O(1), no allocation)
+    static Texture2D    &GetTexture(TextureHandle handle);
+    // looks up a texture handle by name, returns an invalid handle if nothing was loaded under that name
+    static TextureHandle FindTexture(const std::string &name);
+    // loads an image as a layer of the texture array pool. Images are grouped by size (always stored as RGBA8),
+    // so same-size textures end up in one GL_TEXTURE_2D_ARRAY and can be used together with a single bind.
+    // Loading under an existing name with a new size moves the image and returns its new location, the old
+    // layer is reused by the next image of that size. Arrays count against the texture budget (their growth
+    // evicts unreferenced textures) but are never evicted themselves, layers are not reference counted
+    static TextureLayer  LoadTextureLayer(const char *file, const std::string &name);
+    // looks up a texture layer by name, returns an invalid layer if nothing was loaded under that name
+    static TextureLayer  FindTextureLayer(const std::string &name);
+    // retrieves one of the pooled texture arrays
+    static TextureArray &GetTextureArray(unsigned int array);
+    // the files behind pooled texture layers, and a number that changes whenever they may have (used by hot reload)
+    static std::vector<std::string> GetTextureLayerFiles();
+    static unsigned int  GetTextureLayerVersion() { return layerVersion; }
+    // true if the handle refers to a texture that is still resident (it may have been evicted)
+    static bool          IsTextureLoaded(TextureHandle handle);
+    // frees a single texture right away, regardless of references
+    static void          UnloadTexture(TextureHandle handle);
+    // reference counting used by TextureRef, referenced textures are never evicted
+    static void          AcquireTexture(TextureHandle handle);
+    static void          ReleaseTexture(TextureHandle handle);
+    // makes the texture's bindless handle resident and returns it (0 without GL_ARB_bindless_texture). Resident textures
+    // are never evicted, since shaders may sample them at any time. Replacing the texture by loading under its name drops residency
+    static GLuint64      MakeTextureResident(TextureHandle handle);
+    // makes the texture's bindless handle non-resident again, the handle must no longer be used by shaders
+    static void          MakeTextureNonResident(TextureHandle handle);
+    // sets the texture memory budget in bytes (0 = unlimited) and evicts right away if needed
+    static void          SetTextureBudget(size_t bytes);
+    // marks the start of a new frame, used to track when textures were last used
+    static void          BeginFrame();
+    // resubmits every shader program built from the given source file to the driver, the old programs stay in use meanwhile
+    static void          ReloadShaderFile(const std::string &path);
+    // swaps in the reloaded programs the driver has finished, call once per frame; a program that failed to compile keeps
+    // its previous version. Without GL_KHR_parallel_shader_compile programs count as finished a frame after their reload
+    static void          FinishShaderReloads();
+    // re-specifies every texture loaded from the given file with already decoded pixels (handles stay valid), pooled
+    // layers take `rgba`, the same image decoded with 4 requested channels (may be `data` if it has 4 channels anyway,
+    // NULL if the file wasn't known to back a layer when it was decoded)
+    static void          ReloadTextureFile(const std::string &path, int width, int height, int nrChannels, unsigned char *data, const unsigned char *rgba);
+    // returns the byte size the manager accounted for a texture
+    static size_t        GetTextureBytes(TextureHandle handle);
+    // returns current memory accounting
+    static ResourceStats GetStats();
+    // properly de-allocates all loaded resources
+    static void          Clear();
+private:
+    // bookkeeping kept per shader slot, indexed by handle.index
+    struct ShaderRecord
+    {
+        std::string              vertexPath;
+        std::string              fragmentPath;
+        std::string              computePath;   // set instead of the other two for compute programs
+        std::vector<std::string> defines;
+        Shader                   reloaded;      // submitted by ReloadShaderFile and waiting for the driver (ID 0 = none)
+        std::string              reloadPath;    // the changed file that caused it
+    };
+    // bookkeeping kept per texture slot, indexed by handle.index so it survives dense reordering
+    struct TextureRecord
+    {
+        std::string        name;
+        std::string        path;
+        bool               alpha = false;
+        size_t             bytes = 0;
+        unsigned int       refCount = 0;
+        unsigned long long lastUsedFrame = 0;
+        bool               resident = false;
+    };
+    // bookkeeping per pooled texture layer, used by hot reload
+    struct LayerRecord
+    {
+        std::string  path;
+        TextureLayer location;
+    };
+    // interned resource names, only consulted at load time
+    static std::unordered_map<std::string, ShaderHandle>  shaderNames;
+    static std::unordered_map<std::string, TextureHandle> textureNames;
+    static std::vector<ShaderRecord>  shaderRecords;
+    static std::vector<TextureRecord> textureRecords;
+    static std::vector<LayerRecord>   layerRecords;
+    static std::unordered_map<std::string, size_t> layerNames; // name -> index into layerRecords
+    static std::vector<std::vector<unsigned int>>  freeLayers; // per texture array, layers left behind by images that changed size
+    static unsigned int       layerVersion;  // bumped whenever a layer record's file changes
+    static size_t             textureBytes;
+    static size_t             textureBudget;
+    static unsigned long long currentFrame;
+    static unsigned int       evictionCount;
+    static size_t             evictedBytes;
+    // evicts unreferenced textures, least recently used first, until `incoming` more bytes fit in the budget
+    static void enforceTextureBudget(size_t incoming);
+    // stores an RGBA8 image in a layer of the array, reusing a free layer before growing it
+    static unsigned int allocateLayer(unsigned int array, const unsigned char *data);
+    // private constructor, that is we do not want any actual resource manager objects. Its members and functions should be publicly available (static).
+    ResourceManager() { }
+    // shared implementation of LoadShader and LoadShaderAsync
+    static ShaderHandle loadShader(const char *vShaderFile, const char *fShaderFile, const std::string &name, const std::vector<std::string> &defines, bool async);
+    // loads and generates a shader from file (only submitting it if async), returns false if reading or compiling failed
+    static bool      loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const std::vector<std::string> &defines, Shader &shader, bool async = false);
+    // loads and generates a compute program from file, returns false if reading or compiling failed
+    static bool      loadComputeFromFile(const char *cShaderFile, const std::vector<std::string> &defines, Shader &shader, bool async = false);
+    // stores a freshly loaded program under a name, replacing any program already loaded under it
+    static ShaderHandle storeShader(const Shader &shader, const std::string &name);
+    // checks a pending program's result and reports errors against its source files
+    static void      finishShader(ShaderHandle handle);
+    // loads a single texture from file
+    static Texture2D loadTextureFromFile(const char *file, bool alpha);
+    // picks the texture formats for an image with the given channel count
+    static void      setTextureFormat(Texture2D &texture, int nrChannels, bool alpha);
+};
+
+// A reference-counted texture handle. While at least one TextureRef to a
+// texture is alive the ResourceManager will never evict it; plain
+// TextureHandles are weak and may go stale once the budget is exceeded.
+class TextureRef
+{
+public:
+    TextureRef() { }
+    explicit TextureRef(TextureHandle handle) : handle(handle) { if (handle.IsValid()) ResourceManager::AcquireTexture(handle); }
+    TextureRef(const TextureRef &other) : handle(other.handle) { if (handle.IsValid()) ResourceManager::AcquireTexture(handle); }
+    TextureRef(TextureRef &&other) : handle(other.handle) { other.handle = TextureHandle(); }
+    ~TextureRef() { reset(); }
+    TextureRef &operator=(TextureRef other) { std::swap(handle, other.handle); return *this; }
+
+    // drops the reference
+    void reset() { if (handle.IsValid()) ResourceManager::ReleaseTexture(handle); handle = TextureHandle(); }
+
+    TextureHandle get() const { return handle; }
+    Texture2D &operator*() const { return ResourceManager::GetTexture(handle); }
+    Texture2D *operator->() const { return &ResourceManager::GetTexture(handle); }
+private:
+    TextureHandle handle;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,292 @@
+// LAKY'S SHADER PREPROCESSOR v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_preprocessor.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Instantiate static variables
+std::unordered_map<std::string, ShaderPreprocessor::ParsedFile>                     ShaderPreprocessor::parsedFiles;
+std::unordered_map<std::string, int>                                                ShaderPreprocessor::fileIds;
+std::unordered_map<std::string, std::unordered_set<std::string>>                    ShaderPreprocessor::includes;
+std::unordered_map<std::string, std::unordered_set<std::string>>                    ShaderPreprocessor::includedBy;
+std::unordered_map<std::string, std::unordered_map<std::string, std::string>>       ShaderPreprocessor::expanded;
+
+
+// collapses "." and ".." components so the same file always gets the same key
+static std::string normalizePath(const std::string &path)
+{
+    std::vector<std::string> parts;
+    std::stringstream stream(path);
+    std::string part;
+    while (std::getline(stream, part, '/'))
+    {
+        if (part.empty() || part == ".")
+            continue;
+        if (part == ".." && !parts.empty() && parts.back() != "..")
+            parts.pop_back();
+        else
+            parts.push_back(part);
+    }
+
+    std::string result = path.size() > 0 && path[0] == '/' ? "/" : "";
+    for (size_t i = 0; i < parts.size(); i++)
+        result += (i > 0 ? "/" : "") + parts[i];
+    return result;
+}
+
+// returns the directive name of a preprocessor line ("# version" -> "version") and where its arguments start
+static std::string directiveName(const std::string &line, size_t &argsStart)
+{
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos == std::string::npos || line[pos] != '#')
+        return std::string();
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos)
+        return std::string();
+    size_t end = line.find_first_of(" \t\r", pos);
+    if (end == std::string::npos)
+        end = line.size();
+    argsStart = end;
+    return line.substr(pos, end - pos);
+}
+
+
+bool ShaderPreprocessor::Process(const std::string &path, const std::vector<std::string> &defines, std::string &output)
+{
+    std::string root = normalizePath(path);
+
+    std::string key;
+    for (const std::string &define : defines)
+        key += define + "\n";
+
+    // fully expanded sources are cached per define set, several programs (and variants) share them
+    std::unordered_map<std::string, std::string> &variants = expanded[root];
+    auto cached = variants.find(key);
+    if (cached != variants.end())
+    {
+        output = cached->second;
+        return true;
+    }
+
+    const ParsedFile *file = parse(root);
+    if (file == NULL)
+        return false;
+
+    int id = fileId(root);
+    std::string defineBlock;
+    for (const std::string &define : defines)
+        defineBlock += "#define " + define + "\n";
+
+    output.clear();
+    std::vector<std::string> stack(1, root);
+    std::unordered_set<std::string> onceFiles;
+    if (file->pragmaOnce)
+        onceFiles.insert(root);
+
+    // #version has to stay first, so the defines go right after it (or on top if there is none)
+    if (file->versionSegment < 0)
+        output += defineBlock;
+
+    for (size_t i = 0; i < file->segments.size(); i++)
+    {
+        const Segment &segment = file->segments[i];
+        if (segment.isInclude)
+        {
+            includes[root].insert(segment.text);
+            includedBy[segment.text].insert(root);
+            if (!expand(segment.text, stack, onceFiles, output))
+                return false;
+            continue;
+        }
+
+        if ((int)i > file->versionSegment)
+            output += "#line " + std::to_string(segment.line) + " " + std::to_string(id) + "\n";
+        output += segment.text;
+        if ((int)i == file->versionSegment)
+            output += defineBlock;
+    }
+
+    variants[key] = output;
+    return true;
+}
+
+std::vector<std::string> ShaderPreprocessor::Invalidate(const std::string &path)
+{
+    std::string changed = normalizePath(path);
+
+    // walk the include graph upwards to find everything that pulled the file in
+    std::vector<std::string> affected;
+    std::vector<std::string> open(1, changed);
+    std::unordered_set<std::string> visited;
+    while (!open.empty())
+    {
+        std::string file = open.back();
+        open.pop_back();
+        if (!visited.insert(file).second)
+            continue;
+
+        if (expanded.count(file))
+        {
+            affected.push_back(file);
+            expanded.erase(file);
+        }
+        auto parents = includedBy.find(file);
+        if (parents != includedBy.end())
+            open.insert(open.end(), parents->second.begin(), parents->second.end());
+    }
+
+    // the changed file gets re-parsed, its outgoing edges are re-recorded on the next expansion
+    parsedFiles.erase(changed);
+    auto children = includes.find(changed);
+    if (children != includes.end())
+    {
+        for (const std::string &child : children->second)
+            includedBy[child].erase(changed);
+        includes.erase(children);
+    }
+    return affected;
+}
+
+std::string ShaderPreprocessor::DescribeSources(const std::string &path)
+{
+    std::string description;
+    std::vector<std::string> open(1, normalizePath(path));
+    std::unordered_set<std::string> visited;
+    while (!open.empty())
+    {
+        std::string file = open.back();
+        open.pop_back();
+        if (!visited.insert(file).second)
+            continue;
+
+        description += std::to_string(fileId(file)) + ": " + file + "\n";
+        auto children = includes.find(file);
+        if (children != includes.end())
+            open.insert(open.end(), children->second.begin(), children->second.end());
+    }
+    return description;
+}
+
+void ShaderPreprocessor::Clear()
+{
+    parsedFiles.clear();
+    includes.clear();
+    includedBy.clear();
+    expanded.clear();
+}
+
+const ShaderPreprocessor::ParsedFile *ShaderPreprocessor::parse(const std::string &path)
+{
+    auto cached = parsedFiles.find(path);
+    if (cached != parsedFiles.end())
+        return &cached->second;
+
+    std::ifstream stream(path);
+    if (!stream.is_open())
+    {
+        std::cout << "ERROR::SHADER_PREPROCESSOR: Failed to open shader file: " << path << std::endl;
+        return NULL;
+    }
+
+    std::string directory;
+    size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos)
+        directory = path.substr(0, slash + 1);
+
+    ParsedFile file;
+    Segment run = { false, std::string(), 1 };
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        size_t argsStart = 0;
+        std::string directive = directiveName(line, argsStart);
+
+        if (directive == "include")
+        {
+            size_t open = line.find_first_of("\"<", argsStart);
+            size_t close = open == std::string::npos ? std::string::npos : line.find_first_of("\">", open + 1);
+            if (close == std::string::npos)
+            {
+                std::cout << "ERROR::SHADER_PREPROCESSOR: Malformed #include in " << path << "(" << lineNumber << ")" << std::endl;
+                return NULL;
+            }
+
+            if (!run.text.empty())
+                file.segments.push_back(run);
+            Segment include = { true, normalizePath(directory + line.substr(open + 1, close - open - 1)), lineNumber };
+            file.segments.push_back(include);
+            run = Segment{ false, std::string(), lineNumber + 1 };
+            continue;
+        }
+
+        if (directive == "pragma" && line.find("once", argsStart) != std::string::npos)
+        {
+            // keep the line count intact, GLSL itself doesn't know the pragma
+            file.pragmaOnce = true;
+            run.text += "\n";
+            continue;
+        }
+
+        run.text += line + "\n";
+        if (directive == "version")
+        {
+            file.segments.push_back(run);
+            file.versionSegment = (int)file.segments.size() - 1;
+            run = Segment{ false, std::string(), lineNumber + 1 };
+        }
+    }
+    if (!run.text.empty())
+        file.segments.push_back(run);
+
+    return &(parsedFiles[path] = file);
+}
+
+bool ShaderPreprocessor::expand(const std::string &path, std::vector<std::string> &stack, std::unordered_set<std::string> &onceFiles, std::string &output)
+{
+    if (std::find(stack.begin(), stack.end(), path) != stack.end())
+    {
+        std::cout << "ERROR::SHADER_PREPROCESSOR: Recursive #include of " << path << " from " << stack.back() << std::endl;
+        return false;
+    }
+
+    const ParsedFile *file = parse(path);
+    if (file == NULL)
+        return false;
+    if (file->pragmaOnce && !onceFiles.insert(path).second)
+        return true;
+
+    int id = fileId(path);
+    stack.push_back(path);
+    for (const Segment &segment : file->segments)
+    {
+        if (segment.isInclude)
+        {
+            includes[path].insert(segment.text);
+            includedBy[segment.text].insert(path);
+            if (!expand(segment.text, stack, onceFiles, output))
+                return false;
+            continue;
+        }
+        output += "#line " + std::to_string(segment.line) + " " + std::to_string(id) + "\n";
+        output += segment.text;
+    }
+    stack.pop_back();
+    return true;
+}
+
+int ShaderPreprocessor::fileId(const std::string &path)
+{
+    auto found = fileIds.find(path);
+    if (found != fileIds.end())
+        return found->second;
+    int id = (int)fileIds.size();
+    fileIds[path] = id;
+    return id;
+}
@@ -0,0 +1,60 @@
+#ifndef SHADER_PREPROCESSOR_H
+#define SHADER_PREPROCESSOR_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+// A small GLSL preprocessor run before sources are handed to the driver.
+// It resolves #include "file" (relative to the including file, with
+// #pragma once support), injects #defines right after #version and emits
+// #line directives so compiler errors still point at the right file and
+// line (the source string number is the id listed by DescribeSources).
+// Parsed files and fully expanded sources are cached, and the include
+// graph is recorded so a changed include only invalidates its dependents.
+// All functions are static, like the ResourceManager.
+class ShaderPreprocessor
+{
+public:
+    // expands a shader file with the given defines ("NAME" or "NAME VALUE"), returns false if a file could not be read
+    static bool Process(const std::string &path, const std::vector<std::string> &defines, std::string &output);
+    // forgets a changed file and returns every processed top-level file that depends on it (including itself)
+    static std::vector<std::string> Invalidate(const std::string &path);
+    // lists "id: path" for every file a processed shader pulled in, to decode compiler error locations
+    static std::string DescribeSources(const std::string &path);
+    // drops all caches
+    static void Clear();
+private:
+    // a file split into plain text runs and include directives, parsed once
+    struct Segment
+    {
+        bool        isInclude;
+        std::string text;  // source text, or the resolved path for includes
+        int         line;  // 1-based line the segment starts on
+    };
+    struct ParsedFile
+    {
+        std::vector<Segment> segments;
+        bool                 pragmaOnce = false;
+        int                  versionSegment = -1; // segment holding the #version line, -1 if none
+    };
+
+    static std::unordered_map<std::string, ParsedFile> parsedFiles;
+    static std::unordered_map<std::string, int>        fileIds;
+    // include graph edges in both directions
+    static std::unordered_map<std::string, std::unordered_set<std::string>> includes;
+    static std::unordered_map<std::string, std::unordered_set<std::string>> includedBy;
+    // fully expanded sources per top-level file, keyed by the define set
+    static std::unordered_map<std::string, std::unordered_map<std::string, std::string>> expanded;
+
+    // parses (or returns the cached parse of) a file
+    static const ParsedFile *parse(const std::string &path);
+    // appends the expansion of a file to output
+    static bool expand(const std::string &path, std::vector<std::string> &stack, std::unordered_set<std::string> &onceFiles, std::string &output);
+    // returns the numeric id used as GLSL source string number for a file
+    static int fileId(const std::string &path);
+};
+
+#endif
@@ -1,128 +1,227 @@
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <glad/glad.h>
-#include <glm/glm.hpp>
-#include <glm/ext.hpp>
-
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-
-class Shader
-{
-public:
-    unsigned int ID;
-    
-    void compile(const char* vertexSource, const char* fragmentSource)
-    {
-        // Create shader objects
-        unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
-        unsigned int fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        
-        // Compile vertex shader
-        glShaderSource(vertex, 1, &vertexSource, NULL);
-        glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
-        
-        // Compile fragment shader
-        glShaderSource(fragment, 1, &fragmentSource, NULL);
-        glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
-        
-
-        // Create shader program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-            
-        // Link program
-        glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
-        
-        // Delete shaders after linking
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
-    }
-
-    // activate the shader
-    // ------------------------------------------------------------------------
-    void use() const
-    { 
-        glUseProgram(ID); 
-    }
-    // utility uniform functions
-    // ------------------------------------------------------------------------
-    void setFloat(const char *name, float value)
-    {
-
-        glUniform1f(glGetUniformLocation(this->ID, name), value);
-    }
-    void setInt(const char *name, int value)
-    {
-
-        glUniform1i(glGetUniformLocation(this->ID, name), value);
-    }
-    void setVec2f(const char *name, float x, float y)
-    {
-
-        glUniform2f(glGetUniformLocation(this->ID, name), x, y);
-    }
-    void setVec2f(const char *name, const glm::vec2 &value)
-    {
-
-        glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
-    }
-    void setVec3f(const char *name, float x, float y, float z)
-    {
-
-        glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
-    }
-    void setVec3f(const char *name, const glm::vec3 &value)
-    {
-
-        glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
-    }
-    void setVec4f(const char *name, float x, float y, float z, float w)
-    {
-
-        glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
-    }
-    void setVec4f(const char *name, const glm::vec4 &value)
-    {
-
-        glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
-    }
-    void setMat4(const char *name, const glm::mat4 &matrix)
-    {
-
-        glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
-    }
-
-private:
-    void checkCompileErrors(GLuint shader, std::string type)
-    {
-        GLint success;
-        GLchar infoLog[1024];
-        if (type != "PROGRAM")
-        {
-            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-            if (!success)
-            {
-                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-            }
-        }
-        else
-        {
-            glGetProgramiv(shader, GL_LINK_STATUS, &success);
-            if (!success)
-            {
-                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-            }
-        }
-    }
-};
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/ext.hpp>
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include "../laky_glext.h"
+
+class Shader
+{
+public:
+    unsigned int ID = 0;
+    
+    // compiles and links the program, returns false (after printing the info log) if any stage failed
+    bool compile(const char* vertexSource, const char* fragmentSource)
+    {
+        submit(vertexSource, fragmentSource);
+        return finish();
+    }
+
+    // hands the sources to the driver without waiting for the result, so several
+    // programs can compile in parallel (GL_KHR_parallel_shader_compile). Errors
+    // are only checked by finish()
+    void submit(const char* vertexSource, const char* fragmentSource)
+    {
+        // Create shader objects
+        vertex = glCreateShader(GL_VERTEX_SHADER);
+        fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        
+        // Compile vertex shader
+        glShaderSource(vertex, 1, &vertexSource, NULL);
+        glCompileShader(vertex);
+        
+        // Compile fragment shader
+        glShaderSource(fragment, 1, &fragmentSource, NULL);
+        glCompileShader(fragment);
+        
+
+        // Create shader program
+        ID = glCreateProgram();
+        glAttachShader(ID, vertex);
+        glAttachShader(ID, fragment);
+            
+        // Link program
+        glLinkProgram(ID);
+        pending = true;
+    }
+
+    // compiles and links a compute program, returns false (after printing the info log) if it failed
+    bool compileCompute(const char* computeSource)
+    {
+        submitCompute(computeSource);
+        return finish();
+    }
+
+    // like submit(), for a compute program
+    void submitCompute(const char* computeSource)
+    {
+        compute = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(compute, 1, &computeSource, NULL);
+        glCompileShader(compute);
+
+        ID = glCreateProgram();
+        glAttachShader(ID, compute);
+        glLinkProgram(ID);
+        pending = true;
+    }
+
+    // true once the driver is done with a submitted program, never blocks (with the extension)
+    bool isReady() const
+    {
+        if (!pending || !GLExtensions::ParallelShaderCompile)
+            return true;
+        GLint done = GL_FALSE;
+        glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
+
+    // true if the program was submitted but finish() hasn't run yet
+    bool isPending() const
+    {
+        return pending;
+    }
+
+    // checks the result of a submitted program (waiting for it if needed), returns false if any stage failed
+    bool finish()
+    {
+        if (!pending)
+            return true;
+
+        bool success = true;
+        if (compute != 0)
+            success = checkCompileErrors(compute, "COMPUTE");
+        else
+        {
+            success = checkCompileErrors(vertex, "VERTEX");
+            success = checkCompileErrors(fragment, "FRAGMENT") && success;
+        }
+        success = checkCompileErrors(ID, "PROGRAM") && success;
+
+        // Delete shaders after linking
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        glDeleteShader(compute);
+        vertex = fragment = compute = 0;
+        pending = false;
+        return success;
+    }
+
+    // deletes the program (and any shader objects still waiting on finish())
+    void destroy()
+    {
+        if (pending)
+        {
+            glDeleteShader(vertex);
+            glDeleteShader(fragment);
+            glDeleteShader(compute);
+            vertex = fragment = compute = 0;
+            pending = false;
+        }
+        glDeleteProgram(ID);
+        ID = 0;
+    }
+
+    // activate the shader
+    // ------------------------------------------------------------------------
+    void use() const
+    { 
+        glUseProgram(ID); 
+    }
+    // utility uniform functions
+    // ------------------------------------------------------------------------
+    void setFloat(const char *name, float value)
+    {
+
+        glUniform1f(glGetUniformLocation(this->ID, name), value);
+    }
+    void setInt(const char *name, int value)
+    {
+
+        glUniform1i(glGetUniformLocation(this->ID, name), value);
+    }
+    void setUInt(const char *name, unsigned int value)
+    {
+
+        glUniform1ui(glGetUniformLocation(this->ID, name), value);
+    }
+    void setVec2f(const char *name, float x, float y)
+    {
+
+        glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    }
+    void setVec2f(const char *name, const glm::vec2 &value)
+    {
+
+        glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    }
+    void setVec3f(const char *name, float x, float y, float z)
+    {
+
+        glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    }
+    void setVec3f(const char *name, const glm::vec3 &value)
+    {
+
+        glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    }
+    void setVec4f(const char *name, float x, float y, float z, float w)
+    {
+
+        glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    }
+    void setVec4f(const char *name, const glm::vec4 &value)
+    {
+
+        glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    }
+    void setVec4fArray(const char *name, const glm::vec4 *values, int count)
+    {
+
+        glUniform4fv(glGetUniformLocation(this->ID, name), count, glm::value_ptr(values[0]));
+    }
+    void setMat4(const char *name, const glm::mat4 &matrix)
+    {
+
+        glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    }
+
+private:
+    // shader objects of a submitted program, kept until finish() checked them
+    unsigned int vertex = 0;
+    unsigned int fragment = 0;
+    unsigned int compute = 0;
+    bool pending = false;
+
+    bool checkCompileErrors(GLuint shader, std::string type)
+    {
+        GLint success;
+        GLchar infoLog[1024];
+        if (type != "PROGRAM")
+        {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success)
+            {
+                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            }
+        }
+        else
+        {
+            glGetProgramiv(shader, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+                std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+            }
+        }
+        return success != 0;
+    }
+};
 #endif
\ No newline at end of file
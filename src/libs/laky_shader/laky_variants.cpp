@@ -0,0 +1,105 @@
+// LAKY'S SHADER VARIANTS v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_variants.h"
+
+#include <iostream>
+
+
+ShaderVariants::ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath, const std::string &name, const std::vector<KeywordGroup> &groups)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath), name(name), groups(groups)
+{
+    unsigned int count = 1;
+    for (const KeywordGroup &group : this->groups)
+        count *= group.empty() ? 1 : (unsigned int)group.size();
+    handles.resize(count);
+}
+
+unsigned int ShaderVariants::Key(const std::vector<unsigned int> &options) const
+{
+    unsigned int key = 0;
+    unsigned int stride = 1;
+    for (size_t i = 0; i < groups.size(); i++)
+    {
+        unsigned int option = i < options.size() ? options[i] : 0;
+        if (option >= groups[i].size())
+        {
+            std::cout << "ERROR::SHADER_VARIANTS: Option " << option << " out of range for group " << i << " of " << name << std::endl;
+            option = 0;
+        }
+        key += option * stride;
+        stride *= groups[i].empty() ? 1 : (unsigned int)groups[i].size();
+    }
+    return key;
+}
+
+unsigned int ShaderVariants::Key(std::initializer_list<const char *> keywords) const
+{
+    std::vector<unsigned int> options(groups.size(), 0);
+    for (const char *keyword : keywords)
+    {
+        bool found = false;
+        for (size_t i = 0; i < groups.size() && !found; i++)
+        {
+            for (size_t j = 0; j < groups[i].size(); j++)
+            {
+                if (groups[i][j] == keyword)
+                {
+                    options[i] = (unsigned int)j;
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found)
+            std::cout << "ERROR::SHADER_VARIANTS: Unknown keyword " << keyword << " for " << name << std::endl;
+    }
+    return Key(options);
+}
+
+Shader &ShaderVariants::Get(unsigned int key)
+{
+    return ResourceManager::GetShader(GetHandle(key));
+}
+
+ShaderHandle ShaderVariants::GetHandle(unsigned int key)
+{
+    if (!handles[key].IsValid())
+        compile(key, false);
+    return handles[key];
+}
+
+void ShaderVariants::Submit(unsigned int key)
+{
+    if (!handles[key].IsValid())
+        compile(key, true);
+}
+
+void ShaderVariants::CompileAll()
+{
+    for (unsigned int key = 0; key < handles.size(); key++)
+        Submit(key);
+}
+
+void ShaderVariants::compile(unsigned int key, bool async)
+{
+    // decode the key back into one keyword per group
+    std::vector<std::string> defines;
+    unsigned int rest = key;
+    for (const KeywordGroup &group : groups)
+    {
+        if (group.empty())
+            continue;
+        const std::string &keyword = group[rest % group.size()];
+        rest /= (unsigned int)group.size();
+        if (!keyword.empty())
+            defines.push_back(keyword);
+    }
+
+    std::string variantName = name + "#" + std::to_string(key);
+    if (async)
+        handles[key] = ResourceManager::LoadShaderAsync(vertexPath.c_str(), fragmentPath.c_str(), variantName, defines);
+    else
+        handles[key] = ResourceManager::LoadShader(vertexPath.c_str(), fragmentPath.c_str(), variantName, defines);
+}
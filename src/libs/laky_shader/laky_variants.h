@@ -0,0 +1,52 @@
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "../laky_resmanager.h"
+
+
+// a set of mutually exclusive keywords, each one becomes a #define ("" means none of them)
+typedef std::vector<std::string> KeywordGroup;
+
+// ShaderVariants builds permutations of one vertex/fragment source pair.
+// Every combination of one keyword per group is a variant, identified by
+// a mixed-radix key (group 0 is the lowest digit). Keys are worked out
+// once at setup time with Key(); at draw time Get(key) is an array index,
+// compiling the variant on first use unless Submit() or CompileAll()
+// already handed it to the driver (in which case the driver compiles them
+// in parallel and the status is checked on first use).
+// Programs are owned by the ResourceManager, so they hot reload like any
+// other shader.
+class ShaderVariants
+{
+public:
+    ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath, const std::string &name, const std::vector<KeywordGroup> &groups);
+    // builds a key from one option index per group (missing trailing groups use option 0)
+    unsigned int Key(const std::vector<unsigned int> &options) const;
+    // builds a key from keyword names, groups without a listed keyword use option 0
+    unsigned int Key(std::initializer_list<const char *> keywords) const;
+    // returns the program of a variant, compiling it if needed. Don't hold on to the reference across loads
+    Shader      &Get(unsigned int key);
+    // returns the program handle of a variant, compiling it if needed
+    ShaderHandle GetHandle(unsigned int key);
+    // submits a variant for asynchronous compilation if it isn't compiled yet
+    void         Submit(unsigned int key);
+    // submits every variant that isn't compiled yet, they compile in parallel and are finished on first use
+    void         CompileAll();
+    // number of possible variants
+    unsigned int Count() const { return (unsigned int)handles.size(); }
+private:
+    std::string               vertexPath;
+    std::string               fragmentPath;
+    std::string               name;
+    std::vector<KeywordGroup> groups;
+    std::vector<ShaderHandle> handles; // indexed by key, invalid until compiled
+
+    // compiles (or only submits) a single variant through the ResourceManager
+    void compile(unsigned int key, bool async);
+};
+
+#endif
@@ -0,0 +1,173 @@
+// LAKY'S SHADOW CACHE v1.0.0
+// 2026.10.19.
+//==============================================================================
+
+#include "laky_shadowcache.h"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// blend between logarithmic (1) and uniform (0) cascade splits
+const float SPLIT_LAMBDA = 0.75f;
+// cascades are fit to spheres this much larger than their slice, the margin the camera can move before a refit
+const float CASCADE_SLACK = 0.25f;
+
+
+ShadowCache::ShadowCache(unsigned int viewCount)
+    : views(viewCount), stats()
+{
+    for (CachedView &view : views)
+    {
+        view.view = view.projection = glm::mat4(1.0f);
+        view.frustum = Frustum(view.projection * view.view);
+        view.staticValid = view.dynamicValid = false;
+    }
+}
+
+void ShadowCache::BeginFrame()
+{
+    stats.views = (unsigned int)views.size();
+    stats.staticPasses = stats.dynamicPasses = 0;
+    stats.skippedPasses = 2 * stats.views;
+}
+
+void ShadowCache::SetView(unsigned int index, const glm::mat4 &view, const glm::mat4 &projection)
+{
+    CachedView &cached = views[index];
+    if (view == cached.view && projection == cached.projection)
+        return;
+
+    cached.view = view;
+    cached.projection = projection;
+    cached.frustum = Frustum(projection * view);
+    cached.staticValid = cached.dynamicValid = false;
+}
+
+void ShadowCache::Invalidate(const glm::vec3 &min, const glm::vec3 &max, bool isStatic)
+{
+    for (CachedView &view : views)
+    {
+        if (!view.frustum.IntersectsAABB(min, max))
+            continue;
+        if (isStatic)
+            view.staticValid = false;
+        else
+            view.dynamicValid = false;
+    }
+}
+
+void ShadowCache::InvalidateAll()
+{
+    for (CachedView &view : views)
+        view.staticValid = view.dynamicValid = false;
+}
+
+void ShadowCache::MarkRendered(unsigned int index)
+{
+    CachedView &view = views[index];
+    if (!view.staticValid)
+    {
+        stats.staticPasses++;
+        stats.skippedPasses--;
+    }
+    // the shadow map is rebuilt from the static layer whenever either one was out of date
+    stats.dynamicPasses++;
+    stats.skippedPasses--;
+    view.staticValid = view.dynamicValid = true;
+}
+
+
+ShadowCascades::ShadowCascades(unsigned int count, unsigned int resolution, float casterRange)
+    : count(count < MAX_CASCADES ? count : MAX_CASCADES), resolution(resolution), casterRange(casterRange), lightDirection(0.0f), fitted(false)
+{
+    for (ShadowCascade &cascade : cascades)
+    {
+        cascade.view = cascade.projection = glm::mat4(1.0f);
+        cascade.center = glm::vec3(0.0f);
+        cascade.radius = cascade.splitFar = cascade.texelSize = 0.0f;
+    }
+}
+
+unsigned int ShadowCascades::Update(const glm::mat4 &cameraView, float fovY, float aspect, float near, float shadowDistance, const glm::vec3 &lightDirection)
+{
+    // a new light direction turns every cascade
+    glm::vec3 direction = glm::normalize(lightDirection);
+    bool refitAll = !fitted || direction != this->lightDirection;
+    this->lightDirection = direction;
+    fitted = true;
+
+    // distance from the view axis to a frustum corner, per unit of depth
+    float tanHalfY = std::tan(fovY * 0.5f);
+    float tanHalfX = tanHalfY * aspect;
+    float cornerScale = std::sqrt(tanHalfX * tanHalfX + tanHalfY * tanHalfY);
+    glm::mat4 cameraToWorld = glm::inverse(cameraView);
+
+    unsigned int changed = 0;
+    float splitNear = near;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        float t = (float)(i + 1) / count;
+        float logSplit = near * std::pow(shadowDistance / near, t);
+        float uniformSplit = near + (shadowDistance - near) * t;
+        float splitFar = SPLIT_LAMBDA * logSplit + (1.0f - SPLIT_LAMBDA) * uniformSplit;
+
+        // smallest sphere around the slice: its center sits on the view axis, as far in as the far corners allow
+        float nearCorner = splitNear * cornerScale, farCorner = splitFar * cornerScale;
+        float centerDepth = (farCorner * farCorner + splitFar * splitFar - nearCorner * nearCorner - splitNear * splitNear) / (2.0f * (splitFar - splitNear));
+        centerDepth = std::fmin(centerDepth, splitFar);
+        float radius = std::sqrt((splitFar - centerDepth) * (splitFar - centerDepth) + farCorner * farCorner);
+        glm::vec3 center = glm::vec3(cameraToWorld * glm::vec4(0.0f, 0.0f, -centerDepth, 1.0f));
+
+        // keep the cascade while the slice still fits inside the sphere it was fit to
+        ShadowCascade &cascade = cascades[i];
+        cascade.splitFar = splitFar;
+        if (refitAll || glm::distance(center, cascade.center) + radius > cascade.radius)
+        {
+            fit(i, center, radius * (1.0f + CASCADE_SLACK));
+            changed |= 1u << i;
+        }
+        splitNear = splitFar;
+    }
+    return changed;
+}
+
+void ShadowCascades::fit(unsigned int index, const glm::vec3 &center, float radius)
+{
+    ShadowCascade &cascade = cascades[index];
+    glm::vec3 up = std::fabs(lightDirection.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    // moving the center by whole texels across the light keeps edges from crawling when a cascade gets refit
+    float texelSize = 2.0f * radius / resolution;
+    glm::mat4 rotation = glm::lookAt(glm::vec3(0.0f), lightDirection, up);
+    glm::vec3 lightSpace = glm::vec3(rotation * glm::vec4(center, 1.0f));
+    lightSpace.x = std::floor(lightSpace.x / texelSize) * texelSize;
+    lightSpace.y = std::floor(lightSpace.y / texelSize) * texelSize;
+    glm::vec3 snapped = glm::vec3(glm::inverse(rotation) * glm::vec4(lightSpace, 1.0f));
+
+    // the eye backs off towards the light so casters outside the slice still land in the map
+    cascade.view = glm::lookAt(snapped - lightDirection * (radius + casterRange), snapped, up);
+    cascade.projection = glm::ortho(-radius, radius, -radius, radius, 0.0f, 2.0f * radius + casterRange);
+    cascade.center = snapped;
+    cascade.radius = radius;
+    cascade.texelSize = texelSize;
+}
+
+
+void CubeShadowViews(const glm::vec3 &position, float near, float far, glm::mat4 views[6], glm::mat4 &projection)
+{
+    // the cube map convention looks down each axis with y flipped (z for the vertical faces)
+    static const glm::vec3 directions[6] = {
+        glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(-1.0f,  0.0f,  0.0f),
+        glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec3( 0.0f, -1.0f,  0.0f),
+        glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3( 0.0f,  0.0f, -1.0f)
+    };
+    static const glm::vec3 ups[6] = {
+        glm::vec3(0.0f, -1.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f),
+        glm::vec3(0.0f,  0.0f,  1.0f), glm::vec3(0.0f,  0.0f, -1.0f),
+        glm::vec3(0.0f, -1.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)
+    };
+    for (int face = 0; face < 6; face++)
+        views[face] = glm::lookAt(position, position + directions[face], ups[face]);
+    projection = glm::perspective(glm::radians(90.0f), 1.0f, near, far);
+}
@@ -0,0 +1,109 @@
+#ifndef SHADOW_CACHE_H
+#define SHADOW_CACHE_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../laky_frustum.h"
+
+
+// shadow map passes of the current frame, counted by ShadowCache
+struct ShadowCacheStats
+{
+    unsigned int views;         // shadow views (cascades and cube faces)
+    unsigned int staticPasses;  // static casters drawn into a view's cached layer
+    unsigned int dynamicPasses; // cached layer copied into a view's shadow map and the dynamic casters drawn on top
+    unsigned int skippedPasses; // passes left out because the depth from an earlier frame was still valid (two per view at most)
+};
+
+// ShadowCache decides which shadow views (cascades, cube map faces) have to
+// be rendered again. Every view keeps two layers of depth: the static
+// casters, only redrawn when the view's transform changes or a static
+// caster inside it changed, and the shadow map itself, which is the static
+// layer plus the dynamic casters and is redrawn when either layer is out
+// of date. A view whose transform stayed put and whose frustum no caster
+// moved through keeps last frame's depth, so a still light costs nothing
+// for the parts of the scene that don't move.
+class ShadowCache
+{
+public:
+    explicit ShadowCache(unsigned int viewCount);
+    // starts counting a new frame
+    void BeginFrame();
+    // sets a view's transform, a different one invalidates both of its layers
+    void SetView(unsigned int index, const glm::mat4 &view, const glm::mat4 &projection);
+    // a caster changed, call with its bounds before and after the change: every view that sees either box draws that layer again
+    void Invalidate(const glm::vec3 &min, const glm::vec3 &max, bool isStatic);
+    // every view redraws both layers (caching off, or the casters themselves were replaced)
+    void InvalidateAll();
+
+    bool NeedsStatic(unsigned int index) const { return !views[index].staticValid; }
+    bool NeedsUpdate(unsigned int index) const { return !views[index].staticValid || !views[index].dynamicValid; }
+    // records that the view was brought up to date, with its static layer redrawn if NeedsStatic() said so
+    void MarkRendered(unsigned int index);
+
+    unsigned int ViewCount() const { return (unsigned int)views.size(); }
+    const glm::mat4 &View(unsigned int index) const { return views[index].view; }
+    const glm::mat4 &Projection(unsigned int index) const { return views[index].projection; }
+    const ShadowCacheStats &Stats() const { return stats; }
+private:
+    struct CachedView
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        Frustum   frustum;
+        bool      staticValid;
+        bool      dynamicValid;
+    };
+    std::vector<CachedView> views;
+    ShadowCacheStats        stats;
+};
+
+// one cascade of a ShadowCascades set
+struct ShadowCascade
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 center;    // sphere the cascade was fit to, in world space
+    float     radius;
+    float     splitFar;  // view depth where this cascade hands over to the next one
+    float     texelSize; // world size of one shadow map texel
+};
+
+// ShadowCascades splits the view range of a camera into cascades for a
+// directional light (practical split scheme, blending logarithmic and
+// uniform splits) and fits an orthographic shadow view around each slice.
+// A cascade is fit to a bounding sphere a bit larger than its slice, with
+// the center snapped to whole texels, and is kept as long as the slice
+// stays inside that sphere: small camera moves and turns leave the
+// matrices untouched, so the ShadowCache can keep the depth.
+class ShadowCascades
+{
+public:
+    static const unsigned int MAX_CASCADES = 4;
+
+    // resolution of the shadow map in texels, casterRange how far behind a slice (towards the light) casters are still caught
+    ShadowCascades(unsigned int count, unsigned int resolution, float casterRange);
+    // fits the cascades to a perspective camera (fovY in radians) whose shadows end at shadowDistance, for a light
+    // shining along lightDirection; returns a bit per cascade that got new matrices
+    unsigned int Update(const glm::mat4 &cameraView, float fovY, float aspect, float near, float shadowDistance, const glm::vec3 &lightDirection);
+
+    unsigned int Count() const { return count; }
+    const ShadowCascade &Cascade(unsigned int index) const { return cascades[index]; }
+private:
+    unsigned int  count;
+    unsigned int  resolution;
+    float         casterRange;
+    glm::vec3     lightDirection;
+    ShadowCascade cascades[MAX_CASCADES];
+    bool          fitted;
+
+    // fits cascade i around a sphere and snaps it to the texel grid
+    void fit(unsigned int index, const glm::vec3 &center, float radius);
+};
+
+// view matrices of the six faces of a point light's cube shadow map in GL face order (+X, -X, +Y, -Y, +Z, -Z), all sharing one 90 degree projection
+void CubeShadowViews(const glm::vec3 &position, float near, float far, glm::mat4 views[6], glm::mat4 &projection);
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+
+// A compact, typed reference into a SlotMap. The Tag parameter is never
+// instantiated, it only makes sure a handle to one kind of resource can't be
+// passed where a handle to another kind is expected.
+template <typename Tag>
+struct Handle
+{
+    uint32_t index = 0;      // slot index inside the owning SlotMap
+    uint32_t generation = 0; // generation of the slot when the handle was issued, 0 is never valid
+
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const Handle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle &other) const { return !(*this == other); }
+};
+
+// A generational slot map. Values live contiguously in a dense array (so
+// iterating all of them is a linear walk), while handles go through a sparse
+// slot table that remembers where each value currently lives. Erasing a value
+// bumps its slot's generation so stale handles are detected instead of
+// silently aliasing whatever gets stored in the slot next.
+template <typename T, typename Tag>
+class SlotMap
+{
+public:
+    typedef Handle<Tag> HandleType;
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    // stores a value and returns the handle that refers to it
+    HandleType Insert(T value)
+    {
+        uint32_t slotIndex;
+        if (!freeSlots.empty())
+        {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot());
+        }
+
+        Slot &slot = slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(values.size());
+        values.push_back(std::move(value));
+        denseToSlot.push_back(slotIndex);
+
+        HandleType handle;
+        handle.index = slotIndex;
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    // true if the handle still refers to a live value
+    bool Contains(HandleType handle) const
+    {
+        return handle.generation != 0 && handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+
+    // retrieves a live value, the handle must be valid
+    T &Get(HandleType handle)
+    {
+        assert(Contains(handle));
+        return values[slots[handle.index].denseIndex];
+    }
+    const T &Get(HandleType handle) const
+    {
+        assert(Contains(handle));
+        return values[slots[handle.index].denseIndex];
+    }
+
+    // retrieves a value or nullptr if the handle is stale
+    T *TryGet(HandleType handle)
+    {
+        return Contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // removes a value, moving the last value into its place to keep storage dense
+    bool Erase(HandleType handle)
+    {
+        if (!Contains(handle))
+            return false;
+
+        Slot &slot = slots[handle.index];
+        uint32_t hole = slot.denseIndex;
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+        if (hole != last)
+        {
+            values[hole] = std::move(values[last]);
+            denseToSlot[hole] = denseToSlot[last];
+            slots[denseToSlot[hole]].denseIndex = hole;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        // 0 is reserved for "never valid", skip it when the counter wraps
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    // rebuilds the handle of the value at a dense position (useful while iterating)
+    HandleType HandleAt(size_t denseIndex) const
+    {
+        HandleType handle;
+        handle.index = denseToSlot[denseIndex];
+        handle.generation = slots[handle.index].generation;
+        return handle;
+    }
+
+    // drops every value, all outstanding handles become stale
+    void Clear()
+    {
+        for (size_t i = 0; i < denseToSlot.size(); i++)
+        {
+            Slot &slot = slots[denseToSlot[i]];
+            if (++slot.generation == 0)
+                slot.generation = 1;
+            freeSlots.push_back(denseToSlot[i]);
+        }
+        values.clear();
+        denseToSlot.clear();
+    }
+
+    size_t Size() const { return values.size(); }
+    bool Empty() const { return values.empty(); }
+
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+
+private:
+    struct Slot
+    {
+        uint32_t denseIndex = 0;
+        uint32_t generation = 1;
+    };
+
+    std::vector<Slot>     slots;       // sparse table indexed by handle.index
+    std::vector<T>        values;      // densely packed values
+    std::vector<uint32_t> denseToSlot; // back-reference from a dense position to its slot
+    std::vector<uint32_t> freeSlots;   // recycled slot indices
+};
+
+#endif
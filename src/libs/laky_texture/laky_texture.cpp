@@ -1,31 +1,59 @@
-#include <iostream>
-
-#include "laky_texture.h"
-
-
-Texture2D::Texture2D()
-    : width(0), height(0), internal_format(GL_RGB), image_format(GL_RGB), wrap_S(GL_REPEAT), wrap_T(GL_REPEAT), filter_min(GL_LINEAR), filter_max(GL_LINEAR)
-{
-    glGenTextures(1, &this->ID);
-}
-
-void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char* data)
-{
-    this->width = width;
-    this->height = height;
-    // create Texture
-    glBindTexture(GL_TEXTURE_2D, this->ID);
-    glTexImage2D(GL_TEXTURE_2D, 0, this->internal_format, width, height, 0, this->image_format, GL_UNSIGNED_BYTE, data);
-    // set Texture wrap and filter modes
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->wrap_S);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, this->wrap_T);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->filter_min);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->filter_max);
-    // unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
-}
-
-void Texture2D::Bind() const
-{
-    glBindTexture(GL_TEXTURE_2D, this->ID);
+#include <iostream>
+
+#include "laky_texture.h"
+#include "../laky_glext.h"
+
+
+Texture2D::Texture2D()
+    : width(0), height(0), internal_format(GL_RGB), image_format(GL_RGB), wrap_S(GL_REPEAT), wrap_T(GL_REPEAT), filter_min(GL_LINEAR), filter_max(GL_LINEAR), handle(0)
+{
+    glGenTextures(1, &this->ID);
+}
+
+void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char* data)
+{
+    this->width = width;
+    this->height = height;
+    // create Texture
+    glBindTexture(GL_TEXTURE_2D, this->ID);
+    glTexImage2D(GL_TEXTURE_2D, 0, this->internal_format, width, height, 0, this->image_format, GL_UNSIGNED_BYTE, data);
+    // set Texture wrap and filter modes
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->wrap_S);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, this->wrap_T);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->filter_min);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->filter_max);
+    // unbind texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::Update(unsigned char* data)
+{
+    glBindTexture(GL_TEXTURE_2D, this->ID);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, this->width, this->height, this->image_format, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+GLuint64 Texture2D::GetHandle()
+{
+    if (this->handle == 0 && GLExtensions::BindlessTexture)
+        this->handle = GLExtensions::GetTextureHandle(this->ID);
+    return this->handle;
+}
+
+void Texture2D::Bind() const
+{
+    glBindTexture(GL_TEXTURE_2D, this->ID);
+}
+
+size_t Texture2D::ByteSize() const
+{
+    size_t bytesPerTexel;
+    switch (this->internal_format)
+    {
+    case GL_RED:  bytesPerTexel = 1; break;
+    case GL_RG:   bytesPerTexel = 2; break;
+    case GL_RGB:  bytesPerTexel = 3; break;
+    default:      bytesPerTexel = 4; break;
+    }
+    return (size_t)this->width * this->height * bytesPerTexel;
 }
\ No newline at end of file
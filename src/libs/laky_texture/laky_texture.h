@@ -1,31 +1,42 @@
-#ifndef TEXTURE_H
-#define TEXTURE_H
-
-#include <glad/glad.h>
-
-// Texture2D is able to store and configure a texture in OpenGL.
-// It also hosts utility functions for easy management.
-class Texture2D
-{
-public:
-    // holds the ID of the texture object, used for all texture operations to reference to this particular texture
-    unsigned int ID;
-    // texture image dimensions
-    unsigned int width, height; // width and height of loaded image in pixels
-    // texture Format
-    unsigned int internal_format; // format of texture object
-    unsigned int image_format; // format of loaded image
-    // texture configuration
-    unsigned int wrap_S; // wrapping mode on S axis
-    unsigned int wrap_T; // wrapping mode on T axis
-    unsigned int filter_min; // filtering mode if texture pixels < screen pixels
-    unsigned int filter_max; // filtering mode if texture pixels > screen pixels
-    // constructor (sets default texture modes)
-    Texture2D();
-    // generates texture from image data
-    void Generate(unsigned int width, unsigned int height, unsigned char* data);
-    // binds the texture as the current active GL_TEXTURE_2D texture object
-    void Bind() const;
-};
-
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+// Texture2D is able to store and configure a texture in OpenGL.
+// It also hosts utility functions for easy management.
+class Texture2D
+{
+public:
+    // holds the ID of the texture object, used for all texture operations to reference to this particular texture
+    unsigned int ID;
+    // texture image dimensions
+    unsigned int width, height; // width and height of loaded image in pixels
+    // texture Format
+    unsigned int internal_format; // format of texture object
+    unsigned int image_format; // format of loaded image
+    // texture configuration
+    unsigned int wrap_S; // wrapping mode on S axis
+    unsigned int wrap_T; // wrapping mode on T axis
+    unsigned int filter_min; // filtering mode if texture pixels < screen pixels
+    unsigned int filter_max; // filtering mode if texture pixels > screen pixels
+    // bindless handle (GL_ARB_bindless_texture), 0 until requested. Once it exists the texture's
+    // storage and sampling state are frozen, only its pixels can still be updated
+    GLuint64 handle;
+    // constructor (sets default texture modes)
+    Texture2D();
+    // generates texture from image data
+    void Generate(unsigned int width, unsigned int height, unsigned char* data);
+    // replaces the pixels of an already generated texture (same size and format), also allowed once a bindless handle exists
+    void Update(unsigned char* data);
+    // returns the bindless handle, creating it on first use (0 if the extension is missing). Residency is managed by the ResourceManager
+    GLuint64 GetHandle();
+    // binds the texture as the current active GL_TEXTURE_2D texture object
+    void Bind() const;
+    // approximate GPU memory used by the texture (width * height * bytes per texel of internal_format)
+    size_t ByteSize() const;
+};
+
 #endif
\ No newline at end of file
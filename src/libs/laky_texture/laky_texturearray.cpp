@@ -0,0 +1,74 @@
+#include <iostream>
+
+#include "laky_texturearray.h"
+
+
+TextureArray::TextureArray()
+    : ID(0), width(0), height(0), layers(0), capacity(0), wrap_S(GL_REPEAT), wrap_T(GL_REPEAT), filter_min(GL_LINEAR), filter_max(GL_LINEAR)
+{
+}
+
+void TextureArray::Generate(unsigned int width, unsigned int height, unsigned int capacity)
+{
+    this->width = width;
+    this->height = height;
+    this->layers = 0;
+    this->capacity = capacity;
+
+    glGenTextures(1, &this->ID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, width, height, capacity);
+    // set Texture wrap and filter modes
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, this->wrap_S);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, this->wrap_T);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, this->filter_min);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, this->filter_max);
+    // unbind texture
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+unsigned int TextureArray::AddLayer(const unsigned char *data)
+{
+    if (this->layers == this->capacity)
+        grow(this->capacity * 2);
+
+    unsigned int layer = this->layers++;
+    SetLayer(layer, data);
+    return layer;
+}
+
+void TextureArray::SetLayer(unsigned int layer, const unsigned char *data)
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, this->width, this->height, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::Bind() const
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, this->ID);
+}
+
+size_t TextureArray::ByteSize() const
+{
+    return (size_t)this->width * this->height * 4 * this->capacity;
+}
+
+void TextureArray::Destroy()
+{
+    glDeleteTextures(1, &this->ID);
+    this->ID = 0;
+    this->layers = this->capacity = 0;
+}
+
+void TextureArray::grow(unsigned int newCapacity)
+{
+    // immutable storage can't be resized, so copy the used layers into a bigger array
+    unsigned int oldID = this->ID;
+    unsigned int usedLayers = this->layers;
+    Generate(this->width, this->height, newCapacity);
+    if (usedLayers > 0)
+        glCopyImageSubData(oldID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, this->ID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, this->width, this->height, usedLayers);
+    this->layers = usedLayers;
+    glDeleteTextures(1, &oldID);
+}
@@ -0,0 +1,46 @@
+#ifndef TEXTURE_ARRAY_H
+#define TEXTURE_ARRAY_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+// TextureArray stores same-size RGBA8 images as layers of one
+// GL_TEXTURE_2D_ARRAY, so materials using any of them share a single
+// bind and pick their image by layer index in the shader. Storage is
+// immutable (glTexStorage3D) and doubles when it runs out of layers,
+// copying existing layers on the GPU.
+class TextureArray
+{
+public:
+    // holds the ID of the array texture object
+    unsigned int ID;
+    // size of every layer in pixels
+    unsigned int width, height;
+    // layers in use and layers allocated
+    unsigned int layers, capacity;
+    // texture configuration
+    unsigned int wrap_S; // wrapping mode on S axis
+    unsigned int wrap_T; // wrapping mode on T axis
+    unsigned int filter_min; // filtering mode if texture pixels < screen pixels
+    unsigned int filter_max; // filtering mode if texture pixels > screen pixels
+    // constructor (sets default texture modes, no storage yet)
+    TextureArray();
+    // allocates storage for `capacity` layers of the given size
+    void Generate(unsigned int width, unsigned int height, unsigned int capacity);
+    // appends a layer from RGBA8 pixels and returns its index
+    unsigned int AddLayer(const unsigned char *data);
+    // replaces the pixels of an existing layer
+    void SetLayer(unsigned int layer, const unsigned char *data);
+    // binds the array as the current active GL_TEXTURE_2D_ARRAY texture object
+    void Bind() const;
+    // GPU memory allocated for all layers (used or not)
+    size_t ByteSize() const;
+    // deletes the texture object
+    void Destroy();
+private:
+    // reallocates storage with room for more layers, keeping the existing ones
+    void grow(unsigned int newCapacity);
+};
+
+#endif
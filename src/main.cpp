@@ -1,517 +1,1437 @@
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-
-#include <math.h>
-#include <iostream>
-#include "libs/laky_camera.h"
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "libs/laky_resmanager.h"
-
-#include "libs/stb_image.h"
-
-// SETTINGS
-const unsigned int SCR_WIDTH = 800;
-const unsigned int SCR_HEIGHT = 600;
-
-// CALLBACKS
-void framebuffer_size_callback(GLFWwindow* window, int width, int height);  // Resize callback
-static void error_callback(int error, const char* description); // Error callback
-
-void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods); // Key callback
-char keys[1024]; // Array to store the state of each key
-
-void mouse_callback(GLFWwindow* window, double xposIn, double yposIn); // Mouse callback
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset); // Scroll callback
-
-// FUNCTIONS
-void processInput(GLFWwindow *window);
-void render();
-
-// ERROR CHECKS
-void get_lightingShader_error(unsigned int lightingShader);
-void get_link_error(unsigned int lightingShaderProgram);
-
-// DELTA TIME
-float deltaTime = 0.0f;	// Time between current frame and last frame
-float lastFrame = 0.0f; // Time of last frame
-
-// CAMERA
-Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
-float lastX = SCR_WIDTH / 2.0f;
-float lastY = SCR_HEIGHT / 2.0f;
-bool firstMouse = true;
-float cameraSpeed = 2.5f;
-
-float camWidth = SCR_WIDTH;
-float camHeight = SCR_HEIGHT;
-float camAspect = camWidth / camHeight;
-
-//float x = 0.0f;
-//float y = 0.0f;
-
-// LIGHTING
-glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-
-// MAIN
-int main()
-{
-
-	stbi_set_flip_vertically_on_load(true);
-
-	// Initialize GLFW
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-	// Create window
-	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Laky's First Modern OpenGL", NULL, NULL);
-	if(window == NULL)
-	{
-		std::cout << "Failed to create GLFW window!" << std::endl;
-		glfwTerminate();
-		return -1;
-	}
-
-	// Set callbacks
-	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-	glfwSetErrorCallback(error_callback);
-	glfwSetKeyCallback(window, key_callback);
-	glfwSetCursorPosCallback(window, mouse_callback);
-	glfwSetScrollCallback(window, scroll_callback);
-
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); // Hide cursor
-
-	// Make the window's context current
-	glfwMakeContextCurrent(window);
-
-	// Initialize GLAD
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-	{
-		std::cout << "Failed to initialize GLAD!" << std::endl;
-		return -1;
-	}   
-
-	glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
-
-	glEnable(GL_DEPTH_TEST);
-
-
-	Shader lightingShader = ResourceManager::LoadShader("assets/shaders/material.vert", "assets/shaders/material.frag", "material_shader");
-	Shader lightCubeShader = ResourceManager::LoadShader("assets/shaders/lighting.vert", "assets/shaders/lighting.frag", "light_cube");
-
-	float vertices[] = {
-		// positions          // normals           // texture coords
-		-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-		0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-		0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-
-		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
-		0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
-		0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
-		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
-
-		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-		0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-		0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-		0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-		0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-	};
-	//--------------------------------------------------------------------------------------------
-
-
-	// Cube Positions ;)
-	glm::vec3 cubePositions[] = {
-		glm::vec3( 0.0f,  0.0f,  0.0f), 
-		glm::vec3( 2.0f,  5.0f, -15.0f), 
-		glm::vec3(-1.5f, -2.2f, -2.5f),  
-		glm::vec3(-3.8f, -2.0f, -12.3f),  
-		glm::vec3( 2.4f, -0.4f, -3.5f),  
-		glm::vec3(-1.7f,  3.0f, -7.5f),  
-		glm::vec3( 1.3f, -2.0f, -2.5f),  
-		glm::vec3( 1.5f,  2.0f, -2.5f), 
-		glm::vec3( 1.5f,  0.2f, -1.5f), 
-		glm::vec3(-1.3f,  1.0f, -1.5f)  
-	};
-
-	//Buffers
-
-	// cubes VBO & VAO
-	unsigned int VBO, cubeVAO;
-	glGenVertexArrays(1, &cubeVAO);
-	glGenBuffers(1, &VBO);
-
-	glBindVertexArray(cubeVAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // light VAO (VAO is same as the cube)
-    unsigned int lightCubeVAO;
-    glGenVertexArrays(1, &lightCubeVAO);
-    glBindVertexArray(lightCubeVAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    // note that we update the lamp's position attribute's stride to reflect the updated buffer data
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-	lightingShader.use();
-	
-	// Textures
-
-    Texture2D diffuse_map, specular_map;
-
-	diffuse_map = ResourceManager::LoadTexture("assets/textures/woodcontainer_albedo.png", true, "container");
-	specular_map = ResourceManager::LoadTexture("assets/textures/woodcontainer_specular.png", true, "container_specular");
-
-	//--------------------------------------------------------------------------------------------
-
-	// Projections, Views, Models
-
-	float near = 0.1f;
-	float far = 100.0f;
-	float fov = 45.0f;
-
-	// Perspective projection (ooh 3D!)
-	glm::mat4 projection;
-	projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH/(float)SCR_HEIGHT, near, far);
-
-	// Camera
-	glm::mat4 view;
-	view = camera.GetViewMatrix();
-
-	lightingShader.setInt("texture1", 0);
-	lightingShader.setInt("texture2", 1);
-
-	lightingShader.setMat4("projection", projection);
-	lightingShader.setMat4("view", view);
-
-
-	lightCubeShader.setMat4("projection", projection);
-	lightCubeShader.setMat4("view", view);
-
-	// Game loop
-	while(!glfwWindowShouldClose(window))
-	{
-		processInput(window); // Process keyboard events
-
-		float currentFrame = glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;  
-
-		cameraSpeed = 5.0f * deltaTime;
-
-		// Clear the screen
-		glClearColor(0.2f, 0.2f, 0.3f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		lightingShader.setInt("material.diffuse", 0);
-
-		glActiveTexture(GL_TEXTURE0);
-		diffuse_map.Bind();
-
-		lightingShader.setInt("material.specular", 1);
-
-		glActiveTexture(GL_TEXTURE1);
-		specular_map.Bind();
-
-		// change the light's position values over time (can be done anywhere in the render loop actually, but try to do it at least before using the light source positions)
-        lightPos.x = 1.0f + sin(glfwGetTime()) * 2.0f;
-        lightPos.y = sin(glfwGetTime() / 2.0f) * 1.0f;
-		lightPos.z = 1.0f + cos(glfwGetTime()) * 2.0f;
-
-		// Use the lightingShader program
-        lightingShader.use();
-        lightingShader.setVec3f("light.position", lightPos);
-        lightingShader.setVec3f("viewPos", camera.Position);
-
-		// Set material
-		lightingShader.setVec3f("material.ambient", 1.0f, 0.5f, 0.31f);
-		lightingShader.setVec3f("material.diffuse", 1.0f, 0.5f, 0.31f);
-		lightingShader.setVec3f("material.specular", 0.5f, 0.5f, 0.5f);
-		lightingShader.setFloat("material.shininess", 32.0f);
-
-		// Set light properties
-
-		glm::vec3 lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
-		/*lightColor.x = sin(glfwGetTime() * 2.0f);
-		lightColor.y = sin(glfwGetTime() * 0.7f);
-		lightColor.z = sin(glfwGetTime() * 1.3f);*/
-
-		glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
-		glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
-
-		lightingShader.setVec3f("light.ambient", ambientColor);
-		lightingShader.setVec3f("light.diffuse", diffuseColor);
-		lightingShader.setVec3f("light.specular", 1.0f, 1.0f, 1.0f);
-
-
-		// create transformations
-		glm::mat4 model         = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-		glm::mat4 view          = glm::mat4(1.0f);
-		glm::mat4 projection    = glm::mat4(1.0f);
-		
-
-
-		projection = glm::perspective(glm::radians(camera.Zoom), camAspect, near, far);
-
-		view = camera.GetViewMatrix();
-
-		lightingShader.setMat4("projection", projection);
-		lightingShader.setMat4("model", model);
-		lightingShader.setMat4("view", view);
-
-        // render boxes
-        glBindVertexArray(cubeVAO);
-        /*for (unsigned int i = 0; i < 10; i++)
-        {
-            // calculate the model matrix for each object and pass it to lightingShader before drawing
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, cubePositions[i]);
-            float angle = 20.0f * i;
-            model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-			model = glm::rotate(model, (float)glfwGetTime(), glm::vec3(0.5f, 1.0f, 0.0f));
-
-			lightingShader.setMat4("projection", projection);
-			lightingShader.setMat4("model", model);
-			lightingShader.setMat4("view", view);
-
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-        }*/
-
-		model = glm::rotate(model, (float)glfwGetTime(), glm::vec3(0.5f, 1.0f, 0.0f));
-
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-
-
-        // also draw the lamp object
-        lightCubeShader.use();
-
-        model = glm::mat4(1.0f);
-        model = glm::translate(model, lightPos);
-        model = glm::scale(model, glm::vec3(0.2f)); // a smaller cube
-
-        lightCubeShader.setMat4("projection", projection);
-        lightCubeShader.setMat4("view", view);
-        lightCubeShader.setMat4("model", model);
-
-		lightCubeShader.setVec3f("lightColor", lightColor);
-		
-
-        glBindVertexArray(lightCubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-
-
-
-		glfwSwapBuffers(window);
-		glfwPollEvents();    
-	}
-
-	glfwTerminate();
-	return 0;
-}
-
-// FUNCTIONS
-
-void render()
-{
-
-
-}
-
-void processInput(GLFWwindow *window)
-{
-	if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, true);
-
-	if(keys[GLFW_KEY_W])
-	{
-		std::cout << "W key pressed" << std::endl;
-	}
-
-	// Toggle wireframe mode
-	if(keys[GLFW_KEY_SPACE])
-	{
-		GLint polygonMode;
-		glGetIntegerv(GL_POLYGON_MODE, &polygonMode);
-
-		if(polygonMode == GL_FILL)
-		{
-			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-			// cooldown for 0.2 seconds
-			glfwSetTime(0.0);
-			while(glfwGetTime() < 0.1)
-			{
-				// do nothing
-			}
-		}
-		else
-		{
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-			// cooldown for 0.2 seconds
-			glfwSetTime(0.0);
-			while(glfwGetTime() < 0.1)
-			{
-				// do nothing
-			}
-		}
-	}
-
-	if(keys[GLFW_KEY_W])
-	{
-		camera.ProcessKeyboard(FORWARD, cameraSpeed);
-	}
-	if(keys[GLFW_KEY_S])
-	{
-		camera.ProcessKeyboard(BACKWARD, cameraSpeed);
-	}
-
-	if(keys[GLFW_KEY_A])
-	{
-		camera.ProcessKeyboard(LEFT, cameraSpeed);
-	}
-	if(keys[GLFW_KEY_D])
-	{
-		camera.ProcessKeyboard(RIGHT, cameraSpeed);
-	}
-
-	if(keys[GLFW_KEY_Q])
-	{
-		camera.ProcessKeyboard(DOWN, cameraSpeed);
-	}
-
-	if(keys[GLFW_KEY_E])
-	{
-		camera.ProcessKeyboard(UP, cameraSpeed);
-	}
-}
-
-
-
-// CALLBACKS
-
-// Resize callback
-void framebuffer_size_callback(GLFWwindow* window, int width, int height)
-{
-	camWidth = width;
-	camHeight = height;
-	camAspect = camWidth / camHeight;
-
-	glViewport(0, 0, width, height);
-} 
-
-// Error callback
-static void error_callback(int error, const char* description)
-{
-	fprintf(stderr, "Error: %s\n", description);
-}
- 
-// Key callback
-void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
-{
-
-	if (action == GLFW_PRESS)
-	{
-		keys[key] = 1;
-	}
-	else if (action == GLFW_RELEASE)
-	{
-		keys[key] = 0;
-	}
-}
-
-// Mouse callback
-void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
-{
-    float xpos = static_cast<float>(xposIn);
-    float ypos = static_cast<float>(yposIn);
-
-    if (firstMouse)
-    {
-        lastX = xpos;
-        lastY = ypos;
-        firstMouse = false;
-    }
-
-    float xoffset = xpos - lastX;
-    float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
-
-    lastX = xpos;
-    lastY = ypos;
-
-    camera.ProcessMouseMovement(xoffset, yoffset);
-}
-
-// Scroll callback
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
-{
-    camera.ProcessMouseScroll(static_cast<float>(yoffset));
-}
-
-// ERROR CHECKS
-void get_lightingShader_error(unsigned int lightingShader)
-{
-	int success;
-	char infoLog[512];
-	glGetShaderiv(lightingShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(lightingShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
-	}
-}
-
-void get_link_error(unsigned int lightingShaderProgram)
-{
-	int success;
-	char infoLog[512];
-	glGetProgramiv(lightingShaderProgram, GL_LINK_STATUS, &success);
-	if (!success)
-	{
-		glGetProgramInfoLog(lightingShaderProgram, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINK_FAILED\n" << infoLog << std::endl;
-	}
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include "libs/laky_camera.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "libs/laky_glext.h"
+#include "libs/laky_resmanager.h"
+#include "libs/laky_shader/laky_variants.h"
+#include "libs/laky_material/laky_lightblock.h"
+#include "libs/laky_material/laky_materialtable.h"
+#include "libs/laky_mesh/laky_mesharena.h"
+#include "libs/laky_mesh/laky_meshloader.h"
+#include "libs/laky_mesh/laky_cookedmesh.h"
+#include "libs/laky_renderer/laky_streambuffer.h"
+#include "libs/laky_renderer/laky_batchrenderer.h"
+#include "libs/laky_renderer/laky_gpuculler.h"
+#include "libs/laky_renderer/laky_clusteredlights.h"
+#include "libs/laky_renderer/laky_gbuffer.h"
+#include "libs/laky_renderer/laky_shadowmaps.h"
+#include "libs/laky_frustum.h"
+#include "libs/laky_bvh/laky_bvh.h"
+#include "libs/laky_octree/laky_octree.h"
+#include "libs/laky_occlusion/laky_occlusion.h"
+#include "libs/laky_jobs/laky_jobs.h"
+#include "libs/laky_memory/laky_framearena.h"
+#include "libs/laky_memory/laky_heapstats.h"
+#include "libs/laky_lod/laky_lod.h"
+#include "libs/laky_hotreload/laky_hotreload.h"
+#include "libs/laky_profiler/laky_profiler.h"
+
+#include "libs/stb_image.h"
+
+// SETTINGS
+const unsigned int SCR_WIDTH = 800;
+const unsigned int SCR_HEIGHT = 600;
+const size_t TEXTURE_BUDGET = 256 * 1024 * 1024; // bytes of texture memory before unreferenced textures get evicted
+const unsigned int TIMING_FRAMES = 300; // frames averaged per timing report
+const float LIGHT_RADIUS = 4.0f; // objects within this distance of the light count as lit by it
+const unsigned int POINT_LIGHT_COUNTS[] = { 0, 256, 1024, 4096 }; // clustered point light counts to cycle through (press L)
+const unsigned int OVERDRAW_LAYERS[] = { 0, 4, 16 }; // full-screen walls drawn back to front over the scene (press O)
+const unsigned int BENCHMARK_FRAMES = 120; // GPU frames timed per configuration of the forward/deferred benchmark
+const unsigned int SHADOW_CASCADES = 4; // cascades of the sun's shadow map
+const unsigned int CASCADE_RESOLUTION = 2048; // texels along each side of a cascade
+const unsigned int CUBE_SHADOW_RESOLUTION = 512; // texels along each side of a face of the lamp's shadow cube map
+const float SHADOW_DISTANCE = 40.0f; // the sun's shadows end this far from the camera
+const float LAMP_SHADOW_RANGE = 25.0f; // the lamp's shadows end this far from it
+const unsigned int SHAPE_COUNT = 4; // cube, pyramid, rock, torus
+const unsigned int LOD_LEVELS = 4; // levels of detail generated per shape, full detail included
+const float LOD_RATIO = 0.25f; // triangles each level keeps of the one before
+const float LOD_PIXEL_ERROR = 1.0f; // a level is good enough while its error covers at most this many pixels
+const float LOD_HYSTERESIS = 0.3f; // a coarser level must get this much below the pixel error before it is taken
+const unsigned int LOD_FADE_FRAMES = 16; // frames a level switch cross-fades over
+const char *COLUMN_MODEL = "assets/models/column.lkm"; // loaded from disk, stands around the ground (cooked from column.obj by laky_cook)
+const size_t FRAME_ARENA_BYTES = 1024 * 1024; // per-thread memory for each frame's draw lists and scratch arrays, grows if a frame needs more
+const size_t STREAM_FRAME_BYTES = 8 * 1024 * 1024; // per-frame instances, draw commands and light lists streamed to the GPU (times three frames in flight)
+
+// CALLBACKS
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);  // Resize callback
+static void error_callback(int error, const char* description); // Error callback
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods); // Key callback
+char keys[1024]; // Array to store the state of each key
+
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn); // Mouse callback
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset); // Scroll callback
+
+// FUNCTIONS
+void processInput(GLFWwindow *window);
+void render();
+void buildPyramid(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+void buildSurface(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices, unsigned int columns, unsigned int rows, bool closedRows, glm::vec3 (*surface)(float u, float v));
+glm::vec3 rockSurface(float u, float v);
+glm::vec3 torusSurface(float u, float v);
+unsigned int loadModel(MeshArena &arena, const char *path, std::vector<unsigned int> &meshlets);
+void drawOpaque(GpuCuller &culler, BatchRenderer &scene, BatchRenderer *walls, Shader &sceneShader, Shader &wallShader, const glm::mat4 &projection, const glm::mat4 &view);
+
+// ERROR CHECKS
+void get_lightingShader_error(unsigned int lightingShader);
+void get_link_error(unsigned int lightingShaderProgram);
+
+// DELTA TIME
+float deltaTime = 0.0f;	// Time between current frame and last frame
+float lastFrame = 0.0f; // Time of last frame
+
+// CAMERA
+Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+float lastX = SCR_WIDTH / 2.0f;
+float lastY = SCR_HEIGHT / 2.0f;
+bool firstMouse = true;
+float cameraSpeed = 2.5f;
+
+float camWidth = SCR_WIDTH;
+float camHeight = SCR_HEIGHT;
+float camAspect = camWidth / camHeight;
+
+//float x = 0.0f;
+//float y = 0.0f;
+
+// LIGHTING
+glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+glm::vec3 sunDirection(-0.4f, -1.0f, -0.3f); // direction the sunlight travels in
+unsigned int pointLightSetting = 0; // index into POINT_LIGHT_COUNTS (cycle with L)
+bool cacheShadows = true; // only redraw shadow views whose light or casters changed (toggle with C)
+bool animateScene = true; // spin the crates and move the lamp (toggle with T)
+
+// LEVEL OF DETAIL
+bool useLod = true; // draw the round shapes coarser the smaller they get on screen (toggle with N)
+bool fadeLods = true; // cross-fade level switches instead of popping (toggle with F)
+bool useMeshlets = true; // submit loaded models meshlet by meshlet, so off-screen and back-facing clusters are culled (toggle with M)
+
+// TEXTURING
+bool useBindless = false; // sample material maps through bindless handles instead of the texture array (toggle with B)
+
+// SHADING
+bool useDeferred = false; // shade every pixel once from a G-buffer instead of every fragment (toggle with G)
+unsigned int overdrawSetting = 0; // index into OVERDRAW_LAYERS (cycle with O)
+int benchmarkStep = -1; // configuration the forward/deferred benchmark is timing (start with K), -1 = not running
+bool useDepthPrepass = false; // lay down depth first so the color pass only shades visible fragments (toggle with Z)
+bool showOverdraw = false; // draw every fragment as an additive constant instead of shading it (toggle with H)
+
+// CULLING
+bool verifyCulling = true; // compare the next GPU culling result with the CPU reference (press V)
+bool pickRequested = false; // report the object under the crosshair on the next frame (press P)
+
+// MAIN
+int main()
+{
+
+	stbi_set_flip_vertically_on_load(true);
+
+	// Initialize GLFW
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+	// Create window
+	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Laky's First Modern OpenGL", NULL, NULL);
+	if(window == NULL)
+	{
+		// Mesa's llvmpipe stops at 4.5, which still has everything we need (4.3 compute shaders)
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+		window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Laky's First Modern OpenGL", NULL, NULL);
+	}
+	if(window == NULL)
+	{
+		std::cout << "Failed to create GLFW window!" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+
+	// Set callbacks
+	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+	glfwSetErrorCallback(error_callback);
+	glfwSetKeyCallback(window, key_callback);
+	glfwSetCursorPosCallback(window, mouse_callback);
+	glfwSetScrollCallback(window, scroll_callback);
+
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); // Hide cursor
+
+	// Make the window's context current
+	glfwMakeContextCurrent(window);
+
+	// Initialize GLAD
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cout << "Failed to initialize GLAD!" << std::endl;
+		return -1;
+	}   
+
+	// Worker threads for the CPU-side systems (software occlusion rasterizer, ...)
+	JobSystem::Start();
+	// and one linear arena per thread for everything that only lives for a frame
+	FrameArena::Start(FRAME_ARENA_BYTES);
+
+	// Optional extensions glad doesn't know about
+	GLExtensions::Load((GLADloadproc)glfwGetProcAddress);
+	if (GLExtensions::ParallelShaderCompile)
+		GLExtensions::MaxShaderCompilerThreads(0xFFFFFFFF); // let the driver pick how many threads to use
+
+	glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+
+	glEnable(GL_DEPTH_TEST);
+
+
+	// Material shader permutations: specular map on/off, number of lights, instancing on/off, bindless maps
+	ShaderVariants materialVariants("assets/shaders/material.vert", "assets/shaders/material.frag", "material_shader", {
+		{ "", "SPECULAR_MAP" },
+		{ "NUM_LIGHTS 1", "NUM_LIGHTS 2", "NUM_LIGHTS 4" },
+		{ "", "INSTANCING" },
+		{ "", "BINDLESS" },
+		{ "", "GPU_CULLING" },
+		{ "", "CLUSTERED_LIGHTS" },
+		{ "", "SHADOWS" },
+		{ "", "LOD_FADE" }
+	});
+	// Deferred path: the geometry pass writes the G-buffer with the same inputs, a full-screen pass does the lighting
+	ShaderVariants geometryVariants("assets/shaders/material.vert", "assets/shaders/gbuffer.frag", "gbuffer_shader", {
+		{ "", "SPECULAR_MAP" },
+		{ "", "INSTANCING" },
+		{ "", "BINDLESS" },
+		{ "", "GPU_CULLING" },
+		{ "", "LOD_FADE" }
+	});
+	ShaderVariants deferredVariants("assets/shaders/deferred.vert", "assets/shaders/deferred.frag", "deferred_shader", {
+		{ "NUM_LIGHTS 1", "NUM_LIGHTS 2", "NUM_LIGHTS 4" },
+		{ "", "CLUSTERED_LIGHTS" },
+		{ "", "SHADOWS" }
+	});
+	// keys by texturing path (1 = bindless), clustered lights and GPU culling (the scene is culled, the overdraw walls are not;
+	// 2 = culled with LOD cross-fades, only used on frames where something fades since the dither's discard gets in the way of
+	// early depth testing), all with the lamp and the sun (NUM_LIGHTS 2) and their shadows.
+	// Only submit the programs here, the driver compiles them while we set up buffers and decode textures
+	unsigned int forwardKeys[2][2][3], geometryKeys[2][3], deferredKeys[2];
+	unsigned int texturePaths = GLExtensions::BindlessTexture ? 2 : 1; // the texture array path stays around as the fallback and for comparison
+	for (unsigned int bindless = 0; bindless < texturePaths; bindless++)
+	{
+		for (unsigned int culling = 0; culling < 3; culling++)
+		{
+			unsigned int culled = culling > 0 ? 1 : 0, fading = culling == 2 ? 1 : 0;
+			for (unsigned int clustered = 0; clustered < 2; clustered++)
+			{
+				forwardKeys[bindless][clustered][culling] = materialVariants.Key(std::vector<unsigned int>{ 1, 1, 1, bindless, culled, clustered, 1, fading });
+				materialVariants.Submit(forwardKeys[bindless][clustered][culling]);
+			}
+			geometryKeys[bindless][culling] = geometryVariants.Key(std::vector<unsigned int>{ 1, 1, bindless, culled, fading });
+			geometryVariants.Submit(geometryKeys[bindless][culling]);
+		}
+	}
+	for (unsigned int clustered = 0; clustered < 2; clustered++)
+	{
+		deferredKeys[clustered] = deferredVariants.Key(std::vector<unsigned int>{ 1, clustered, 1 });
+		deferredVariants.Submit(deferredKeys[clustered]);
+	}
+	// Depth prepass and overdraw view: position only, depth_only.frag writes nothing and overdraw.frag a constant
+	ShaderVariants depthVariants("assets/shaders/material.vert", "assets/shaders/depth_only.frag", "depth_shader", {
+		{ "", "INSTANCING" },
+		{ "", "GPU_CULLING" },
+		{ "DEPTH_ONLY" },
+		{ "", "LOD_FADE" }
+	});
+	ShaderVariants overdrawVariants("assets/shaders/material.vert", "assets/shaders/overdraw.frag", "overdraw_shader", {
+		{ "", "INSTANCING" },
+		{ "", "GPU_CULLING" },
+		{ "DEPTH_ONLY" },
+		{ "", "LOD_FADE" }
+	});
+	unsigned int depthKeys[3], overdrawKeys[3];
+	for (unsigned int culling = 0; culling < 3; culling++)
+	{
+		unsigned int culled = culling > 0 ? 1 : 0, fading = culling == 2 ? 1 : 0;
+		depthKeys[culling] = depthVariants.Key(std::vector<unsigned int>{ 1, culled, 0, fading });
+		overdrawKeys[culling] = overdrawVariants.Key(std::vector<unsigned int>{ 1, culled, 0, fading });
+		depthVariants.Submit(depthKeys[culling]);
+		overdrawVariants.Submit(overdrawKeys[culling]);
+	}
+	ShaderHandle lightCubeShaderHandle = ResourceManager::LoadShaderAsync("assets/shaders/lighting.vert", "assets/shaders/lighting.frag", "light_cube");
+
+	float vertices[] = {
+		// positions          // normals           // texture coords
+		-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+		0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+		0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
+		0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
+		0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f,
+
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+		0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+		0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+		0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+		0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
+	};
+	//--------------------------------------------------------------------------------------------
+
+
+	// Cube Positions ;)
+	glm::vec3 cubePositions[] = {
+		glm::vec3( 0.0f,  0.0f,  0.0f), 
+		glm::vec3( 2.0f,  5.0f, -15.0f), 
+		glm::vec3(-1.5f, -2.2f, -2.5f),  
+		glm::vec3(-3.8f, -2.0f, -12.3f),  
+		glm::vec3( 2.4f, -0.4f, -3.5f),  
+		glm::vec3(-1.7f,  3.0f, -7.5f),  
+		glm::vec3( 1.3f, -2.0f, -2.5f),  
+		glm::vec3( 1.5f,  2.0f, -2.5f), 
+		glm::vec3( 1.5f,  0.2f, -1.5f), 
+		glm::vec3(-1.3f,  1.0f, -1.5f)  
+	};
+
+	//Buffers
+
+	// cube VBO, only the lamp still draws from it directly
+	unsigned int VBO;
+	glGenBuffers(1, &VBO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	// All scene meshes share one vertex/index arena, so every object (whatever its mesh) goes out in a single multi-draw
+	const unsigned int cubeCount = sizeof(cubePositions) / sizeof(cubePositions[0]);
+	MeshArena meshArena;
+
+	std::vector<Vertex> meshVertices(36);
+	std::vector<unsigned int> meshIndices(36);
+	for (unsigned int i = 0; i < 36; i++)
+	{
+		meshVertices[i].position = glm::vec3(vertices[i * 8], vertices[i * 8 + 1], vertices[i * 8 + 2]);
+		meshVertices[i].normal = glm::vec3(vertices[i * 8 + 3], vertices[i * 8 + 4], vertices[i * 8 + 5]);
+		meshVertices[i].texCoords = glm::vec2(vertices[i * 8 + 6], vertices[i * 8 + 7]);
+		meshIndices[i] = i;
+	}
+
+	// Shapes: the cube and the pyramid are as coarse as they get, the rock and the torus are dense enough to need levels of
+	// detail. Every shape's LOD chain is simplified at load, one shape per job
+	std::vector<Vertex> shapeVertices[SHAPE_COUNT];
+	std::vector<unsigned int> shapeIndices[SHAPE_COUNT];
+	shapeVertices[0] = meshVertices;
+	shapeIndices[0] = meshIndices;
+	buildPyramid(shapeVertices[1], shapeIndices[1]);
+	buildSurface(shapeVertices[2], shapeIndices[2], 128, 64, false, rockSurface);
+	buildSurface(shapeVertices[3], shapeIndices[3], 128, 48, true, torusSurface);
+	const char *shapeNames[SHAPE_COUNT] = { "cube", "pyramid", "rock", "torus" };
+
+	// every object doubles as an occluder, the software rasterizer needs CPU copies of the positions
+	std::vector<glm::vec3> occluderPositions[SHAPE_COUNT];
+	std::vector<unsigned int> occluderIndices[SHAPE_COUNT];
+	LodSource lodSources[SHAPE_COUNT];
+	for (unsigned int shape = 0; shape < SHAPE_COUNT; shape++)
+	{
+		for (const Vertex &vertex : shapeVertices[shape])
+			occluderPositions[shape].push_back(vertex.position);
+		lodSources[shape].positions = &occluderPositions[shape];
+		lodSources[shape].indices = &shapeIndices[shape];
+	}
+	std::vector<MeshLod> lodChains[SHAPE_COUNT];
+	double lodStart = glfwGetTime();
+	GenerateLods(lodSources, SHAPE_COUNT, LOD_LEVELS, LOD_RATIO, lodChains);
+	double lodMs = (glfwGetTime() - lodStart) * 1000.0;
+
+	// the coarser levels only add index lists over the full level's vertices; the coarsest one is good enough to occlude with
+	std::vector<unsigned int> shapeLods[SHAPE_COUNT]; // arena mesh per level, full detail first
+	std::vector<float> shapeLodErrors[SHAPE_COUNT];
+	for (unsigned int shape = 0; shape < SHAPE_COUNT; shape++)
+	{
+		shapeLods[shape].push_back(meshArena.Add(shapeVertices[shape], shapeIndices[shape]));
+		shapeLodErrors[shape].push_back(0.0f);
+		for (unsigned int level = 1; level < lodChains[shape].size(); level++)
+		{
+			shapeLods[shape].push_back(meshArena.AddLod(shapeLods[shape][0], lodChains[shape][level].indices));
+			shapeLodErrors[shape].push_back(lodChains[shape][level].error);
+		}
+		occluderIndices[shape] = lodChains[shape].back().indices;
+		std::cout << "LOD " << shapeNames[shape] << ":";
+		for (const MeshLod &lod : lodChains[shape])
+			std::cout << " " << lod.indices.size() / 3 << " triangles (error " << lod.error << ")";
+		std::cout << std::endl;
+	}
+	std::cout << "LOD chains generated in " << lodMs << " ms" << std::endl;
+	unsigned int cubeMesh = shapeLods[0][0];
+	// a few columns from a model file line the ground, ~0u if it can't be loaded
+	std::vector<unsigned int> columnMeshlets;
+	unsigned int columnMesh = loadModel(meshArena, COLUMN_MODEL, columnMeshlets);
+	const unsigned int columnCount = 6;
+	glm::mat4 columnModels[columnCount];
+	for (unsigned int i = 0; i < columnCount; i++)
+		columnModels[i] = glm::translate(glm::mat4(1.0f), glm::vec3(i % 2 ? 6.0f : -6.0f, -3.9f, -1.0f - 6.0f * (i / 2)));
+
+	// everything rebuilt every frame is written into a persistently mapped buffer, three frames deep
+	StreamBuffer frameStream(STREAM_FRAME_BYTES);
+	BatchRenderer sceneBatch(meshArena, &frameStream);
+	InstanceData instance = {};
+	// frustum culling runs in a compute shader and writes the batch's draw commands itself
+	GpuCuller sceneCuller;
+	// occlusion culling runs on the CPU before submission, against a small software depth buffer
+	OcclusionCuller occlusionCuller(256, 128);
+	unsigned int occludedCount = 0;
+	glm::mat4 cubeModels[cubeCount];
+	// every third object is a pyramid, the ones in between alternate between tori and rocks
+	unsigned int objectShapes[cubeCount];
+	for (unsigned int i = 0; i < cubeCount; i++)
+		objectShapes[i] = i % 3 == 2 ? 1 : i % 3 == 1 ? 2 + i % 2 : 0;
+
+	// levels of detail are picked per object every frame; the shadow casters follow the level on screen
+	LodSelector lodSelector(LOD_PIXEL_ERROR, LOD_HYSTERESIS, LOD_FADE_FRAMES);
+	LodChoice lodChoices[cubeCount];
+	unsigned int casterLods[cubeCount] = {};
+	unsigned int lodTriangles = 0, fullTriangles = 0, fadingObjects = 0;
+	unsigned int meshletTriangles = 0, modelTriangles = 0; // of the columns: in meshlets that survive culling (CPU estimate), in total
+
+	// scene queries (frustum, picking, light range) go through a BVH over the objects' world bounds
+	Bvh sceneBvh;
+	glm::vec3 objectMin[cubeCount], objectMax[cubeCount];
+	for (unsigned int i = 0; i < cubeCount; i++)
+	{
+		cubeModels[i] = glm::mat4(1.0f);
+		objectMin[i] = objectMax[i] = cubePositions[i];
+	}
+	std::vector<uint32_t> visibleObjects, litObjects;
+
+	// things that travel (so far only the lamp) live in a loose octree instead, where small moves cost next to nothing
+	LooseOctree dynamicObjects(glm::vec3(0.0f), 64.0f, 6);
+	const float lampRadius = 0.1f * 1.7321f; // bounding sphere of the 0.2 sized lamp cube
+	OctreeHandle lampHandle = dynamicObjects.Insert(lightPos, lampRadius, 0);
+	std::vector<uint32_t> visibleDynamic;
+
+    // light VAO (VAO is same as the cube)
+    unsigned int lightCubeVAO;
+    glGenVertexArrays(1, &lightCubeVAO);
+    glBindVertexArray(lightCubeVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    // note that we update the lamp's position attribute's stride to reflect the updated buffer data
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+	// Textures
+
+	ResourceManager::SetTextureBudget(TEXTURE_BUDGET);
+
+	// Both maps are 500x500, so they land in the same texture array and every cube draws with one bind
+	TextureLayer diffuse_layer = ResourceManager::LoadTextureLayer("assets/textures/woodcontainer_albedo.png", "container");
+	TextureLayer specular_layer = ResourceManager::LoadTextureLayer("assets/textures/woodcontainer_specular.png", "container_specular");
+
+	// With bindless textures the same maps are also loaded as plain textures whose handles go straight into the material table
+	TextureRef diffuse_map, specular_map;
+	GLuint64 diffuse_handle = 0, specular_handle = 0;
+	if (GLExtensions::BindlessTexture)
+	{
+		diffuse_map = TextureRef(ResourceManager::LoadTexture("assets/textures/woodcontainer_albedo.png", true, "container"));
+		specular_map = TextureRef(ResourceManager::LoadTexture("assets/textures/woodcontainer_specular.png", true, "container_specular"));
+		diffuse_handle = ResourceManager::MakeTextureResident(diffuse_map.get());
+		specular_handle = ResourceManager::MakeTextureResident(specular_map.get());
+		useBindless = diffuse_handle != 0 && specular_handle != 0;
+	}
+
+	ResourceStats stats = ResourceManager::GetStats();
+	std::cout << "Textures: " << stats.textureCount << " (" << stats.textureBytes / 1024 << " KiB of " << stats.textureBudget / 1024 << " KiB budget), "
+		<< stats.arrayCount << " texture arrays (" << stats.arrayBytes / 1024 << " KiB), "
+		<< stats.residentCount << " resident (" << stats.residentBytes / 1024 << " KiB)" << std::endl;
+
+	// Light parameters live in a uniform buffer that is only re-uploaded when something changes
+	UniformBuffer<LightBlock> lightBlock;
+
+	// Swarms of small point lights drift around the crates, binned into view clusters every frame
+	const unsigned int maxPointLights = POINT_LIGHT_COUNTS[sizeof(POINT_LIGHT_COUNTS) / sizeof(POINT_LIGHT_COUNTS[0]) - 1];
+	std::vector<PointLight> pointLights(maxPointLights);
+	std::vector<glm::vec4> pointLightOrbits(maxPointLights); // orbit center, w = phase
+	for (unsigned int i = 0; i < maxPointLights; i++)
+	{
+		// low discrepancy sequences spread the lights evenly through the scene's box
+		glm::vec3 spread = glm::fract(glm::vec3(i * 0.6180340f, i * 0.7548777f, i * 0.5698403f));
+		pointLightOrbits[i] = glm::vec4(glm::vec3(-6.0f, -4.0f, -17.0f) + spread * glm::vec3(10.0f, 10.0f, 19.0f), i * 2.3999632f);
+		float hue = glm::fract(i * 0.381966f) * 6.2831f;
+		pointLights[i].color = glm::vec4(0.6f + 0.4f * sin(hue), 0.6f + 0.4f * sin(hue + 2.094f), 0.6f + 0.4f * sin(hue + 4.188f), 0.0f);
+	}
+	ClusteredLights clusteredLights(&frameStream);
+	CpuTimer clusterTimer;
+
+	// G-buffer of the deferred path, follows the window size
+	GBuffer gBuffer(SCR_WIDTH, SCR_HEIGHT);
+	// overdraw walls, drawn in submission order (back to front) without culling
+	BatchRenderer overdrawBatch(meshArena, &frameStream);
+
+	// Shadows of the sun (cascades) and the lamp (cube map). The ground never moves, so it is drawn into the cached
+	// static layers once, the spinning crates go into every view they move through
+	ShadowMaps shadowMaps(SHADOW_CASCADES, CASCADE_RESOLUTION, CUBE_SHADOW_RESOLUTION);
+	// the static casters are built once and drawn for the whole run, so they keep buffers of their own
+	BatchRenderer staticCasters(meshArena), dynamicCasters(meshArena, &frameStream);
+	glm::mat4 groundModel = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -4.0f, -7.0f)), glm::vec3(30.0f, 0.2f, 30.0f));
+	instance.model = groundModel;
+	staticCasters.Submit(cubeMesh, instance);
+	for (unsigned int i = 0; columnMesh != ~0u && i < columnCount; i++)
+	{
+		instance.model = columnModels[i];
+		staticCasters.Submit(columnMesh, instance);
+	}
+	staticCasters.Build();
+	float animationTime = 0.0f; // stands still while animateScene is off, so nothing moves and the shadow cache keeps everything
+	TimingStats shadowPasses, skippedShadowPasses;
+
+	// One material per cube, all drawn with a single instanced call
+	MaterialTable cubeMaterials;
+	for (unsigned int i = 0; i < cubeCount; i++)
+	{
+		MaterialData material;
+		float hue = (float)i / cubeCount;
+		material.diffuse = glm::vec4(0.6f + 0.4f * sin(hue * 6.2831f), 0.6f + 0.4f * sin(hue * 6.2831f + 2.094f), 0.6f + 0.4f * sin(hue * 6.2831f + 4.188f), 1.0f);
+		material.ambient = material.diffuse;
+		material.specular = glm::vec4(1.0f, 1.0f, 1.0f, 8.0f + 16.0f * (i % 4));
+		material.maps = glm::ivec4(diffuse_layer.layer, specular_layer.layer, -1, -1);
+		material.diffuseHandle = diffuse_handle;
+		material.specularHandle = specular_handle;
+		cubeMaterials.Add(material);
+	}
+	// the ground gets a plain grey one without maps after the cubes'
+	MaterialData groundMaterial;
+	groundMaterial.diffuse = groundMaterial.ambient = glm::vec4(0.6f, 0.6f, 0.6f, 1.0f);
+	groundMaterial.specular = glm::vec4(0.2f, 0.2f, 0.2f, 4.0f);
+	groundMaterial.maps = glm::ivec4(-1, -1, -1, -1);
+	groundMaterial.diffuseHandle = groundMaterial.specularHandle = 0;
+	unsigned int groundMaterialIndex = cubeMaterials.Add(groundMaterial);
+
+	// Grab references only once everything is loaded, inserting into the resource storage may move it
+	Shader *forwardShaders[2][2][3], *geometryShaders[2][3], *deferredShaders[2];
+	for (unsigned int bindless = 0; bindless < texturePaths; bindless++)
+	{
+		for (unsigned int culling = 0; culling < 3; culling++)
+		{
+			for (unsigned int clustered = 0; clustered < 2; clustered++)
+				forwardShaders[bindless][clustered][culling] = &materialVariants.Get(forwardKeys[bindless][clustered][culling]);
+			geometryShaders[bindless][culling] = &geometryVariants.Get(geometryKeys[bindless][culling]);
+		}
+	}
+	for (unsigned int clustered = 0; clustered < 2; clustered++)
+		deferredShaders[clustered] = &deferredVariants.Get(deferredKeys[clustered]);
+	Shader *depthShaders[3], *overdrawShaders[3];
+	for (unsigned int culling = 0; culling < 3; culling++)
+	{
+		depthShaders[culling] = &depthVariants.Get(depthKeys[culling]);
+		overdrawShaders[culling] = &overdrawVariants.Get(overdrawKeys[culling]);
+	}
+	Shader &lightCubeShader = ResourceManager::GetShader(lightCubeShaderHandle);
+
+	//--------------------------------------------------------------------------------------------
+
+	// Projections, Views, Models
+
+	float near = 0.1f;
+	float far = 100.0f;
+	float fov = 45.0f;
+
+	// Perspective projection (ooh 3D!)
+	glm::mat4 projection;
+	projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH/(float)SCR_HEIGHT, near, far);
+
+	// Camera
+	glm::mat4 view;
+	view = camera.GetViewMatrix();
+
+	lightCubeShader.setMat4("projection", projection);
+	lightCubeShader.setMat4("view", view);
+
+	// Watch assets/ so edited shaders and textures get swapped in without restarting
+	HotReloader hotReloader;
+	hotReloader.Start("assets");
+
+	// Compare both texturing paths: the cube pass is timed on the GPU and CPU, press B to switch
+	GpuTimer cubePassGpuTimer;
+	CpuTimer cubePassCpuTimer;
+	bool timedBindless = useBindless;
+	bool timedDeferred = useDeferred;
+	bool timedPrepass = useDepthPrepass;
+	bool timedCaching = cacheShadows;
+	// fragments that pass the depth test in the color (or G-buffer) pass, i.e. the ones that get shaded
+	FragmentCounter shadedFragments;
+	if (GLExtensions::BindlessTexture)
+		std::cout << "Bindless textures available, press B to switch between bindless and texture array sampling" << std::endl;
+	std::cout << "Press L to cycle through 0, 256, 1024 and 4096 clustered point lights" << std::endl;
+	std::cout << "Press G to switch between forward and deferred shading, O to add overdraw, K to benchmark both" << std::endl;
+	std::cout << "Press Z to toggle the depth prepass, H to show overdraw" << std::endl;
+	std::cout << "Press C to toggle shadow caching, T to pause the animation" << std::endl;
+	std::cout << "Press N to toggle levels of detail, F to toggle their cross-fades" << std::endl;
+
+	// Forward/deferred benchmark: every light count and overdraw setting is timed with both paths
+	const unsigned int lightSettings = sizeof(POINT_LIGHT_COUNTS) / sizeof(POINT_LIGHT_COUNTS[0]);
+	const unsigned int overdrawSettings = sizeof(OVERDRAW_LAYERS) / sizeof(OVERDRAW_LAYERS[0]);
+	const unsigned int BENCHMARK_WARMUP = 5; // frames whose timings may still belong to the previous configuration
+	unsigned int benchmarkFrame = 0;
+	double forwardMs = 0.0;
+	// heap allocations per frame, the draw lists and culling scratch come from the FrameArena so this should settle at 0
+	TimingStats frameAllocations;
+
+	bool savedDeferred = useDeferred;
+	unsigned int savedLights = pointLightSetting, savedOverdraw = overdrawSetting;
+
+	// Game loop
+	while(!glfwWindowShouldClose(window))
+	{
+		FrameArena::BeginFrame(); // last frame's queues and scratch arrays are gone from here on
+		HeapStats heapAtFrameStart = GetHeapStats();
+		processInput(window); // Process keyboard events
+
+		ResourceManager::BeginFrame();
+		frameStream.BeginFrame(); // waits only if the GPU is still reading this region three frames later
+		hotReloader.Update(); // swap in reloaded resources at the frame boundary
+
+		float currentFrame = glfwGetTime();
+		deltaTime = currentFrame - lastFrame;
+		lastFrame = currentFrame;  
+
+		cameraSpeed = 5.0f * deltaTime;
+		if (animateScene)
+			animationTime += deltaTime;
+
+		// pick up finished GPU timings and report them once enough frames were measured
+		cubePassGpuTimer.Collect();
+		shadedFragments.Collect();
+		if (benchmarkStep >= 0)
+		{
+			if (benchmarkStep == 0 && benchmarkFrame == 0)
+			{
+				savedDeferred = useDeferred;
+				savedLights = pointLightSetting;
+				savedOverdraw = overdrawSetting;
+				std::cout << "Forward vs deferred, GPU ms per frame (average of " << BENCHMARK_FRAMES << " frames):" << std::endl;
+			}
+			// the first frames of a configuration may still report queries of the previous one
+			if (++benchmarkFrame == BENCHMARK_WARMUP)
+				cubePassGpuTimer.Reset();
+			if (benchmarkFrame > BENCHMARK_WARMUP && cubePassGpuTimer.Stats().samples >= BENCHMARK_FRAMES)
+			{
+				// even steps are forward, odd ones deferred with the same lights and overdraw
+				if (benchmarkStep % 2 == 0)
+					forwardMs = cubePassGpuTimer.Stats().Average();
+				else
+					std::cout << "  " << POINT_LIGHT_COUNTS[pointLightSetting] << " point lights, " << OVERDRAW_LAYERS[overdrawSetting] << " overdraw layers: forward "
+						<< forwardMs << " ms, deferred " << cubePassGpuTimer.Stats().Average() << " ms" << std::endl;
+				benchmarkStep++;
+				benchmarkFrame = 0;
+				if (benchmarkStep == (int)(2 * lightSettings * overdrawSettings))
+				{
+					benchmarkStep = -1;
+					useDeferred = savedDeferred;
+					pointLightSetting = savedLights;
+					overdrawSetting = savedOverdraw;
+				}
+			}
+			if (benchmarkStep >= 0)
+			{
+				useDeferred = benchmarkStep % 2 == 1;
+				pointLightSetting = (benchmarkStep / 2) % lightSettings;
+				overdrawSetting = benchmarkStep / 2 / lightSettings;
+			}
+		}
+		if (timedBindless != useBindless || timedDeferred != useDeferred || timedPrepass != useDepthPrepass || timedCaching != cacheShadows)
+		{
+			cubePassGpuTimer.Reset();
+			cubePassCpuTimer.Reset();
+			shadedFragments.Reset();
+			timedBindless = useBindless;
+			timedDeferred = useDeferred;
+			timedPrepass = useDepthPrepass;
+			timedCaching = cacheShadows;
+			shadowPasses.Reset();
+			skippedShadowPasses.Reset();
+		}
+		if (benchmarkStep < 0 && cubePassGpuTimer.Stats().samples >= TIMING_FRAMES)
+		{
+			std::cout << "Cube pass (" << (useDeferred ? "deferred" : "forward") << (useDepthPrepass ? " with depth prepass" : "") << ", " << (useBindless ? "bindless" : "texture array") << ", " << sceneBatch.InstanceCount() << " instances in "
+				<< sceneBatch.DrawCount() << " indirect draws): GPU " << cubePassGpuTimer.Stats().Average()
+				<< " ms, CPU " << cubePassCpuTimer.Stats().Average() << " ms (average of " << TIMING_FRAMES << " frames)" << std::endl;
+			const OcclusionStats &occlusion = occlusionCuller.Stats();
+			// shaded fragments over screen pixels: 1.0 would mean every pixel was shaded exactly once
+			double pixels = (double)camWidth * camHeight;
+			std::cout << "Overdraw: " << (unsigned long long)shadedFragments.Stats().Average() << " fragments shaded per frame, " << shadedFragments.Stats().Average() / pixels
+				<< " per pixel (at most " << shadedFragments.Stats().max / pixels << ")" << std::endl;
+			std::cout << "Occlusion: " << occludedCount << " of " << cubeCount << " objects hidden, " << occlusion.rasterTriangles << " occluder triangles, setup "
+				<< occlusion.transformMs << " ms, raster " << occlusion.rasterMs << " ms, Hi-Z " << occlusion.hizMs << " ms (last frame)" << std::endl;
+			std::cout << "Scene BVH: " << sceneBvh.NodeCount() << " nodes, " << visibleObjects.size() << " objects in view, "
+				<< litObjects.size() << " within " << LIGHT_RADIUS << " of the light" << std::endl;
+			if (POINT_LIGHT_COUNTS[pointLightSetting] > 0)
+			{
+				const LightGridStats &grid = clusteredLights.Grid().Stats();
+				std::cout << "Clustered lights: " << grid.visibleLights << " of " << grid.lights << " in view, " << grid.indexCount << " cluster entries (at most "
+					<< grid.maxClusterLights << " in one cluster), binning " << clusterTimer.Stats().Average() << " ms" << std::endl;
+			}
+			const ShadowCacheStats &shadows = shadowMaps.Cache().Stats();
+			std::cout << "Shadows (" << (cacheShadows ? "cached" : "not cached") << "): " << shadowPasses.Average() << " passes drawn, " << skippedShadowPasses.Average()
+				<< " of " << 2 * shadows.views << " skipped per frame (" << shadows.views << " views, last frame " << shadows.staticPasses << " static and "
+				<< shadows.dynamicPasses << " dynamic passes)" << std::endl;
+			std::cout << "LOD (" << (useLod ? (fadeLods ? "cross-faded" : "popping") : "off") << "): " << lodTriangles << " of " << fullTriangles << " full detail triangles submitted, "
+				<< fadingObjects << " objects cross-fading (last frame)" << std::endl;
+			std::cout << "Meshlets (" << (useMeshlets ? "on" : "off") << "): " << meshletTriangles << " of " << modelTriangles << " model triangles left after culling "
+				<< columnMeshlets.size() << " meshlets per model (last frame)" << std::endl;
+			const StreamStats &streaming = frameStream.Stats();
+			std::cout << "Streaming: " << streaming.usedBytes / 1024 << " of " << frameStream.FrameSize() / 1024 << " KB per frame used (at most " << streaming.peakBytes / 1024
+				<< " KB), " << streaming.waits << " waits for the GPU (" << streaming.waitMs << " ms), " << streaming.overflows << " overflowing uploads in total" << std::endl;
+			const FrameArenaStats &arenaStats = FrameArena::Stats();
+			std::cout << "Memory: " << frameAllocations.Average() << " heap allocations per frame (at most " << frameAllocations.max << "), frame arena " << arenaStats.usedBytes / 1024
+				<< " KB used (peak " << arenaStats.peakBytes / 1024 << " KB over " << JobSystem::ThreadCount() << " threads, " << arenaStats.blockAllocations << " blocks taken from the heap)" << std::endl;
+			frameAllocations.Reset();
+			shadowPasses.Reset();
+			skippedShadowPasses.Reset();
+			clusterTimer.Reset();
+			cubePassGpuTimer.Reset();
+			cubePassCpuTimer.Reset();
+			shadedFragments.Reset();
+		}
+
+		// Clear the screen (black in the overdraw view, so the brightness is just the fragment count)
+		if (showOverdraw)
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		else
+			glClearColor(0.2f, 0.2f, 0.3f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// change the light's position values over time (can be done anywhere in the render loop actually, but try to do it at least before using the light source positions)
+        lightPos.x = 1.0f + sin(animationTime) * 2.0f;
+        lightPos.y = sin(animationTime / 2.0f) * 1.0f;
+		lightPos.z = 1.0f + cos(animationTime) * 2.0f;
+
+		unsigned int pointLightCount = POINT_LIGHT_COUNTS[pointLightSetting];
+		unsigned int texturePath = useBindless ? 1 : 0, clustered = pointLightCount > 0 ? 1 : 0;
+		bool deferredFrame = useDeferred && !showOverdraw;
+		lightBlock.Set(lightBlock.Get().lights[0].position, glm::vec4(lightPos, 1.0f));
+		lightBlock.Set(lightBlock.Get().viewPos, glm::vec4(camera.Position, 1.0f));
+
+		// Set light properties
+
+		glm::vec3 lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
+		/*lightColor.x = sin(glfwGetTime() * 2.0f);
+		lightColor.y = sin(glfwGetTime() * 0.7f);
+		lightColor.z = sin(glfwGetTime() * 1.3f);*/
+
+		glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
+		glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
+
+		// unchanged values don't mark the block dirty, so these only get uploaded once
+		lightBlock.Set(lightBlock.Get().lights[0].ambient, glm::vec4(ambientColor, 1.0f));
+		lightBlock.Set(lightBlock.Get().lights[0].diffuse, glm::vec4(diffuseColor, 1.0f));
+		lightBlock.Set(lightBlock.Get().lights[0].specular, glm::vec4(1.0f));
+		// the sun, a directional light (w = 0) pointing back towards where the light comes from
+		lightBlock.Set(lightBlock.Get().lights[1].position, glm::vec4(-glm::normalize(sunDirection), 0.0f));
+		lightBlock.Set(lightBlock.Get().lights[1].ambient, glm::vec4(0.05f, 0.05f, 0.06f, 1.0f));
+		lightBlock.Set(lightBlock.Get().lights[1].diffuse, glm::vec4(0.45f, 0.43f, 0.4f, 1.0f));
+		lightBlock.Set(lightBlock.Get().lights[1].specular, glm::vec4(0.3f, 0.3f, 0.3f, 1.0f));
+
+		cubePassGpuTimer.Begin();
+		cubePassCpuTimer.Begin();
+
+		lightBlock.Bind(LIGHT_BLOCK_BINDING);
+		cubeMaterials.Bind();
+		if (!useBindless)
+		{
+			// resident handles need no binding, the array path binds the shared texture array instead
+			glActiveTexture(GL_TEXTURE0);
+			ResourceManager::GetTextureArray(diffuse_layer.array).Bind();
+		}
+
+
+		// create transformations
+		glm::mat4 model         = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
+		glm::mat4 view          = glm::mat4(1.0f);
+		glm::mat4 projection    = glm::mat4(1.0f);
+		
+
+
+		projection = glm::perspective(glm::radians(camera.Zoom), camAspect, near, far);
+
+		view = camera.GetViewMatrix();
+
+		// the point lights wander on small orbits, so every frame needs new cluster lists
+		if (pointLightCount > 0)
+		{
+			float time = (float)glfwGetTime();
+			for (unsigned int i = 0; i < pointLightCount; i++)
+			{
+				const glm::vec4 &orbit = pointLightOrbits[i];
+				float angle = time * (0.5f + 0.1f * (i % 8)) + orbit.w;
+				pointLights[i].positionRadius = glm::vec4(glm::vec3(orbit) + glm::vec3(cos(angle), sin(angle * 0.7f) * 0.5f, sin(angle)), 1.5f);
+			}
+			clusterTimer.Begin();
+			clusteredLights.Update(pointLights.data(), pointLightCount, view, glm::radians(camera.Zoom), camAspect, near, far, (unsigned int)camWidth, (unsigned int)camHeight);
+			clusterTimer.End();
+			clusteredLights.Bind();
+		}
+
+        // render boxes (and pyramids, rocks and tori)
+        for (unsigned int i = 0; i < cubeCount; i++)
+        {
+            // calculate the model matrix for each object, each object has its own material
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, cubePositions[i]);
+            float angle = 20.0f * i;
+            model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+			model = glm::rotate(model, animationTime, glm::vec3(0.5f, 1.0f, 0.0f));
+
+			// a caster that moved dirties the shadow views it left and the ones it entered
+			const MeshRange &range = meshArena.Get(shapeLods[objectShapes[i]][0]);
+			glm::vec3 boundsMin, boundsMax;
+			TransformAABB(model, range.boundsMin, range.boundsMax, boundsMin, boundsMax);
+			if (model != cubeModels[i])
+			{
+				shadowMaps.Invalidate(objectMin[i], objectMax[i], false);
+				shadowMaps.Invalidate(boundsMin, boundsMax, false);
+			}
+			cubeModels[i] = model;
+			objectMin[i] = boundsMin;
+			objectMax[i] = boundsMax;
+        }
+
+		// the objects only spin in place, so refitting keeps the tree from the first frame tight
+		if (sceneBvh.NodeCount() == 0)
+			sceneBvh.Build(objectMin, objectMax, cubeCount);
+		else
+			sceneBvh.Refit(objectMin, objectMax);
+		Frustum frustum(projection * view);
+		visibleObjects.clear();
+		sceneBvh.QueryFrustum(frustum, visibleObjects);
+		litObjects.clear();
+		sceneBvh.QuerySphere(lightPos, LIGHT_RADIUS, litObjects);
+		if (pickRequested)
+		{
+			BvhHit hit;
+			if (sceneBvh.Raycast(camera.Position, camera.Front, far, hit))
+				std::cout << "Picked object " << hit.item << " (" << shapeNames[objectShapes[hit.item]] << ", level of detail " << lodChoices[hit.item].level << ") at distance " << hit.distance << std::endl;
+			else
+				std::cout << "Picked nothing" << std::endl;
+			pickRequested = false;
+		}
+
+		// level of detail from the screen size of each level's error, a switch dirties the shadow views around the object
+		lodSelector.SetView(camera.Position, camera.Zoom, camHeight);
+		lodSelector.SetFadeFrames(fadeLods ? LOD_FADE_FRAMES : 0);
+		for (unsigned int i = 0; i < cubeCount; i++)
+		{
+			const std::vector<float> &errors = shapeLodErrors[objectShapes[i]];
+			glm::vec3 center = (objectMin[i] + objectMax[i]) * 0.5f;
+			if (useLod)
+				lodChoices[i] = lodSelector.Select(i, errors.data(), (unsigned int)errors.size(), center, glm::length(objectMax[i] - center), 1.0f);
+			else
+				lodChoices[i] = LodChoice{ 0, -1, 0.0f };
+			if (lodChoices[i].level != casterLods[i])
+			{
+				shadowMaps.Invalidate(objectMin[i], objectMax[i], false);
+				casterLods[i] = lodChoices[i].level;
+			}
+		}
+
+		// only objects in view can hide anything
+		occlusionCuller.BeginFrame(projection * view);
+		for (uint32_t i : visibleObjects)
+		{
+			unsigned int shape = objectShapes[i];
+			occlusionCuller.AddOccluder(occluderPositions[shape].data(), occluderPositions[shape].size(), occluderIndices[shape].data(), occluderIndices[shape].size(), cubeModels[i]);
+		}
+		occlusionCuller.Rasterize();
+
+		// objects hidden behind the others never reach the GPU (an object can't hide itself, its box is in front of its surface)
+		occludedCount = 0;
+		lodTriangles = fullTriangles = fadingObjects = 0;
+		for (uint32_t i : visibleObjects)
+		{
+			const std::vector<unsigned int> &lods = shapeLods[objectShapes[i]];
+			const MeshRange &range = meshArena.Get(lods[0]);
+			if (!occlusionCuller.IsVisible(range.boundsMin, range.boundsMax, cubeModels[i]))
+			{
+				occludedCount++;
+				continue;
+			}
+
+			// while fading, the new level dithers in and the old one out over the same pixels
+			const LodChoice &lod = lodChoices[i];
+			instance.model = cubeModels[i];
+			instance.materialIndex = i;
+			instance.lodFade = lod.fadingLevel >= 0 ? lod.fade : 0.0f;
+			sceneBatch.Submit(lods[lod.level], instance);
+			lodTriangles += meshArena.Get(lods[lod.level]).indexCount / 3;
+			if (lod.fadingLevel >= 0)
+			{
+				instance.lodFade = -lod.fade;
+				sceneBatch.Submit(lods[lod.fadingLevel], instance);
+				lodTriangles += meshArena.Get(lods[lod.fadingLevel]).indexCount / 3;
+				fadingObjects++;
+			}
+			instance.lodFade = 0.0f;
+			fullTriangles += range.indexCount / 3;
+		}
+		instance.model = groundModel;
+		instance.materialIndex = groundMaterialIndex;
+		sceneBatch.Submit(cubeMesh, instance);
+		// the columns go out meshlet by meshlet, every meshlet is a draw of its own that GPU culling can drop; the same
+		// test on the CPU counts the triangles left for the report
+		meshletTriangles = modelTriangles = 0;
+		for (unsigned int i = 0; columnMesh != ~0u && i < columnCount; i++)
+		{
+			instance.model = columnModels[i];
+			modelTriangles += meshArena.Get(columnMesh).indexCount / 3;
+			if (!useMeshlets || columnMeshlets.empty())
+			{
+				sceneBatch.Submit(columnMesh, instance);
+				meshletTriangles += meshArena.Get(columnMesh).indexCount / 3;
+				continue;
+			}
+			for (unsigned int meshlet : columnMeshlets)
+			{
+				const MeshRange &range = meshArena.Get(meshlet);
+				sceneBatch.Submit(meshlet, instance);
+				glm::vec4 sphere = TransformSphere(instance.model, range.bounds);
+				if (frustum.IntersectsSphere(glm::vec3(sphere), sphere.w) && !MeshletBackFacing(sphere, TransformCone(instance.model, range.cone), camera.Position))
+					meshletTriangles += range.indexCount / 3;
+			}
+		}
+
+		// every crate casts shadows, seen or not; views that need no update are skipped inside Render
+		for (unsigned int i = 0; i < cubeCount; i++)
+		{
+			instance.model = cubeModels[i];
+			instance.materialIndex = i;
+			dynamicCasters.Submit(shapeLods[objectShapes[i]][casterLods[i]], instance);
+		}
+		dynamicCasters.Build();
+		shadowMaps.SetCaching(cacheShadows);
+		shadowMaps.Update(view, camera.Front, glm::radians(camera.Zoom), camAspect, near, SHADOW_DISTANCE, sunDirection, 1, lightPos, LAMP_SHADOW_RANGE, 0);
+		shadowMaps.Render(staticCasters, dynamicCasters, *depthShaders[0]);
+		shadowMaps.Bind();
+		shadowPasses.Add(shadowMaps.Cache().Stats().staticPasses + shadowMaps.Cache().Stats().dynamicPasses);
+		skippedShadowPasses.Add(shadowMaps.Cache().Stats().skippedPasses);
+
+		// overdraw walls face the camera between 2 and 8 units away, each one covering the whole screen
+		unsigned int overdrawLayers = OVERDRAW_LAYERS[overdrawSetting];
+		if (overdrawLayers > 0)
+		{
+			glm::mat4 cameraToWorld = glm::inverse(view);
+			for (unsigned int layer = 0; layer < overdrawLayers; layer++)
+			{
+				float distance = 8.0f - 6.0f * layer / overdrawLayers;
+				instance.model = glm::scale(glm::translate(cameraToWorld, glm::vec3(0.0f, 0.0f, -distance)), glm::vec3(2.0f * distance, 2.0f * distance, 0.01f));
+				instance.materialIndex = layer % cubeCount;
+				overdrawBatch.Submit(cubeMesh, instance);
+			}
+			overdrawBatch.Build();
+		}
+
+		// one indirect command per mesh, culled on the GPU, one API call for the whole scene
+		sceneBatch.Build();
+		sceneCuller.Run(sceneBatch, frustum, camera.Position);
+		BatchRenderer *walls = overdrawLayers > 0 ? &overdrawBatch : NULL;
+
+		// Use the lightingShader program (the G-buffer writer on the deferred path). The overdraw view replaces
+		// both and draws straight to the screen, the G-buffer pass rasterizes the same fragments anyway
+		unsigned int scenePass = fadingObjects > 0 ? 2 : 1;
+		Shader &lightingShader = showOverdraw ? *overdrawShaders[scenePass] : deferredFrame ? *geometryShaders[texturePath][scenePass] : *forwardShaders[texturePath][clustered][scenePass];
+		Shader &wallShader = showOverdraw ? *overdrawShaders[0] : deferredFrame ? *geometryShaders[texturePath][0] : *forwardShaders[texturePath][clustered][0];
+		if (deferredFrame)
+		{
+			gBuffer.Resize((unsigned int)camWidth, (unsigned int)camHeight);
+			gBuffer.BeginGeometryPass();
+		}
+		if (useDepthPrepass)
+		{
+			// depth only: the color pass then shades just the fragments that end up on screen
+			glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+			drawOpaque(sceneCuller, sceneBatch, walls, *depthShaders[scenePass], *depthShaders[0], projection, view);
+			glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+			glDepthFunc(GL_EQUAL);
+			glDepthMask(GL_FALSE);
+		}
+		if (showOverdraw)
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_ONE, GL_ONE);
+		}
+		shadedFragments.Begin();
+		drawOpaque(sceneCuller, sceneBatch, walls, lightingShader, wallShader, projection, view);
+		shadedFragments.End();
+		if (showOverdraw)
+			glDisable(GL_BLEND);
+		if (useDepthPrepass)
+		{
+			glDepthFunc(GL_LESS);
+			glDepthMask(GL_TRUE);
+		}
+		if (deferredFrame)
+		{
+			// every covered pixel is lit once, however many surfaces were drawn over it
+			Shader &deferredShader = *deferredShaders[clustered];
+			deferredShader.use();
+			deferredShader.setMat4("inverseViewProjection", glm::inverse(projection * view));
+			gBuffer.Resolve();
+		}
+		if (verifyCulling)
+		{
+			sceneCuller.Verify(sceneBatch, frustum, camera.Position);
+			verifyCulling = false;
+		}
+
+		cubePassCpuTimer.End();
+		cubePassGpuTimer.End();
+
+
+
+        // also draw the lamp object, unless it is out of view
+		dynamicObjects.Update(lampHandle, lightPos, lampRadius);
+		visibleDynamic.clear();
+		dynamicObjects.QueryFrustum(frustum, visibleDynamic);
+		if (!visibleDynamic.empty())
+		{
+			lightCubeShader.use();
+
+			model = glm::mat4(1.0f);
+			model = glm::translate(model, lightPos);
+			model = glm::scale(model, glm::vec3(0.2f)); // a smaller cube
+
+			lightCubeShader.setMat4("projection", projection);
+			lightCubeShader.setMat4("view", view);
+			lightCubeShader.setMat4("model", model);
+
+			lightCubeShader.setVec3f("lightColor", lightColor);
+
+			glBindVertexArray(lightCubeVAO);
+			glDrawArrays(GL_TRIANGLES, 0, 36);
+		}
+
+
+
+		frameStream.EndFrame(); // after the last draw reading from this frame's region
+		frameAllocations.Add((double)(GetHeapStats().allocations - heapAtFrameStart.allocations));
+		glfwSwapBuffers(window);
+		glfwPollEvents();    
+	}
+
+	hotReloader.Stop();
+	cubePassGpuTimer.Destroy();
+	sceneCuller.Destroy();
+	sceneBatch.Destroy();
+	overdrawBatch.Destroy();
+	gBuffer.Destroy();
+	staticCasters.Destroy();
+	dynamicCasters.Destroy();
+	shadowMaps.Destroy();
+	shadedFragments.Destroy();
+	meshArena.Destroy();
+	cubeMaterials.Destroy();
+	lightBlock.Destroy();
+	clusteredLights.Destroy();
+	frameStream.Destroy();
+	diffuse_map.reset();
+	specular_map.reset();
+	ResourceManager::Clear();
+	FrameArena::Stop();
+	JobSystem::Stop();
+
+	glfwTerminate();
+	return 0;
+}
+
+// FUNCTIONS
+
+void render()
+{
+
+
+}
+
+// draws the GPU-culled scene and the overdraw walls (if any) with the given programs, used by the depth prepass and the color pass alike
+void drawOpaque(GpuCuller &culler, BatchRenderer &scene, BatchRenderer *walls, Shader &sceneShader, Shader &wallShader, const glm::mat4 &projection, const glm::mat4 &view)
+{
+	sceneShader.use();
+	sceneShader.setMat4("projection", projection);
+	sceneShader.setMat4("view", view);
+	culler.Draw(scene);
+	if (walls)
+	{
+		wallShader.use();
+		wallShader.setMat4("projection", projection);
+		wallShader.setMat4("view", view);
+		walls->Draw();
+	}
+}
+
+// square pyramid with flat normals, same extent as the unit cube
+void buildPyramid(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices)
+{
+	const glm::vec3 apex(0.0f, 0.5f, 0.0f);
+	const glm::vec3 base[4] = {
+		glm::vec3(-0.5f, -0.5f,  0.5f),
+		glm::vec3( 0.5f, -0.5f,  0.5f),
+		glm::vec3( 0.5f, -0.5f, -0.5f),
+		glm::vec3(-0.5f, -0.5f, -0.5f)
+	};
+
+	vertices.clear();
+	indices.clear();
+	Vertex vertex;
+	// four sides
+	for (unsigned int side = 0; side < 4; side++)
+	{
+		glm::vec3 a = base[side];
+		glm::vec3 b = base[(side + 1) % 4];
+		glm::vec3 normal = glm::normalize(glm::cross(b - a, apex - a));
+
+		vertex.normal = normal;
+		vertex.position = a;    vertex.texCoords = glm::vec2(0.0f, 0.0f); vertices.push_back(vertex);
+		vertex.position = b;    vertex.texCoords = glm::vec2(1.0f, 0.0f); vertices.push_back(vertex);
+		vertex.position = apex; vertex.texCoords = glm::vec2(0.5f, 1.0f); vertices.push_back(vertex);
+	}
+	// base quad, facing down
+	for (unsigned int corner = 0; corner < 4; corner++)
+	{
+		vertex.position = base[corner];
+		vertex.normal = glm::vec3(0.0f, -1.0f, 0.0f);
+		vertex.texCoords = glm::vec2(base[corner].x + 0.5f, base[corner].z + 0.5f);
+		vertices.push_back(vertex);
+	}
+
+	for (unsigned int i = 0; i < 12; i++)
+		indices.push_back(i);
+	unsigned int baseQuad[6] = { 12, 14, 13, 12, 15, 14 };
+	indices.insert(indices.end(), baseQuad, baseQuad + 6);
+}
+
+// a (columns x rows) grid over a parametric surface (u, v in [0, 1]). The u = 1 column repeats the u = 0 one with other
+// texture coordinates, and with closedRows the v = 1 row repeats the v = 0 one, like the seams of an artist-made mesh.
+// The copies are placed at bit-identical positions and triangles squashed at a pole are left out
+void buildSurface(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices, unsigned int columns, unsigned int rows, bool closedRows, glm::vec3 (*surface)(float u, float v))
+{
+	const float step = 1e-3f;
+	vertices.clear();
+	indices.clear();
+	Vertex vertex;
+	for (unsigned int row = 0; row <= rows; row++)
+	{
+		for (unsigned int column = 0; column <= columns; column++)
+		{
+			float u = (float)column / columns, v = (float)row / rows;
+			vertex.position = surface(column == columns ? 0.0f : u, closedRows && row == rows ? 0.0f : v);
+			// normal from the surface's tangents, pointing straight out of the center where they degenerate (the poles)
+			glm::vec3 tangentU = surface(u + step, v) - surface(u - step, v);
+			glm::vec3 tangentV = surface(u, v + step) - surface(u, v - step);
+			glm::vec3 normal = glm::cross(tangentU, tangentV);
+			vertex.normal = glm::length(normal) > 1e-8f ? glm::normalize(normal) : glm::normalize(vertex.position);
+			vertex.texCoords = glm::vec2(u * 4.0f, v * 2.0f);
+			vertices.push_back(vertex);
+		}
+	}
+	for (unsigned int row = 0; row < rows; row++)
+	{
+		for (unsigned int column = 0; column < columns; column++)
+		{
+			unsigned int a = row * (columns + 1) + column, b = a + 1, c = a + columns + 1, d = c + 1;
+			unsigned int quad[6] = { a, b, d, a, d, c };
+			for (unsigned int corner = 0; corner < 6; corner += 3)
+			{
+				const glm::vec3 &p0 = vertices[quad[corner]].position, &p1 = vertices[quad[corner + 1]].position, &p2 = vertices[quad[corner + 2]].position;
+				if (p0 != p1 && p1 != p2 && p0 != p2)
+					indices.insert(indices.end(), quad + corner, quad + corner + 3);
+			}
+		}
+	}
+}
+
+// a sphere of radius 0.5 with a few octaves of bumps, v runs from pole to pole
+glm::vec3 rockSurface(float u, float v)
+{
+	float theta = u * 6.2831853f, phi = v * 3.1415927f;
+	glm::vec3 direction(sin(phi) * cos(theta), cos(phi), sin(phi) * sin(theta));
+	// every column meets in the same point
+	if (v <= 0.0f || v >= 1.0f)
+		direction = glm::vec3(0.0f, v <= 0.0f ? 1.0f : -1.0f, 0.0f);
+	float bumps = 0.04f * sin(5.0f * direction.x + 2.0f) * sin(4.0f * direction.y) * sin(6.0f * direction.z + 1.0f)
+		+ 0.02f * sin(13.0f * direction.x) * sin(11.0f * direction.y + 3.0f) * sin(12.0f * direction.z)
+		+ 0.01f * sin(29.0f * direction.x + 1.0f) * sin(31.0f * direction.y) * sin(27.0f * direction.z + 2.0f);
+	return direction * (0.45f + bumps);
+}
+
+// a torus lying in the xz plane that fills the unit cube's width
+glm::vec3 torusSurface(float u, float v)
+{
+	float theta = u * 6.2831853f, phi = v * 6.2831853f;
+	float ring = 0.34f + 0.16f * cos(phi);
+	return glm::vec3(ring * cos(theta), -0.16f * sin(phi), ring * sin(theta));
+}
+
+// Loads a cooked .lkm, .obj or .glb into the arena. A cooked mesh is uploaded right out of the file mapping, the others
+// are parsed straight into mapped buffer ranges, so the model's vertices are never copied on their way to the GPU.
+// Returns the mesh, or ~0u if the file can't be read; the meshlets of a cooked mesh are added as meshes of their own
+unsigned int loadModel(MeshArena &arena, const char *path, std::vector<unsigned int> &meshlets)
+{
+	meshlets.clear();
+	std::string name(path);
+	if (name.size() > 4 && name.compare(name.size() - 4, 4, ".lkm") == 0)
+	{
+		double start = glfwGetTime();
+		CookedMesh cooked;
+		if (!cooked.Open(name))
+			return ~0u;
+		unsigned int mesh = arena.Add(cooked.Vertices(), cooked.VertexCount(), cooked.Indices(), cooked.IndexCount(), cooked.BoundsMin(), cooked.BoundsMax(), cooked.BoundsRadius());
+		for (size_t i = 0; i < cooked.MeshletCount(); i++)
+			meshlets.push_back(arena.AddMeshlet(mesh, cooked.Meshlets()[i]));
+		std::cout << "Loaded " << path << ": " << cooked.VertexCount() << " vertices, " << cooked.IndexCount() / 3 << " triangles in " << cooked.MeshletCount() << " meshlets, "
+			<< cooked.FileSize() / 1024 << " KB uploaded in " << (glfwGetTime() - start) * 1000.0 << " ms" << std::endl;
+		return mesh;
+	}
+
+	MeshLoader loader;
+	if (!loader.Open(path))
+		return ~0u;
+	Vertex *vertices;
+	unsigned int *indices;
+	unsigned int mesh = arena.Reserve(loader.VertexCount(), loader.IndexCount(), vertices, indices);
+	if (vertices != NULL && indices != NULL)
+		loader.Write(vertices, indices);
+	if (!arena.Commit(mesh, loader.BoundsMin(), loader.BoundsMax(), loader.BoundsRadius()) || vertices == NULL || indices == NULL)
+		return ~0u;
+	const MeshLoadStats &stats = loader.Stats();
+	std::cout << "Loaded " << path << ": " << loader.VertexCount() << " vertices, " << loader.IndexCount() / 3 << " triangles, "
+		<< stats.fileBytes / 1024 << " KB parsed in " << stats.parseMs << " ms (" << stats.chunks << " pieces), written in " << stats.writeMs << " ms" << std::endl;
+	return mesh;
+}
+
+void processInput(GLFWwindow *window)
+{
+	if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+		glfwSetWindowShouldClose(window, true);
+
+	if(keys[GLFW_KEY_W])
+	{
+		std::cout << "W key pressed" << std::endl;
+	}
+
+	// Toggle wireframe mode
+	if(keys[GLFW_KEY_SPACE])
+	{
+		GLint polygonMode;
+		glGetIntegerv(GL_POLYGON_MODE, &polygonMode);
+
+		if(polygonMode == GL_FILL)
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+			// cooldown for 0.2 seconds
+			glfwSetTime(0.0);
+			while(glfwGetTime() < 0.1)
+			{
+				// do nothing
+			}
+		}
+		else
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+			// cooldown for 0.2 seconds
+			glfwSetTime(0.0);
+			while(glfwGetTime() < 0.1)
+			{
+				// do nothing
+			}
+		}
+	}
+
+	if(keys[GLFW_KEY_W])
+	{
+		camera.ProcessKeyboard(FORWARD, cameraSpeed);
+	}
+	if(keys[GLFW_KEY_S])
+	{
+		camera.ProcessKeyboard(BACKWARD, cameraSpeed);
+	}
+
+	if(keys[GLFW_KEY_A])
+	{
+		camera.ProcessKeyboard(LEFT, cameraSpeed);
+	}
+	if(keys[GLFW_KEY_D])
+	{
+		camera.ProcessKeyboard(RIGHT, cameraSpeed);
+	}
+
+	if(keys[GLFW_KEY_Q])
+	{
+		camera.ProcessKeyboard(DOWN, cameraSpeed);
+	}
+
+	if(keys[GLFW_KEY_E])
+	{
+		camera.ProcessKeyboard(UP, cameraSpeed);
+	}
+}
+
+
+
+// CALLBACKS
+
+// Resize callback
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+	camWidth = width;
+	camHeight = height;
+	camAspect = camWidth / camHeight;
+
+	glViewport(0, 0, width, height);
+} 
+
+// Error callback
+static void error_callback(int error, const char* description)
+{
+	fprintf(stderr, "Error: %s\n", description);
+}
+ 
+// Key callback
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+
+	if (action == GLFW_PRESS)
+	{
+		keys[key] = 1;
+
+		// switch texturing paths, only possible when the driver supports bindless textures
+		if (key == GLFW_KEY_B && GLExtensions::BindlessTexture)
+			useBindless = !useBindless;
+		// check the GPU culling result against the CPU on the next frame
+		if (key == GLFW_KEY_V)
+			verifyCulling = true;
+		// pick the object the camera looks at
+		if (key == GLFW_KEY_P)
+			pickRequested = true;
+		// more or fewer clustered point lights
+		if (key == GLFW_KEY_L)
+			pointLightSetting = (pointLightSetting + 1) % (sizeof(POINT_LIGHT_COUNTS) / sizeof(POINT_LIGHT_COUNTS[0]));
+		// forward or deferred shading
+		if (key == GLFW_KEY_G)
+			useDeferred = !useDeferred;
+		// more or fewer overdraw walls
+		if (key == GLFW_KEY_O)
+			overdrawSetting = (overdrawSetting + 1) % (sizeof(OVERDRAW_LAYERS) / sizeof(OVERDRAW_LAYERS[0]));
+		// time both shading paths with every light count and overdraw setting
+		if (key == GLFW_KEY_K && benchmarkStep < 0)
+			benchmarkStep = 0;
+		// depth prepass on/off
+		if (key == GLFW_KEY_Z)
+			useDepthPrepass = !useDepthPrepass;
+		// overdraw view on/off
+		if (key == GLFW_KEY_H)
+			showOverdraw = !showOverdraw;
+		// shadow caching on/off
+		if (key == GLFW_KEY_C)
+			cacheShadows = !cacheShadows;
+		// animation on/off
+		if (key == GLFW_KEY_T)
+			animateScene = !animateScene;
+		// levels of detail on/off
+		if (key == GLFW_KEY_N)
+			useLod = !useLod;
+		// level of detail cross-fades on/off
+		if (key == GLFW_KEY_F)
+			fadeLods = !fadeLods;
+		// meshlet culling of loaded models on/off
+		if (key == GLFW_KEY_M)
+			useMeshlets = !useMeshlets;
+	}
+	else if (action == GLFW_RELEASE)
+	{
+		keys[key] = 0;
+	}
+}
+
+// Mouse callback
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
+{
+    float xpos = static_cast<float>(xposIn);
+    float ypos = static_cast<float>(yposIn);
+
+    if (firstMouse)
+    {
+        lastX = xpos;
+        lastY = ypos;
+        firstMouse = false;
+    }
+
+    float xoffset = xpos - lastX;
+    float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
+
+    lastX = xpos;
+    lastY = ypos;
+
+    camera.ProcessMouseMovement(xoffset, yoffset);
+}
+
+// Scroll callback
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    camera.ProcessMouseScroll(static_cast<float>(yoffset));
+}
+
+// ERROR CHECKS
+void get_lightingShader_error(unsigned int lightingShader)
+{
+	int success;
+	char infoLog[512];
+	glGetShaderiv(lightingShader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(lightingShader, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+	}
+}
+
+void get_link_error(unsigned int lightingShaderProgram)
+{
+	int success;
+	char infoLog[512];
+	glGetProgramiv(lightingShaderProgram, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(lightingShaderProgram, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::PROGRAM::LINK_FAILED\n" << infoLog << std::endl;
+	}
 }
\ No newline at end of file
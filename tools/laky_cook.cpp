@@ -0,0 +1,66 @@
+// LAKY'S MESH COOKER v1.0.0
+// 2026.10.19.
+//==============================================================================
+// Converts OBJ and binary glTF (.glb) models into cooked meshes (.lkm) that
+// the engine maps and uploads without parsing. No window or GL context needed.
+// Build from the repository root, e.g.:
+//   g++ -O2 -std=c++17 -Isrc/libs tools/laky_cook.cpp src/libs/laky_jobs/laky_jobs.cpp
+//       src/libs/laky_mesh/laky_meshloader.cpp src/libs/laky_mesh/laky_mappedfile.cpp
+//       src/libs/laky_mesh/laky_cookedmesh.cpp src/libs/laky_mesh/laky_meshlets.cpp -lpthread -o laky_cook
+// Usage: laky_cook <model.obj|model.glb> [more models...], each is cooked next to itself as model.lkm.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "laky_jobs/laky_jobs.h"
+#include "laky_mesh/laky_cookedmesh.h"
+#include "laky_mesh/laky_meshloader.h"
+#include "laky_mesh/laky_meshlets.h"
+
+// cooks one model, returns false if it couldn't be read or written
+static bool cook(const std::string &path)
+{
+    MeshLoader loader;
+    if (!loader.Open(path))
+        return false;
+    std::vector<Vertex> vertices(loader.VertexCount());
+    std::vector<unsigned int> indices(loader.IndexCount());
+    loader.Write(vertices.data(), indices.data());
+    size_t sourceBytes = loader.Stats().fileBytes;
+    loader.Close();
+
+    // the triangles are stored meshlet by meshlet, so every meshlet is a range of the index buffer
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        positions[i] = vertices[i].position;
+    std::vector<unsigned int> meshletIndices;
+    std::vector<Meshlet> meshlets;
+    BuildMeshlets(positions, indices.data(), indices.size(), meshletIndices, meshlets);
+
+    size_t dot = path.find_last_of('.');
+    std::string cookedPath = path.substr(0, dot) + ".lkm";
+    if (!WriteCookedMesh(cookedPath, vertices.data(), vertices.size(), meshletIndices.data(), meshletIndices.size(), meshlets.data(), meshlets.size()))
+        return false;
+    CookedMesh cooked;
+    if (!cooked.Open(cookedPath))
+        return false;
+    std::cout << path << " -> " << cookedPath << ": " << vertices.size() << " vertices, " << indices.size() / 3 << " triangles in " << meshlets.size() << " meshlets, "
+              << sourceBytes / 1024 << " KB -> " << cooked.FileSize() / 1024 << " KB" << std::endl;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: laky_cook <model.obj|model.glb> [more models...]" << std::endl;
+        return 1;
+    }
+    JobSystem::Start();
+    int failed = 0;
+    for (int i = 1; i < argc; i++)
+        failed += cook(argv[i]) ? 0 : 1;
+    JobSystem::Stop();
+    return failed == 0 ? 0 : 1;
+}